@@ -96,6 +96,13 @@ Java_com_google_android_filament_ColorGrading_nBuilderGamutMapping(JNIEnv*, jcla
     builder->gamutMapping(gamutMapping);
 }
 
+extern "C" JNIEXPORT void JNICALL
+Java_com_google_android_filament_ColorGrading_nBuilderGpuBaking(JNIEnv*, jclass,
+        jlong nativeBuilder, jboolean gpuBaking) {
+    ColorGrading::Builder* builder = (ColorGrading::Builder*) nativeBuilder;
+    builder->gpuBaking(gpuBaking);
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_google_android_filament_ColorGrading_nBuilderExposure(JNIEnv*, jclass,
         jlong nativeBuilder, jfloat exposure) {
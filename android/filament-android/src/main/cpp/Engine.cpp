@@ -316,3 +316,32 @@ Java_com_google_android_filament_Engine_nGetEntityManager(JNIEnv*, jclass, jlong
     Engine* engine = (Engine*) nativeEngine;
     return (jlong) &engine->getEntityManager();
 }
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_google_android_filament_Engine_nSetTextureCacheBudget(JNIEnv*, jclass,
+        jlong nativeEngine, jlong budget) {
+    Engine* engine = (Engine*) nativeEngine;
+    engine->setTextureCacheBudget((size_t) budget);
+}
+
+extern "C" JNIEXPORT jlong JNICALL
+Java_com_google_android_filament_Engine_nGetTextureCacheBudget(JNIEnv*, jclass,
+        jlong nativeEngine) {
+    Engine* engine = (Engine*) nativeEngine;
+    return (jlong) engine->getTextureCacheBudget();
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_google_android_filament_Engine_nGetTextureCacheStats(JNIEnv* env, jclass,
+        jlong nativeEngine, jlongArray out_) {
+    Engine* engine = (Engine*) nativeEngine;
+    Engine::TextureCacheStats const stats = engine->getTextureCacheStats();
+    jlong* out = env->GetLongArrayElements(out_, nullptr);
+    out[0] = (jlong) stats.hits;
+    out[1] = (jlong) stats.misses;
+    out[2] = (jlong) stats.evictions;
+    out[3] = (jlong) stats.bytesEvicted;
+    out[4] = (jlong) stats.cacheSize;
+    out[5] = (jlong) stats.inUseSize;
+    env->ReleaseLongArrayElements(out_, out, 0);
+}
@@ -178,6 +178,13 @@ Java_com_google_android_filament_RenderableManager_nBuilderScreenSpaceContactSha
     builder->screenSpaceContactShadows(enabled);
 }
 
+extern "C" JNIEXPORT void JNICALL
+Java_com_google_android_filament_RenderableManager_nBuilderStaticShadowCaster(JNIEnv*, jclass,
+        jlong nativeBuilder, jboolean enabled) {
+    RenderableManager::Builder *builder = (RenderableManager::Builder *) nativeBuilder;
+    builder->staticShadowCaster(enabled);
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_google_android_filament_RenderableManager_nBuilderSkinningBuffer(JNIEnv*, jclass,
         jlong nativeBuilder, jlong nativeSkinningBuffer, jint boneCount, jint offset) {
@@ -367,6 +374,20 @@ Java_com_google_android_filament_RenderableManager_nSetScreenSpaceContactShadows
     rm->setScreenSpaceContactShadows((RenderableManager::Instance) i, enabled);
 }
 
+extern "C" JNIEXPORT void JNICALL
+Java_com_google_android_filament_RenderableManager_nSetStaticShadowCaster(JNIEnv*, jclass,
+        jlong nativeRenderableManager, jint i, jboolean enabled) {
+    RenderableManager *rm = (RenderableManager *) nativeRenderableManager;
+    rm->setStaticShadowCaster((RenderableManager::Instance) i, enabled);
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_google_android_filament_RenderableManager_nIsStaticShadowCaster(JNIEnv*, jclass,
+        jlong nativeRenderableManager, jint i) {
+    RenderableManager *rm = (RenderableManager *) nativeRenderableManager;
+    return (jboolean) rm->isStaticShadowCaster((RenderableManager::Instance) i);
+}
+
 extern "C" JNIEXPORT jboolean JNICALL
 Java_com_google_android_filament_RenderableManager_nIsShadowCaster(JNIEnv*, jclass,
         jlong nativeRenderableManager, jint i) {
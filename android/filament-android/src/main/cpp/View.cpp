@@ -129,7 +129,7 @@ Java_com_google_android_filament_View_nGetDithering(JNIEnv*, jclass,
 extern "C" JNIEXPORT void JNICALL
 Java_com_google_android_filament_View_nSetDynamicResolutionOptions(JNIEnv*, jclass, jlong nativeView,
         jboolean enabled, jboolean homogeneousScaling,
-        jfloat minScale, jfloat maxScale, jfloat sharpness, jint quality) {
+        jfloat minScale, jfloat maxScale, jfloat sharpness, jint quality, jint controller) {
     View* view = (View*)nativeView;
     View::DynamicResolutionOptions options;
     options.enabled = enabled;
@@ -138,6 +138,7 @@ Java_com_google_android_filament_View_nSetDynamicResolutionOptions(JNIEnv*, jcla
     options.maxScale = filament::math::float2{ maxScale };
     options.sharpness = sharpness;
     options.quality = (View::QualityLevel)quality;
+    options.controller = (View::DynamicResolutionOptions::Controller)controller;
     view->setDynamicResolutionOptions(options);
 }
 
@@ -187,6 +188,20 @@ Java_com_google_android_filament_View_nSetDynamicLightingOptions(JNIEnv*,
     view->setDynamicLightingOptions(zLightNear, zLightFar);
 }
 
+extern "C" JNIEXPORT void JNICALL
+Java_com_google_android_filament_View_nSetAdaptiveDynamicLightingEnabled(JNIEnv*,
+        jclass, jlong nativeView, jboolean enabled) {
+    View* view = (View*) nativeView;
+    view->setAdaptiveDynamicLightingEnabled(enabled);
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_google_android_filament_View_nIsAdaptiveDynamicLightingEnabled(JNIEnv*,
+        jclass, jlong nativeView) {
+    View* view = (View*) nativeView;
+    return static_cast<jboolean>(view->isAdaptiveDynamicLightingEnabled());
+}
+
 extern "C" JNIEXPORT void JNICALL
 Java_com_google_android_filament_View_nSetPostProcessingEnabled(JNIEnv*,
         jclass, jlong nativeView, jboolean enabled) {
@@ -393,10 +408,11 @@ Java_com_google_android_filament_View_nSetTemporalAntiAliasingOptions(JNIEnv *,
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_google_android_filament_View_nSetScreenSpaceReflectionsOptions(JNIEnv*, jclass,
-        jlong nativeView, jfloat thickness, jfloat bias, jfloat maxDistance, jfloat stride, jboolean enabled) {
+        jlong nativeView, jfloat thickness, jfloat bias, jfloat maxDistance, jfloat stride, jfloat resolution, jboolean enabled) {
     View* view = (View*) nativeView;
     view->setScreenSpaceReflectionsOptions({.thickness = thickness, .bias = bias,
-            .maxDistance = maxDistance, .stride = stride, .enabled = (bool) enabled
+            .maxDistance = maxDistance, .stride = stride, .resolution = resolution,
+            .enabled = (bool) enabled
     });
 }
 
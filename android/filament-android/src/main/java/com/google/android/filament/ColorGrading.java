@@ -271,6 +271,29 @@ public class ColorGrading {
             return this;
         }
 
+        /**
+         * Enables or disables baking the 3D LUT on the GPU. When enabled, the color adjustments
+         * are evaluated by a post-processing material the first time this ColorGrading is used
+         * for rendering, instead of on the CPU when it is built. This makes building a new
+         * ColorGrading much cheaper, which is useful when the color adjustments are animated.
+         *
+         * The tone mapping step is still evaluated on the CPU, once per tone mapper.
+         *
+         * The result is slightly different from the LUT generated on the CPU, which remains
+         * the reference. GPU baking is only supported by the OpenGL backend, the LUT is
+         * generated on the CPU otherwise.
+         *
+         * The default is false.
+         *
+         * @param gpuBaking Enables or disables baking the 3D LUT on the GPU
+         *
+         * @return This Builder, for chaining calls
+         */
+        public Builder gpuBaking(boolean gpuBaking) {
+            nBuilderGpuBaking(mNativeBuilder, gpuBaking);
+            return this;
+        }
+
         /**
          * Adjusts the exposure of this image. The exposure is specified in stops:
          * each stop brightens (positive values) or darkens (negative values) the image by
@@ -601,6 +624,7 @@ public class ColorGrading {
     private static native void nBuilderToneMapping(long nativeBuilder, int toneMapping);
     private static native void nBuilderLuminanceScaling(long nativeBuilder, boolean luminanceScaling);
     private static native void nBuilderGamutMapping(long nativeBuilder, boolean gamutMapping);
+    private static native void nBuilderGpuBaking(long nativeBuilder, boolean gpuBaking);
     private static native void nBuilderExposure(long nativeBuilder, float exposure);
     private static native void nBuilderNightAdaptation(long nativeBuilder, float adaptation);
     private static native void nBuilderWhiteBalance(long nativeBuilder, float temperature, float tint);
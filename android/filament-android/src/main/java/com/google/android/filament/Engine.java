@@ -641,6 +641,74 @@ public class Engine {
         return mEntityManager;
     }
 
+    // Texture cache
+
+    /**
+     * Statistics of the internal texture cache, counters are accumulated since the
+     * <code>Engine</code> was created.
+     *
+     * @see #getTextureCacheStats
+     */
+    public static class TextureCacheStats {
+        /** Number of textures taken from the cache. */
+        public long hits;
+        /** Number of textures that had to be created. */
+        public long misses;
+        /** Number of textures evicted from the cache. */
+        public long evictions;
+        /** Size in bytes of the textures evicted from the cache. */
+        public long bytesEvicted;
+        /** Size in bytes of the unused textures currently in the cache. */
+        public long cacheSize;
+        /** Size in bytes of the textures currently in use. */
+        public long inUseSize;
+    }
+
+    /**
+     * Sets the memory budget of the cache of textures the <code>Engine</code> allocates
+     * internally for rendering (e.g. post-processing buffers or shadow maps). Textures that are
+     * no longer in use are kept in the cache so they can be reused by the next frames, and are
+     * evicted, least recently used first, when the cache exceeds this budget.
+     *
+     * <p>Applications rendering several {@link View}s of different resolutions might want to
+     * increase this budget to avoid recreating textures each frame. The default is 64 MiB.</p>
+     *
+     * @param budget maximum size in bytes of the unused textures kept in the cache
+     */
+    public void setTextureCacheBudget(long budget) {
+        nSetTextureCacheBudget(getNativeObject(), budget);
+    }
+
+    /**
+     * @return the memory budget of the internal texture cache in bytes
+     * @see #setTextureCacheBudget
+     */
+    public long getTextureCacheBudget() {
+        return nGetTextureCacheBudget(getNativeObject());
+    }
+
+    /**
+     * Returns statistics of the internal texture cache.
+     *
+     * @param out a {@link TextureCacheStats} where the statistics will be stored, or null in which
+     *            case a new one is allocated.
+     * @return a {@link TextureCacheStats} containing the statistics of the texture cache
+     * @see #setTextureCacheBudget
+     */
+    @NonNull
+    public TextureCacheStats getTextureCacheStats(@Nullable TextureCacheStats out) {
+        if (out == null) out = new TextureCacheStats();
+        long[] stats = new long[6];
+        nGetTextureCacheStats(getNativeObject(), stats);
+        out.hits = stats[0];
+        out.misses = stats[1];
+        out.evictions = stats[2];
+        out.bytesEvicted = stats[3];
+        out.cacheSize = stats[4];
+        out.inUseSize = stats[5];
+        return out;
+    }
+
     /**
      * Kicks the hardware thread (e.g.: the OpenGL, Vulkan or Metal thread) and blocks until
      * all commands to this point are executed. Note that this does guarantee that the
@@ -717,4 +785,7 @@ public class Engine {
     private static native long nGetRenderableManager(long nativeEngine);
     private static native long nGetJobSystem(long nativeEngine);
     private static native long nGetEntityManager(long nativeEngine);
+    private static native void nSetTextureCacheBudget(long nativeEngine, long budget);
+    private static native long nGetTextureCacheBudget(long nativeEngine);
+    private static native void nGetTextureCacheStats(long nativeEngine, long[] out);
 }
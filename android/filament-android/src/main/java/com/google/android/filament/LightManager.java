@@ -357,6 +357,18 @@ public class LightManager {
          * enabled. (2cm by default).
          */
         public float shadowBulbRadius = 0.02f;
+
+        /**
+         * Whether the shadow cascades past the first one are updated incrementally. When enabled,
+         * the first cascade is rendered every frame, but only one of the other cascades is, in
+         * turn; the others reuse the shadow map they were last rendered with. This reduces the
+         * number of shadow draw calls significantly with 3 or more cascades, at the cost of
+         * the shadows of moving objects lagging behind in the distant cascades.
+         *
+         * This requires stable shadows (see {@link #stable}) and is ignored otherwise.
+         * This is ignored when the View's ShadowType is set to VSM.
+         */
+        public boolean incrementalCascadeUpdates = false;
     }
 
     public static class ShadowCascades {
@@ -500,7 +512,8 @@ public class LightManager {
                     options.polygonOffsetConstant, options.polygonOffsetSlope,
                     options.screenSpaceContactShadows,
                     options.stepCount, options.maxShadowDistance, options.vsmMsaaSamples,
-                    options.blurWidth, options.shadowBulbRadius);
+                    options.blurWidth, options.shadowBulbRadius,
+                    options.incrementalCascadeUpdates);
             return this;
         }
 
@@ -1158,7 +1171,7 @@ public class LightManager {
     private static native void nDestroyBuilder(long nativeBuilder);
     private static native boolean nBuilderBuild(long nativeBuilder, long nativeEngine, int entity);
     private static native void nBuilderCastShadows(long nativeBuilder, boolean enable);
-    private static native void nBuilderShadowOptions(long nativeBuilder, int mapSize, int cascades, float[] splitPositions, float constantBias, float normalBias, float shadowFar, float shadowNearHint, float shadowFarhint, boolean stable, float polygonOffsetConstant, float polygonOffsetSlope, boolean screenSpaceContactShadows, int stepCount, float maxShadowDistance, int vsmMsaaSamples, float blurWidth, float shadowBulbRadius);
+    private static native void nBuilderShadowOptions(long nativeBuilder, int mapSize, int cascades, float[] splitPositions, float constantBias, float normalBias, float shadowFar, float shadowNearHint, float shadowFarhint, boolean stable, float polygonOffsetConstant, float polygonOffsetSlope, boolean screenSpaceContactShadows, int stepCount, float maxShadowDistance, int vsmMsaaSamples, float blurWidth, float shadowBulbRadius, boolean incrementalCascadeUpdates);
     private static native void nBuilderCastLight(long nativeBuilder, boolean enabled);
     private static native void nBuilderPosition(long nativeBuilder, float x, float y, float z);
     private static native void nBuilderDirection(long nativeBuilder, float x, float y, float z);
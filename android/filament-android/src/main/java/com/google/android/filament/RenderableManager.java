@@ -351,6 +351,23 @@ public class RenderableManager {
             return this;
         }
 
+        /**
+         * Hints that this renderable is a static shadow caster, false by default.
+         *
+         * <p>The depth of static shadow casters is cached across frames and only re-rendered when
+         * the shadow map's light frustum changes, or when a static shadow caster is added,
+         * removed, moved or changes its static state. The other shadow casters are rendered on
+         * top of the cached depth every frame.</p>
+         *
+         * <p>A static shadow caster's geometry and materials must not change while it is static.
+         * This has no effect when the View's shadow type is {@link View.ShadowType#VSM}.</p>
+         */
+        @NonNull
+        public Builder staticShadowCaster(boolean enabled) {
+            nBuilderStaticShadowCaster(mNativeBuilder, enabled);
+            return this;
+        }
+
         /**
          * Allows bones to be swapped out and shared using SkinningBuffer.
          *
@@ -716,6 +733,24 @@ public class RenderableManager {
         nSetScreenSpaceContactShadows(mNativeObject, i, enabled);
     }
 
+    /**
+     * Changes whether or not the renderable is a static shadow caster.
+     *
+     * @see Builder#staticShadowCaster
+     */
+    public void setStaticShadowCaster(@EntityInstance int i, boolean enabled) {
+        nSetStaticShadowCaster(mNativeObject, i, enabled);
+    }
+
+    /**
+     * Checks if the renderable is a static shadow caster.
+     *
+     * @see Builder#staticShadowCaster
+     */
+    public boolean isStaticShadowCaster(@EntityInstance int i) {
+        return nIsStaticShadowCaster(mNativeObject, i);
+    }
+
     /**
      * Checks if the renderable can cast shadows.
      *
@@ -880,6 +915,7 @@ public class RenderableManager {
     private static native void nBuilderCastShadows(long nativeBuilder, boolean enabled);
     private static native void nBuilderReceiveShadows(long nativeBuilder, boolean enabled);
     private static native void nBuilderScreenSpaceContactShadows(long nativeBuilder, boolean enabled);
+    private static native void nBuilderStaticShadowCaster(long nativeBuilder, boolean enabled);
     private static native void nBuilderSkinning(long nativeBuilder, int boneCount);
     private static native int nBuilderSkinningBones(long nativeBuilder, int boneCount, Buffer bones, int remaining);
     private static native void nBuilderSkinningBuffer(long nativeBuilder, long nativeSkinningBuffer, int boneCount, int offset);
@@ -904,6 +940,8 @@ public class RenderableManager {
     private static native void nSetCastShadows(long nativeRenderableManager, int i, boolean enabled);
     private static native void nSetReceiveShadows(long nativeRenderableManager, int i, boolean enabled);
     private static native void nSetScreenSpaceContactShadows(long nativeRenderableManager, int i, boolean enabled);
+    private static native void nSetStaticShadowCaster(long nativeRenderableManager, int i, boolean enabled);
+    private static native boolean nIsStaticShadowCaster(long nativeRenderableManager, int i);
     private static native boolean nIsShadowCaster(long nativeRenderableManager, int i);
     private static native boolean nIsShadowReceiver(long nativeRenderableManager, int i);
     private static native void nGetAxisAlignedBoundingBox(long nativeRenderableManager, int i, float[] center, float[] halfExtent);
@@ -500,7 +500,7 @@ public class View {
     public void setScreenSpaceReflectionsOptions(@NonNull ScreenSpaceReflectionsOptions options) {
         mScreenSpaceReflectionsOptions = options;
         nSetScreenSpaceReflectionsOptions(getNativeObject(), options.thickness, options.bias,
-                options.maxDistance, options.stride, options.enabled);
+                options.maxDistance, options.stride, options.resolution, options.enabled);
     }
 
     /**
@@ -628,7 +628,8 @@ public class View {
                 options.minScale,
                 options.maxScale,
                 options.sharpness,
-                options.quality.ordinal());
+                options.quality.ordinal(),
+                options.controller.ordinal());
     }
 
     /**
@@ -758,6 +759,29 @@ public class View {
         nSetDynamicLightingOptions(getNativeObject(), zLightNear, zLightFar);
     }
 
+    /**
+     * Enables or disables adaptive dynamic lighting, disabled by default.
+     *
+     * <p>
+     * When enabled, the range set with {@link #setDynamicLightingOptions} is tightened every frame
+     * to the depth range of the visible renderables: <code>zLightNear</code> can be pushed further
+     * and <code>zLightFar</code> brought closer, which concentrates the froxel slices where the
+     * geometry is and skips lights that can't reach any visible renderable.
+     * </p>
+     *
+     * @param enabled true to enable adaptive dynamic lighting, false to disable it.
+     */
+    public void setAdaptiveDynamicLightingEnabled(boolean enabled) {
+        nSetAdaptiveDynamicLightingEnabled(getNativeObject(), enabled);
+    }
+
+    /**
+     * Returns true if adaptive dynamic lighting is enabled.
+     */
+    public boolean isAdaptiveDynamicLightingEnabled() {
+        return nIsAdaptiveDynamicLightingEnabled(getNativeObject());
+    }
+
     /**
      * Sets the shadow mapping technique this View uses.
      *
@@ -1101,9 +1125,11 @@ public class View {
     private static native int nGetAntiAliasing(long nativeView);
     private static native void nSetDithering(long nativeView, int dithering);
     private static native int nGetDithering(long nativeView);
-    private static native void nSetDynamicResolutionOptions(long nativeView, boolean enabled, boolean homogeneousScaling, float minScale, float maxScale, float sharpness, int quality);
+    private static native void nSetDynamicResolutionOptions(long nativeView, boolean enabled, boolean homogeneousScaling, float minScale, float maxScale, float sharpness, int quality, int controller);
     private static native void nSetRenderQuality(long nativeView, int hdrColorBufferQuality);
     private static native void nSetDynamicLightingOptions(long nativeView, float zLightNear, float zLightFar);
+    private static native void nSetAdaptiveDynamicLightingEnabled(long nativeView, boolean enabled);
+    private static native boolean nIsAdaptiveDynamicLightingEnabled(long nativeView);
     private static native void nSetShadowType(long nativeView, int type);
     private static native void nSetVsmShadowOptions(long nativeView, int anisotropy, boolean mipmapping, float minVarianceScale, float lightBleedReduction);
     private static native void nSetSoftShadowOptions(long nativeView, float penumbraScale, float penumbraRatioScale);
@@ -1124,7 +1150,7 @@ public class View {
             boolean nativeResolution, int foregroundRingCount, int backgroundRingCount, int fastGatherRingCount, int maxForegroundCOC, int maxBackgroundCOC);
     private static native void nSetVignetteOptions(long nativeView, float midPoint, float roundness, float feather, float r, float g, float b, float a, boolean enabled);
     private static native void nSetTemporalAntiAliasingOptions(long nativeView, float feedback, float filterWidth, boolean enabled);
-    private static native void nSetScreenSpaceReflectionsOptions(long nativeView, float thickness, float bias, float maxDistance, float stride, boolean enabled);
+    private static native void nSetScreenSpaceReflectionsOptions(long nativeView, float thickness, float bias, float maxDistance, float stride, float resolution, boolean enabled);
     private static native void nSetMultiSampleAntiAliasingOptions(long nativeView, boolean enabled, int sampleCount, boolean customResolve);
     private static native boolean nIsShadowingEnabled(long nativeView);
     private static native void nSetScreenSpaceRefractionEnabled(long nativeView, boolean enabled);
@@ -1183,6 +1209,12 @@ public class View {
      * quality:   upscaling quality.
      *            LOW: 1 bilinear tap, Medium: 4 bilinear taps, High: 9 bilinear taps (tent)
      *
+     * controller: how the scale factor is computed from the frame times.
+     *            PID: the scale factor follows the GPU frame time error relative to the target.
+     *            PREDICTIVE: the scale factor that should hit the target is predicted from the GPU
+     *            frame time. The CPU frame time is taken into account, so that the resolution isn't
+     *            lowered when the CPU alone misses the target.
+     *
      * \note
      * Dynamic resolution is only supported on platforms where the time to render
      * a frame can be measured accurately. Dynamic resolution is currently only
@@ -1192,6 +1224,20 @@ public class View {
      *
      */
     public static class DynamicResolutionOptions {
+        /**
+         * Dynamic resolution controller
+         * PID:        follows the GPU frame time error, with a dead band
+         * PREDICTIVE: models the GPU frame time as a function of the resolution and sets the scale
+         *             factor that hits the target, with hysteresis. The CPU frame time is taken
+         *             into account.
+         *
+         * The default controller is PID.
+         */
+        public enum Controller {
+            PID,
+            PREDICTIVE,
+        }
+
         /**
          * minimum scale factors in x and y
          */
@@ -1224,6 +1270,8 @@ public class View {
          */
         @NonNull
         public QualityLevel quality = QualityLevel.LOW;
+        @NonNull
+        public DynamicResolutionOptions.Controller controller = DynamicResolutionOptions.Controller.PID;
     }
 
     /**
@@ -1539,7 +1587,7 @@ public class View {
          */
         public float bias = 0.0005f;
         /**
-         * How each dimension of the AO buffer is scaled. Must be either 0.5 or 1.0.
+         * How each dimension of the AO buffer is scaled. Must be either 0.25, 0.5 or 1.0.
          */
         public float resolution = 0.5f;
         /**
@@ -1694,6 +1742,10 @@ public class View {
          * stride, in texels, for samples along the ray.
          */
         public float stride = 2.0f;
+        /**
+         * How each dimension of the reflection buffer is scaled. Must be either 0.5 or 1.0.
+         */
+        public float resolution = 1.0f;
         public boolean enabled = false;
     }
 
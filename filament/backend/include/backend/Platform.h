@@ -23,6 +23,9 @@
 
 #include <utils/compiler.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
 namespace filament {
 namespace backend {
 
@@ -37,6 +40,23 @@ public:
         uintptr_t image = 0;
     };
 
+    /**
+     * Driver configuration, see createDriver()
+     */
+    struct DriverConfig {
+        /**
+         * Size of the handle arena in bytes, 0 to use the backend's default
+         * (e.g. FILAMENT_OPENGL_HANDLE_ARENA_SIZE_IN_MB).
+         */
+        size_t handleArenaSize = 0;
+
+        /**
+         * Relative sizes of the small, medium and large handle pools within the handle arena.
+         * The arena is split proportionally to these weights, which must not be 0.
+         */
+        uint32_t handlePoolSizes[3] = { 1, 15, 16 };
+    };
+
     virtual ~Platform() noexcept;
 
     /**
@@ -54,9 +74,12 @@ public:
      *                      APIs and platforms.
      *                      For EGL platforms, this is an EGLContext.
      *
+     * @param driverConfig  the driver configuration, e.g. the size of the handle arena
+     *
      * @return nullptr on failure, or a pointer to the newly created driver.
      */
-    virtual backend::Driver* createDriver(void* sharedContext) noexcept = 0;
+    virtual backend::Driver* createDriver(void* sharedContext,
+            const DriverConfig& driverConfig) noexcept = 0;
 
     /**
      * Processes the platform's event queue when called from its primary event-handling thread.
@@ -23,6 +23,8 @@
 #include <utils/Log.h>
 #include <utils/compiler.h>
 #include <tsl/robin_map.h>
+
+#include <atomic>
 #include <unordered_map>
 
 #if !defined(NDEBUG) && UTILS_HAS_RTTI
@@ -44,7 +46,30 @@ template <size_t P0, size_t P1, size_t P2>
 class HandleAllocator {
 public:
 
-    HandleAllocator(const char* name, size_t size) noexcept;
+    /*
+     * Relative sizes of the three pools within the handle arena. The arena is split
+     * proportionally to these weights. The default split is 1:15:16, see
+     * Platform::DriverConfig.
+     */
+    struct PoolSizes {
+        uint32_t pool0 = 1;
+        uint32_t pool1 = 15;
+        uint32_t pool2 = 16;
+    };
+
+    struct PoolStats {
+        uint32_t capacity = 0;          // number of handles this pool can hold
+        uint32_t count = 0;             // number of handles currently allocated from this pool
+        uint32_t highWatermark = 0;     // maximum number of handles ever allocated at once
+        uint32_t overflowCount = 0;     // number of allocations that fell back to the heap
+    };
+
+    struct Stats {
+        PoolStats pools[3];
+        uint32_t heapHandleCount = 0;   // number of live handles allocated on the heap
+    };
+
+    HandleAllocator(const char* name, size_t size, PoolSizes const& poolSizes) noexcept;
     HandleAllocator(HandleAllocator const& rhs) = delete;
     HandleAllocator& operator=(HandleAllocator const& rhs) = delete;
     ~HandleAllocator();
@@ -207,19 +232,35 @@ public:
         return handle_cast<Dp>(const_cast<Handle<B>&>(handle));
     }
 
+    /*
+     * Returns a snapshot of the pools occupancy and overflow counters. This is safe to call
+     * from any thread, but values might be slightly out of date.
+     */
+    Stats getStats() const noexcept;
+
 
 private:
 
+    // The pools use a lock-free free-list, so that handles can be allocated on the main
+    // thread and freed on the driver thread without contention.
+    template<size_t SIZE>
+    using Pool = utils::PoolAllocator<SIZE, 16, 0, utils::AtomicFreeList>;
+
     // template <int P0, int P1, int P2>
     class Allocator {
         friend class HandleAllocator;
-        utils::PoolAllocator<P0, 16>   mPool0;
-        utils::PoolAllocator<P1, 16>   mPool1;
-        utils::PoolAllocator<P2, 16>   mPool2;
-        UTILS_UNUSED_IN_RELEASE const utils::AreaPolicy::HeapArea& mArea;
+        const utils::AreaPolicy::HeapArea& mArea;
+        const size_t mOffsetPool1;
+        const size_t mOffsetPool2;
+        Pool<P0> mPool0;
+        Pool<P1> mPool1;
+        Pool<P2> mPool2;
     public:
         static constexpr size_t MIN_ALIGNMENT_SHIFT = 4;
-        explicit Allocator(const utils::AreaPolicy::HeapArea& area);
+        Allocator(const utils::AreaPolicy::HeapArea& area, PoolSizes const& poolSizes);
+
+        // number of elements each pool can hold
+        uint32_t getCapacity(size_t index) const noexcept;
 
         // this is in fact always called with a constexpr size argument
         [[nodiscard]] inline void* alloc(size_t size, size_t alignment, size_t extra) noexcept {
@@ -241,14 +282,28 @@ private:
 
 
 #ifndef NDEBUG
+    // the tracking policies are not thread-safe, so we still need a lock in debug builds
     using HandleArena = utils::Arena<Allocator,
             utils::LockingPolicy::SpinLock,
             utils::TrackingPolicy::DebugAndHighWatermark>;
 #else
     using HandleArena = utils::Arena<Allocator,
-            utils::LockingPolicy::SpinLock>;
+            utils::LockingPolicy::NoLock>;
 #endif
 
+    template<size_t SIZE>
+    static constexpr size_t poolIndex() noexcept {
+        if constexpr (SIZE == P0) { return 0; }
+        if constexpr (SIZE == P1) { return 1; }
+        return 2;
+    }
+
+    struct PoolCounters {
+        std::atomic<uint32_t> count{};
+        std::atomic<uint32_t> highWatermark{};
+        std::atomic<uint32_t> overflowCount{};
+    };
+
     // allocateHandle()/deallocateHandle() selects the pool to use at compile-time based on the
     // allocation size this is always inlined, because all these do is to call
     // allocateHandleInPool()/deallocateHandleFromPool() with the right pool size.
@@ -271,15 +326,22 @@ private:
     }
 
     // allocateHandleInPool()/deallocateHandleFromPool() is NOT inlined, which will cause three
-    // versions to be generated, one for each pool. Because the arena is synchronized,
-    // the code generated is not trivial (even if it's not insane either).
+    // versions to be generated, one for each pool. In release builds the arena is not locked,
+    // the pools' free-lists are lock-free.
     template<size_t SIZE>
     UTILS_NOINLINE
     HandleBase::HandleId allocateHandleInPool() noexcept {
+        PoolCounters& counters = mPoolCounters[poolIndex<SIZE>()];
         void* p = mHandleArena.alloc(SIZE);
         if (UTILS_LIKELY(p)) {
+            const uint32_t count = counters.count.fetch_add(1, std::memory_order_relaxed) + 1;
+            uint32_t wm = counters.highWatermark.load(std::memory_order_relaxed);
+            while (UTILS_UNLIKELY(count > wm) && !counters.highWatermark.compare_exchange_weak(
+                    wm, count, std::memory_order_relaxed)) {
+            }
             return pointerToHandle(p);
         } else {
+            counters.overflowCount.fetch_add(1, std::memory_order_relaxed);
             return allocateHandleSlow(SIZE);
         }
     }
@@ -290,6 +352,7 @@ private:
         if (UTILS_LIKELY(isPoolHandle(id))) {
             void* p = handleToPointer(id);
             mHandleArena.free(p, SIZE);
+            mPoolCounters[poolIndex<SIZE>()].count.fetch_sub(1, std::memory_order_relaxed);
         } else {
             deallocateHandleSlow(id, SIZE);
         }
@@ -328,6 +391,7 @@ private:
     }
 
     HandleArena mHandleArena;
+    PoolCounters mPoolCounters[3];
 
     // Below is only used when running out of space in the HandleArena
     mutable utils::Mutex mLock;
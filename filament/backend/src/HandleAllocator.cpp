@@ -24,29 +24,64 @@ namespace filament::backend {
 
 using namespace utils;
 
+namespace {
+
+// returns the offset of the pool at index 'index' in an area of size 'size' split with 'weights'
+template<typename T>
+size_t poolOffset(size_t size, T const& poolSizes, size_t index) noexcept {
+    const size_t weights[3] = { poolSizes.pool0, poolSizes.pool1, poolSizes.pool2 };
+    const size_t total = weights[0] + weights[1] + weights[2];
+    size_t offset = 0;
+    for (size_t i = 0; i < index; i++) {
+        offset += weights[i];
+    }
+    // round to the pool alignment
+    return ((size / total) * offset) & ~size_t(15);
+}
+
+} // anonymous namespace
+
 template <size_t P0, size_t P1, size_t P2>
 UTILS_NOINLINE
-HandleAllocator<P0, P1, P2>::Allocator::Allocator(AreaPolicy::HeapArea const& area)
-        : mArea(area) {
-    // TODO: we probably need a better way to set the size of these pools
-    const size_t unit = area.size() / 32;
-    const size_t offsetPool1 =      unit;
-    const size_t offsetPool2 = 16 * unit;
-    char* const p = (char*)area.begin();
-    mPool0 = PoolAllocator< P0, 16>(p, p + offsetPool1);
-    mPool1 = PoolAllocator< P1, 16>(p + offsetPool1, p + offsetPool2);
-    mPool2 = PoolAllocator< P2, 16>(p + offsetPool2, area.end());
+HandleAllocator<P0, P1, P2>::Allocator::Allocator(AreaPolicy::HeapArea const& area,
+        PoolSizes const& poolSizes)
+        : mArea(area),
+          mOffsetPool1(poolOffset(area.size(), poolSizes, 1)),
+          mOffsetPool2(poolOffset(area.size(), poolSizes, 2)),
+          mPool0((char*)area.begin(), (char*)area.begin() + mOffsetPool1),
+          mPool1((char*)area.begin() + mOffsetPool1, (char*)area.begin() + mOffsetPool2),
+          mPool2((char*)area.begin() + mOffsetPool2, area.end()) {
+    assert_invariant(poolSizes.pool0 && poolSizes.pool1 && poolSizes.pool2);
+}
+
+template <size_t P0, size_t P1, size_t P2>
+uint32_t HandleAllocator<P0, P1, P2>::Allocator::getCapacity(size_t index) const noexcept {
+    switch (index) {
+        case 0:  return uint32_t(mOffsetPool1 / P0);
+        case 1:  return uint32_t((mOffsetPool2 - mOffsetPool1) / P1);
+        default: return uint32_t((mArea.size() - mOffsetPool2) / P2);
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
 
 template <size_t P0, size_t P1, size_t P2>
-HandleAllocator<P0, P1, P2>::HandleAllocator(const char* name, size_t size) noexcept
-    : mHandleArena(name, size) {
+HandleAllocator<P0, P1, P2>::HandleAllocator(const char* name, size_t size,
+        PoolSizes const& poolSizes) noexcept
+    : mHandleArena(name, size, poolSizes) {
 }
 
 template <size_t P0, size_t P1, size_t P2>
 HandleAllocator<P0, P1, P2>::~HandleAllocator() {
+#ifndef NDEBUG
+    // this helps tuning Engine::Config::driverHandleArenaSizeMB and driverHandlePoolSizes
+    Stats const stats = getStats();
+    for (size_t i = 0; i < 3; i++) {
+        slog.d << "HandleAllocator pool " << i << ": high watermark "
+               << stats.pools[i].highWatermark << " / " << stats.pools[i].capacity
+               << ", heap allocations " << stats.pools[i].overflowCount << io::endl;
+    }
+#endif
     auto& overflowMap = mOverflowMap;
     if (!overflowMap.empty()) {
         PANIC_LOG("Not all handles have been freed. Probably leaking memory.");
@@ -57,6 +92,22 @@ HandleAllocator<P0, P1, P2>::~HandleAllocator() {
     }
 }
 
+template <size_t P0, size_t P1, size_t P2>
+typename HandleAllocator<P0, P1, P2>::Stats
+HandleAllocator<P0, P1, P2>::getStats() const noexcept {
+    Stats stats;
+    for (size_t i = 0; i < 3; i++) {
+        PoolCounters const& counters = mPoolCounters[i];
+        stats.pools[i].capacity = mHandleArena.getAllocator().getCapacity(i);
+        stats.pools[i].count = counters.count.load(std::memory_order_relaxed);
+        stats.pools[i].highWatermark = counters.highWatermark.load(std::memory_order_relaxed);
+        stats.pools[i].overflowCount = counters.overflowCount.load(std::memory_order_relaxed);
+    }
+    std::lock_guard lock(mLock);
+    stats.heapHandleCount = uint32_t(mOverflowMap.size());
+    return stats;
+}
+
 template <size_t P0, size_t P1, size_t P2>
 UTILS_NOINLINE
 void* HandleAllocator<P0, P1, P2>::handleToPointerSlow(HandleBase::HandleId id) const noexcept {
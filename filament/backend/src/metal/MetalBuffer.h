@@ -80,6 +80,8 @@ private:
     BufferUsage mUsage;
     size_t mBufferSize = 0;
     const MetalBufferPoolEntry* mBufferPoolEntry = nullptr;
+    // whether mBufferPoolEntry was handed to a command buffer, and can't be written in place
+    bool mBufferPoolEntryInUse = false;
     void* mCpuBuffer = nullptr;
     MetalContext& mContext;
 };
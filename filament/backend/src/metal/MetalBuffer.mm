@@ -62,13 +62,24 @@ void MetalBuffer::copyIntoBuffer(void* src, size_t size, size_t byteOffset) {
         return;
     }
 
-    // We're about to acquire a new buffer to hold the new contents. If we previously had obtained a
-    // buffer we release it, decrementing its reference count, as we no longer needs it.
-    if (mBufferPoolEntry) {
-        mContext.bufferPool->releaseBuffer(mBufferPoolEntry);
+    // If the GPU might be reading our buffer, we acquire a new buffer to hold the new contents.
+    // Otherwise, the buffer is written in place, so the successive ranges of a partial update
+    // only copy the previous contents once.
+    if (!mBufferPoolEntry || mBufferPoolEntryInUse) {
+        const MetalBufferPoolEntry* previous = mBufferPoolEntry;
+        mBufferPoolEntry = mContext.bufferPool->acquireBuffer(mBufferSize);
+        mBufferPoolEntryInUse = false;
+
+        if (previous) {
+            // A partial update must preserve the rest of the buffer's contents.
+            if (byteOffset != 0 || size != mBufferSize) {
+                memcpy(mBufferPoolEntry->buffer.contents, previous->buffer.contents, mBufferSize);
+            }
+            // We no longer need the previous buffer, release it, decrementing its reference count.
+            mContext.bufferPool->releaseBuffer(previous);
+        }
     }
 
-    mBufferPoolEntry = mContext.bufferPool->acquireBuffer(mBufferSize);
     memcpy(static_cast<uint8_t*>(mBufferPoolEntry->buffer.contents) + byteOffset, src, size);
 }
 
@@ -91,7 +102,8 @@ id<MTLBuffer> MetalBuffer::getGpuBufferForDraw(id<MTLCommandBuffer> cmdBuffer) n
     }
 
     // This buffer is being used in a draw call, so we retain it so it's not released back into the
-    // buffer pool until the frame has finished.
+    // buffer pool until the frame has finished. It can't be written in place anymore.
+    mBufferPoolEntryInUse = true;
     auto uniformDeleter = [bufferPool = mContext.bufferPool] (const void* resource) {
         bufferPool->releaseBuffer((const MetalBufferPoolEntry*) resource);
     };
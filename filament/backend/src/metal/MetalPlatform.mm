@@ -31,8 +31,9 @@ DefaultPlatform* createDefaultMetalPlatform() {
 
 MetalPlatform::~MetalPlatform() = default;
 
-Driver* MetalPlatform::createDriver(void* sharedContext) noexcept {
-    return MetalDriverFactory::create(this);
+Driver* MetalPlatform::createDriver(void* sharedContext,
+        const DriverConfig& driverConfig) noexcept {
+    return MetalDriverFactory::create(this, driverConfig);
 }
 
 id<MTLDevice> MetalPlatform::createDevice() noexcept {
@@ -20,7 +20,8 @@
 
 namespace filament::backend {
 
-Driver* PlatformNoop::createDriver(void* const sharedGLContext) noexcept {
+Driver* PlatformNoop::createDriver(void* const sharedGLContext,
+        const DriverConfig& driverConfig) noexcept {
     return NoopDriver::create();
 }
 
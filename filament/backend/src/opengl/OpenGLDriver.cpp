@@ -63,8 +63,9 @@ using namespace utils;
 namespace filament::backend {
 
 Driver* OpenGLDriverFactory::create(
-        OpenGLPlatform* const platform, void* const sharedGLContext) noexcept {
-    return OpenGLDriver::create(platform, sharedGLContext);
+        OpenGLPlatform* const platform, void* const sharedGLContext,
+        const Platform::DriverConfig& driverConfig) noexcept {
+    return OpenGLDriver::create(platform, sharedGLContext, driverConfig);
 }
 
 using namespace GLUtils;
@@ -73,7 +74,8 @@ using namespace GLUtils;
 
 UTILS_NOINLINE
 Driver* OpenGLDriver::create(
-        OpenGLPlatform* const platform, void* const sharedGLContext) noexcept {
+        OpenGLPlatform* const platform, void* const sharedGLContext,
+        const Platform::DriverConfig& driverConfig) noexcept {
     assert_invariant(platform);
     OpenGLPlatform* const ec = platform;
 
@@ -136,7 +138,7 @@ Driver* OpenGLDriver::create(
         }
     }
 
-    OpenGLDriver* const driver = new OpenGLDriver(ec);
+    OpenGLDriver* const driver = new OpenGLDriver(ec, driverConfig);
     return driver;
 }
 
@@ -153,8 +155,13 @@ OpenGLDriver::DebugMarker::~DebugMarker() noexcept {
 
 // ------------------------------------------------------------------------------------------------
 
-OpenGLDriver::OpenGLDriver(OpenGLPlatform* platform) noexcept
-        : mHandleAllocator("Handles", FILAMENT_OPENGL_HANDLE_ARENA_SIZE_IN_MB * 1024U * 1024U), // TODO: set the amount in configuration
+OpenGLDriver::OpenGLDriver(OpenGLPlatform* platform,
+        const Platform::DriverConfig& driverConfig) noexcept
+        : mHandleAllocator("Handles",
+                driverConfig.handleArenaSize ? driverConfig.handleArenaSize :
+                        FILAMENT_OPENGL_HANDLE_ARENA_SIZE_IN_MB * 1024U * 1024U,
+                { driverConfig.handlePoolSizes[0], driverConfig.handlePoolSizes[1],
+                  driverConfig.handlePoolSizes[2] }),
           mSamplerMap(32),
           mPlatform(*platform) {
   
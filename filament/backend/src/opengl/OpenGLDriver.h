@@ -26,6 +26,7 @@
 #include "private/backend/HandleAllocator.h"
 #include "private/backend/Program.h"
 
+#include "backend/Platform.h"
 #include "backend/TargetBufferInfo.h"
 
 #include <utils/compiler.h>
@@ -52,12 +53,14 @@ class OpenGLBlitter;
 class OpenGLTimerQueryInterface;
 
 class OpenGLDriver final : public DriverBase {
-    inline explicit OpenGLDriver(OpenGLPlatform* platform) noexcept;
+    inline OpenGLDriver(OpenGLPlatform* platform,
+            const Platform::DriverConfig& driverConfig) noexcept;
     ~OpenGLDriver() noexcept final;
     Dispatcher getDispatcher() const noexcept final;
 
 public:
-    static Driver* create(OpenGLPlatform* platform, void* sharedGLContext) noexcept;
+    static Driver* create(OpenGLPlatform* platform, void* sharedGLContext,
+            const Platform::DriverConfig& driverConfig) noexcept;
 
     class DebugMarker {
         OpenGLDriver& driver;
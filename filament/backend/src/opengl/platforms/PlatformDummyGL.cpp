@@ -18,7 +18,8 @@
 
 namespace filament::backend {
 
-Driver* PlatformDummyGL::createDriver(void* const sharedGLContext) noexcept {
+Driver* PlatformDummyGL::createDriver(void* const sharedGLContext,
+        const DriverConfig& driverConfig) noexcept {
     return nullptr;
 }
 
@@ -105,8 +105,9 @@ void PlatformEGLAndroid::terminate() noexcept {
     PlatformEGL::terminate();
 }
 
-Driver* PlatformEGLAndroid::createDriver(void* sharedContext) noexcept {
-    Driver* driver = PlatformEGL::createDriver(sharedContext);
+Driver* PlatformEGLAndroid::createDriver(void* sharedContext,
+        const DriverConfig& driverConfig) noexcept {
+    Driver* driver = PlatformEGL::createDriver(sharedContext, driverConfig);
     auto extensions = GLUtils::split(eglQueryString(mEGLDisplay, EGL_EXTENSIONS));
 
     eglGetNativeClientBufferANDROID = (PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC) eglGetProcAddress(
@@ -31,7 +31,7 @@ public:
 
     void terminate() noexcept override;
 
-    Driver* createDriver(void* sharedContext) noexcept final;
+    Driver* createDriver(void* sharedContext, const DriverConfig& driverConfig) noexcept final;
 
     int getOSVersion() const noexcept final;
 
@@ -26,7 +26,8 @@ namespace filament::backend {
 
 class PlatformVkCocoaTouch final : public VulkanPlatform {
 public:
-    Driver* createDriver(void* const sharedContext) noexcept override;
+    Driver* createDriver(void* const sharedContext,
+            const DriverConfig& driverConfig) noexcept override;
     void* createVkSurfaceKHR(void* nativeWindow, void* instance, uint64_t flags) noexcept override;
     int getOSVersion() const noexcept override { return 0; }
 };
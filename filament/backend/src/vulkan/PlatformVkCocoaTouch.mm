@@ -39,10 +39,11 @@ using namespace bluevk;
 
 namespace filament::backend {
 
-Driver* PlatformVkCocoaTouch::createDriver(void* const sharedContext) noexcept {
+Driver* PlatformVkCocoaTouch::createDriver(void* const sharedContext,
+        const DriverConfig& driverConfig) noexcept {
     ASSERT_PRECONDITION(sharedContext == nullptr, "Vulkan does not support shared contexts.");
     static const char* requestedExtensions[] = {"VK_MVK_ios_surface"};
-    return VulkanDriverFactory::create(this, requestedExtensions, 1);
+    return VulkanDriverFactory::create(this, requestedExtensions, 1, driverConfig);
 }
 
 void* PlatformVkCocoaTouch::createVkSurfaceKHR(void* nativeWindow, void* instance, uint64_t flags) noexcept {
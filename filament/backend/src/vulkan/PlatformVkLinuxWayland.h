@@ -28,7 +28,8 @@ namespace filament::backend {
 class PlatformVkLinuxWayland final : public VulkanPlatform {
 public:
 
-    Driver* createDriver(void* const sharedContext) noexcept override;
+    Driver* createDriver(void* const sharedContext,
+            const DriverConfig& driverConfig) noexcept override;
 
     void* createVkSurfaceKHR(void* nativeWindow, void* instance, uint64_t flags) noexcept override;
 
@@ -35,7 +35,8 @@ namespace filament::backend {
 class PlatformVkLinuxX11 final : public VulkanPlatform {
 public:
 
-    Driver* createDriver(void* const sharedContext) noexcept override;
+    Driver* createDriver(void* const sharedContext,
+            const DriverConfig& driverConfig) noexcept override;
 
     void* createVkSurfaceKHR(void* nativeWindow, void* instance, uint64_t flags) noexcept override;
 
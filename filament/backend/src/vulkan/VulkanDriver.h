@@ -31,6 +31,8 @@
 #include "private/backend/HandleAllocator.h"
 #include "DriverBase.h"
 
+#include <backend/Platform.h>
+
 #include <utils/compiler.h>
 #include <utils/Allocator.h>
 
@@ -42,14 +44,16 @@ struct VulkanSamplerGroup;
 class VulkanDriver final : public DriverBase {
 public:
     static Driver* create(VulkanPlatform* platform,
-            const char* const* ppEnabledExtensions, uint32_t enabledExtensionCount) noexcept;
+            const char* const* ppEnabledExtensions, uint32_t enabledExtensionCount,
+            const Platform::DriverConfig& driverConfig) noexcept;
 
 private:
 
     void debugCommandBegin(CommandStream* cmds, bool synchronous, const char* methodName) noexcept override;
 
     inline VulkanDriver(VulkanPlatform* platform,
-            const char* const* ppEnabledExtensions, uint32_t enabledExtensionCount) noexcept;
+            const char* const* ppEnabledExtensions, uint32_t enabledExtensionCount,
+            const Platform::DriverConfig& driverConfig) noexcept;
 
     ~VulkanDriver() noexcept override;
 
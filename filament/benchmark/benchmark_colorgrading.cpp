@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <filament/ColorGrading.h>
+#include <filament/Engine.h>
+#include <filament/ToneMapper.h>
+
+using namespace filament;
+
+/*
+ * Measures the generation of the color grading 3D LUT (ColorGrading::Builder::build()) with the
+ * NOOP backend, in milliseconds per LUT.
+ *
+ * Arguments are: LUT dimension, whether color adjustments are set (0/1)
+ */
+
+static void colorGrading(benchmark::State& state) {
+    const uint8_t dimension = uint8_t(state.range(0));
+    const bool adjustments = state.range(1) != 0;
+
+    Engine* engine = Engine::create(Engine::Backend::NOOP);
+    ACESToneMapper toneMapper;
+
+    ColorGrading::Builder builder;
+    builder.dimensions(dimension)
+            .format(ColorGrading::LutFormat::FLOAT)
+            .toneMapper(&toneMapper);
+    if (adjustments) {
+        builder.exposure(0.5f)
+                .whiteBalance(0.1f, 0.0f)
+                .contrast(1.2f)
+                .saturation(1.1f)
+                .vibrance(1.1f)
+                .shadowsMidtonesHighlights({ 1.1f, 1.0f, 1.0f, 0.0f }, { 1.0f, 1.0f, 1.0f, 0.0f },
+                        { 1.0f, 1.0f, 0.9f, 0.0f }, { 0.0f, 0.333f, 0.550f, 1.0f });
+    }
+
+    for (auto _ : state) {
+        ColorGrading* colorGrading = builder.build(*engine);
+        engine->destroy(colorGrading);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * dimension * dimension * dimension);
+
+    Engine::destroy(&engine);
+}
+
+BENCHMARK(colorGrading)
+        ->ArgNames({ "dimension", "adjustments" })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime()
+        ->Args({ 32, 0 })
+        ->Args({ 32, 1 })
+        ->Args({ 64, 0 })
+        ->Args({ 64, 1 });
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "DynamicResolutionController.h"
+#include "FrameInfo.h"
+
+#include <math/scalar.h>
+#include <math/vec2.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace filament;
+using namespace filament::math;
+
+/*
+ * Replays frame timings through the dynamic resolution controllers, without a GPU, to tune them
+ * offline. Each frame of a trace has the GPU and CPU times measured at a given scale factor, the
+ * GPU time at the scale factor picked by the controller is derived from it, assuming that
+ * SCALABLE_RATIO of it is proportional to the scale factor. Like FrameInfoManager, the GPU time
+ * is read POOL_COUNT frames late, and both times are median filtered.
+ *
+ * The counters are measured over the whole trace:
+ *  missed:  ratio of frames over the target frame time
+ *  scale:   average scale factor
+ *  changes: ratio of frames where the scale factor changed
+ *
+ * Arguments are: predictive controller (0/1), trace (0: step, 1: ramp, 2: CPU bound,
+ * 3: recorded)
+ *
+ * The recorded trace is read from the file named by the DYNAMIC_RESOLUTION_TRACE environment
+ * variable, with one frame per line: "gpu_ms cpu_ms scale". In debug builds, these are the
+ * frameTime, cpuFrameTime and scale fields of the "d.view.frame_info" DebugRegistry data source.
+ */
+
+namespace {
+
+struct Frame {
+    float gpu;      // ms
+    float cpu;      // ms
+    float scale;    // scale factor the frame was measured at
+};
+
+constexpr float TARGET = 1000.0f / 60.0f;
+constexpr float SCALABLE_RATIO = 0.8f;
+constexpr uint32_t FRAME_COUNT = 1200;
+constexpr uint32_t WIDTH = 1920;
+constexpr uint32_t HEIGHT = 1080;
+// Renderer::FrameRateOptions and DynamicResolutionOptions defaults
+constexpr float SCALE_RATE = 1.0f / 8.0f;
+constexpr uint32_t HISTORY = 15;
+constexpr float2 MIN_SCALE = 0.5f;
+constexpr float2 MAX_SCALE = 1.0f;
+
+std::vector<Frame> generateTrace(int64_t type) {
+    std::default_random_engine gen; // NOLINT -- we want the same trace each run
+    std::uniform_real_distribution<float> noise(0.95f, 1.05f);
+    std::vector<Frame> trace(FRAME_COUNT);
+    for (uint32_t i = 0; i < FRAME_COUNT; i++) {
+        const float t = float(i) / float(FRAME_COUNT);
+        float gpu = 0.0f;
+        float cpu = 6.0f;
+        switch (type) {
+            case 0: // the load doubles for half of the trace
+                gpu = t < 0.25f || t >= 0.75f ? 12.0f : 24.0f;
+                break;
+            case 1: // the load increases steadily
+                gpu = mix(10.0f, 30.0f, t);
+                break;
+            case 2: // the CPU alone misses the target
+                gpu = 20.0f;
+                cpu = 25.0f;
+                break;
+        }
+        trace[i] = { gpu * noise(gen), cpu * noise(gen), 1.0f };
+    }
+    return trace;
+}
+
+bool readTrace(const char* path, std::vector<Frame>* trace) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+    Frame frame{};
+    while (fscanf(file, "%f %f %f", &frame.gpu, &frame.cpu, &frame.scale) == 3) {
+        trace->push_back(frame);
+    }
+    fclose(file);
+    return !trace->empty();
+}
+
+// median of the count values preceding end
+float median(std::vector<float> const& times, size_t end, size_t count) {
+    count = std::min(count, end);
+    std::vector<float> values(times.begin() + ptrdiff_t(end - count), times.begin() + ptrdiff_t(end));
+    std::sort(values.begin(), values.end());
+    return values[count / 2];
+}
+
+struct Results {
+    float missed = 0.0f;
+    float scale = 0.0f;
+    float changes = 0.0f;
+};
+
+Results simulate(DynamicResolutionController& controller, std::vector<Frame> const& trace) {
+    const uint32_t latency = HISTORY / 2u + uint32_t(FrameInfoManager::POOL_COUNT);
+    std::vector<float> gpuTimes;
+    std::vector<float> cpuTimes;
+    gpuTimes.reserve(trace.size());
+    cpuTimes.reserve(trace.size());
+
+    Results results;
+    float2 scale = 1.0f;
+    for (Frame const& frame : trace) {
+        const float s = scale.x * scale.y;
+        const float gpu = frame.gpu * (1.0f - SCALABLE_RATIO + SCALABLE_RATIO * s) /
+                (1.0f - SCALABLE_RATIO + SCALABLE_RATIO * frame.scale);
+        gpuTimes.push_back(gpu);
+        cpuTimes.push_back(frame.cpu);
+        results.missed += std::max(gpu, frame.cpu) > TARGET ? 1.0f : 0.0f;
+        results.scale += s;
+
+        // the timer queries are read POOL_COUNT frames late
+        if (gpuTimes.size() <= FrameInfoManager::POOL_COUNT + 3) {
+            continue;
+        }
+        const float newScale = controller.update({
+                .gpuFrameTime = median(gpuTimes,
+                        gpuTimes.size() - FrameInfoManager::POOL_COUNT, HISTORY),
+                .cpuFrameTime = median(cpuTimes, cpuTimes.size(), HISTORY),
+                .target = TARGET,
+                .scaleRate = SCALE_RATE,
+                .latency = latency
+        }, s);
+
+        const float2 axisScale = DynamicResolutionController::getAxisScale(
+                newScale, float(WIDTH), float(HEIGHT), false);
+        const float2 clamped = clamp(axisScale, MIN_SCALE, MAX_SCALE);
+        controller.setSaturated(clamped != axisScale);
+        results.changes += clamped != scale ? 1.0f : 0.0f;
+        scale = clamped;
+    }
+
+    const float count = float(trace.size());
+    return { results.missed / count, results.scale / count, results.changes / count };
+}
+
+} // anonymous namespace
+
+static void dynamicResolution(benchmark::State& state) {
+    const bool predictive = state.range(0) != 0;
+    const int64_t traceType = state.range(1);
+
+    std::vector<Frame> trace;
+    if (traceType == 3) {
+        const char* path = getenv("DYNAMIC_RESOLUTION_TRACE");
+        if (!path || !readTrace(path, &trace)) {
+            // the benchmark loop below won't run
+            state.SkipWithError("DYNAMIC_RESOLUTION_TRACE must name a frame timings file");
+        }
+    } else {
+        trace = generateTrace(traceType);
+    }
+
+    Results results;
+    for (auto _ : state) {
+        if (predictive) {
+            PredictiveResolutionController controller;
+            results = simulate(controller, trace);
+        } else {
+            // same gains as FView::updateScale() in release builds
+            PIDResolutionController controller;
+            controller.setGains(1.0f - std::exp(-SCALE_RATE),
+                    PIDResolutionController::DEFAULT_Ki, PIDResolutionController::DEFAULT_Kd);
+            results = simulate(controller, trace);
+        }
+        benchmark::DoNotOptimize(results);
+    }
+
+    state.counters["missed"] = results.missed;
+    state.counters["scale"] = results.scale;
+    state.counters["changes"] = results.changes;
+}
+
+BENCHMARK(dynamicResolution)
+        ->ArgNames({ "predictive", "trace" })
+        ->Unit(benchmark::kMillisecond)
+        ->Args({ 0, 0 })
+        ->Args({ 1, 0 })
+        ->Args({ 0, 1 })
+        ->Args({ 1, 1 })
+        ->Args({ 0, 2 })
+        ->Args({ 1, 2 })
+        ->Args({ 0, 3 })
+        ->Args({ 1, 3 });
@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "PerformanceCounters.h"
+
+#include <filament/Camera.h>
+#include <filament/DebugRegistry.h>
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+#include <filament/LightManager.h>
+#include <filament/Material.h>
+#include <filament/MaterialInstance.h>
+#include <filament/RenderableManager.h>
+#include <filament/Renderer.h>
+#include <filament/Scene.h>
+#include <filament/SwapChain.h>
+#include <filament/TransformManager.h>
+#include <filament/VertexBuffer.h>
+#include <filament/View.h>
+#include <filament/Viewport.h>
+
+#include <utils/EntityManager.h>
+
+#include <math/mat4.h>
+#include <math/vec3.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace filament;
+using namespace filament::math;
+using namespace utils;
+
+/*
+ * Renders procedurally generated scenes with the NOOP backend and reports the CPU time spent in
+ * each stage of the frame (see DebugRegistry::FrameStats). All times are in milliseconds per
+ * frame, each stage excludes the stages nested in it. When
+ * available, hardware counters of the calling thread are reported per renderable (see
+ * PerformanceCounters).
+ *
+ * Arguments are: renderables, lights, materials, shadows (0/1), post-processing (0/1)
+ */
+
+namespace {
+
+struct SceneConfig {
+    uint32_t renderableCount;
+    uint32_t lightCount;
+    uint32_t materialCount;
+    bool shadows;
+    bool postProcessing;
+};
+
+constexpr uint32_t WIDTH = 1920;
+constexpr uint32_t HEIGHT = 1080;
+
+const float3 CUBE_VERTICES[8] = {
+        { -1, -1,  1 }, {  1, -1,  1 }, { -1,  1,  1 }, {  1,  1,  1 },
+        { -1, -1, -1 }, {  1, -1, -1 }, { -1,  1, -1 }, {  1,  1, -1 },
+};
+
+const uint16_t CUBE_INDICES[36] = {
+        0, 1, 2,  2, 1, 3,      // front
+        5, 4, 7,  7, 4, 6,      // back
+        4, 0, 6,  6, 0, 2,      // left
+        1, 5, 3,  3, 5, 7,      // right
+        2, 3, 6,  6, 3, 7,      // top
+        4, 5, 0,  0, 5, 1,      // bottom
+};
+
+class FrameBenchmark {
+public:
+    explicit FrameBenchmark(SceneConfig const& config);
+    ~FrameBenchmark();
+
+    void renderFrame();
+
+    DebugRegistry& getDebugRegistry() noexcept {
+        return mEngine->getDebugRegistry();
+    }
+
+private:
+    Engine* mEngine = nullptr;
+    SwapChain* mSwapChain = nullptr;
+    Renderer* mRenderer = nullptr;
+    Scene* mScene = nullptr;
+    View* mView = nullptr;
+    Camera* mCamera = nullptr;
+    Entity mCameraEntity;
+    VertexBuffer* mVertexBuffer = nullptr;
+    IndexBuffer* mIndexBuffer = nullptr;
+    std::vector<MaterialInstance*> mMaterialInstances;
+    std::vector<Entity> mEntities;
+};
+
+FrameBenchmark::FrameBenchmark(SceneConfig const& config) {
+    mEngine = Engine::create(Engine::Backend::NOOP);
+    mSwapChain = mEngine->createSwapChain(WIDTH, HEIGHT);
+    mRenderer = mEngine->createRenderer();
+    mScene = mEngine->createScene();
+    mView = mEngine->createView();
+
+    EntityManager& em = EntityManager::get();
+    mCameraEntity = em.create();
+    mCamera = mEngine->createCamera(mCameraEntity);
+    mCamera->setProjection(60.0, double(WIDTH) / HEIGHT, 0.1, 500.0, Camera::Fov::VERTICAL);
+    mCamera->lookAt({ 0, 0, 0 }, { 0, 0, -1 });
+
+    mView->setScene(mScene);
+    mView->setCamera(mCamera);
+    mView->setViewport({ 0, 0, WIDTH, HEIGHT });
+    mView->setShadowingEnabled(config.shadows);
+    mView->setPostProcessingEnabled(config.postProcessing);
+
+    mVertexBuffer = VertexBuffer::Builder()
+            .vertexCount(8)
+            .bufferCount(1)
+            .attribute(VertexAttribute::POSITION, 0, VertexBuffer::AttributeType::FLOAT3)
+            .build(*mEngine);
+    mVertexBuffer->setBufferAt(*mEngine, 0,
+            VertexBuffer::BufferDescriptor(CUBE_VERTICES, sizeof(CUBE_VERTICES)));
+
+    mIndexBuffer = IndexBuffer::Builder()
+            .indexCount(36)
+            .bufferType(IndexBuffer::IndexType::USHORT)
+            .build(*mEngine);
+    mIndexBuffer->setBuffer(*mEngine,
+            IndexBuffer::BufferDescriptor(CUBE_INDICES, sizeof(CUBE_INDICES)));
+
+    // All materials are instances of the default material, which is enough to exercise
+    // material sorting and state changes on the CPU side.
+    Material const* material = mEngine->getDefaultMaterial();
+    const uint32_t materialCount = std::max(1u, config.materialCount);
+    mMaterialInstances.reserve(materialCount);
+    for (uint32_t i = 0; i < materialCount; i++) {
+        mMaterialInstances.push_back(material->createInstance());
+    }
+
+    std::default_random_engine gen; // NOLINT -- we want the same scene each run
+    std::uniform_real_distribution<float> xy(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> depth(2.0f, 200.0f);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+    // objects are scattered in a volume slightly larger than the view frustum
+    auto randomPosition = [&]() -> float3 {
+        const float z = depth(gen);
+        return { xy(gen) * z, xy(gen) * z * 0.6f, -z };
+    };
+
+    TransformManager& tcm = mEngine->getTransformManager();
+    for (uint32_t i = 0; i < config.renderableCount; i++) {
+        Entity e = em.create();
+        RenderableManager::Builder(1)
+                .boundingBox({{ -1, -1, -1 }, { 1, 1, 1 }})
+                .material(0, mMaterialInstances[i % materialCount])
+                .geometry(0, RenderableManager::PrimitiveType::TRIANGLES,
+                        mVertexBuffer, mIndexBuffer, 0, 36)
+                .castShadows(config.shadows)
+                .receiveShadows(config.shadows)
+                .build(*mEngine, e);
+        tcm.create(e, TransformManager::Instance{},
+                mat4f::translation(randomPosition()) * mat4f::scaling(size(gen)));
+        mScene->addEntity(e);
+        mEntities.push_back(e);
+    }
+
+    Entity sun = em.create();
+    LightManager::Builder(LightManager::Type::SUN)
+            .direction({ 0.3f, -1.0f, -0.5f })
+            .intensity(100000.0f)
+            .castShadows(config.shadows)
+            .build(*mEngine, sun);
+    mScene->addEntity(sun);
+    mEntities.push_back(sun);
+
+    for (uint32_t i = 0; i < config.lightCount; i++) {
+        Entity e = em.create();
+        LightManager::Builder(LightManager::Type::POINT)
+                .position(randomPosition())
+                .falloff(size(gen) * 5.0f)
+                .intensity(10000.0f)
+                .build(*mEngine, e);
+        mScene->addEntity(e);
+        mEntities.push_back(e);
+    }
+}
+
+FrameBenchmark::~FrameBenchmark() {
+    EntityManager& em = EntityManager::get();
+    for (Entity e : mEntities) {
+        mEngine->destroy(e);
+        em.destroy(e);
+    }
+    for (MaterialInstance* mi : mMaterialInstances) {
+        mEngine->destroy(mi);
+    }
+    mEngine->destroy(mVertexBuffer);
+    mEngine->destroy(mIndexBuffer);
+    mEngine->destroyCameraComponent(mCameraEntity);
+    em.destroy(mCameraEntity);
+    mEngine->destroy(mView);
+    mEngine->destroy(mScene);
+    mEngine->destroy(mRenderer);
+    mEngine->destroy(mSwapChain);
+    Engine::destroy(&mEngine);
+}
+
+void FrameBenchmark::renderFrame() {
+    if (mRenderer->beginFrame(mSwapChain)) {
+        mRenderer->render(mView);
+        mRenderer->endFrame();
+    }
+}
+
+} // anonymous namespace
+
+static void runFrameBenchmark(benchmark::State& state, SceneConfig const& config) {
+    FrameBenchmark bench(config);
+
+    // warm-up, so that all the caches (e.g. resource allocator) are populated
+    for (size_t i = 0; i < 4; i++) {
+        bench.renderFrame();
+    }
+
+    // the stats are reset when they're enabled, at the beginning of the next frame
+    DebugRegistry& debugRegistry = bench.getDebugRegistry();
+    debugRegistry.setProperty("d.renderer.frameStats", true);
+
+    {
+        PerformanceCounters pc(state);
+        for (auto _ : state) {
+            bench.renderFrame();
+        }
+        pc.stop();
+        state.SetItemsProcessed(int64_t(state.iterations()) * config.renderableCount);
+    }
+
+    auto const* stats = static_cast<DebugRegistry::FrameStats const*>(
+            debugRegistry.getDataSource("d.renderer.frameStats").data);
+    const double frameCount = std::max(1u, stats->frameCount);
+    state.counters["scene_prepare"] = stats->scenePrepare / frameCount;
+    state.counters["culling"] = stats->culling / frameCount;
+    state.counters["shadows"] = stats->shadows / frameCount;
+    state.counters["froxelization"] = stats->froxelization / frameCount;
+    state.counters["command_generation"] = stats->commandGeneration / frameCount;
+    state.counters["sort"] = stats->sort / frameCount;
+    state.counters["execute"] = stats->execute / frameCount;
+
+    debugRegistry.setProperty("d.renderer.frameStats", false);
+}
+
+static void frame(benchmark::State& state) {
+    runFrameBenchmark(state, {
+            .renderableCount = uint32_t(state.range(0)),
+            .lightCount = uint32_t(state.range(1)),
+            .materialCount = uint32_t(state.range(2)),
+            .shadows = state.range(3) != 0,
+            .postProcessing = state.range(4) != 0
+    });
+}
+
+// light culling and selection cost vs. the number of point lights in the scene, only the
+// CONFIG_MAX_LIGHT_COUNT closest visible lights are froxelized
+static void lights(benchmark::State& state) {
+    runFrameBenchmark(state, {
+            .renderableCount = 1000,
+            .lightCount = uint32_t(state.range(0)),
+            .materialCount = 16,
+            .shadows = false,
+            .postProcessing = false
+    });
+}
+
+BENCHMARK(frame)
+        ->ArgNames({ "renderables", "lights", "materials", "shadows", "post" })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime()
+        ->Args({  1000,    0,   16, 0, 0 })
+        ->Args({  1000,    0,   16, 1, 0 })
+        ->Args({  1000,    0,   16, 0, 1 })
+        ->Args({  1000,  128,   16, 0, 0 })
+        ->Args({  1000,  256,   16, 1, 1 })
+        ->Args({ 10000,    0,   16, 0, 0 })
+        ->Args({ 10000,    0, 1000, 0, 0 })
+        ->Args({ 10000,  256,  256, 1, 1 });
+
+BENCHMARK(lights)
+        ->ArgName("lights")
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime()
+        ->RangeMultiplier(4)
+        ->Range(64, 16384);
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "ResourceAllocator.h"
+
+#include "fg/FrameGraph.h"
+#include "fg/FrameGraphResources.h"
+
+using namespace filament;
+using namespace backend;
+
+/*
+ * Measures the cost of declaring and compiling a FrameGraph similar to the ones of
+ * filament_framegraph_test: a depth pass, a g-buffer pass, a lighting pass followed by a chain
+ * of post-processing passes, some of which are culled. Passes are not executed.
+ *
+ * Arguments are: number of post-processing passes, whether the compile cache is used (0/1)
+ */
+
+namespace {
+
+class NoopResourceAllocator : public ResourceAllocatorInterface {
+public:
+    RenderTargetHandle createRenderTarget(const char*, TargetBufferFlags, uint32_t, uint32_t,
+            uint8_t, MRT, TargetBufferInfo, TargetBufferInfo) noexcept override {
+        return {};
+    }
+    void destroyRenderTarget(RenderTargetHandle) noexcept override {
+    }
+    TextureHandle createTexture(const char*, SamplerType, uint8_t, TextureFormat, uint8_t,
+            uint32_t, uint32_t, uint32_t, std::array<TextureSwizzle, 4>,
+            TextureUsage) noexcept override {
+        return {};
+    }
+    void destroyTexture(TextureHandle) noexcept override {
+    }
+};
+
+void buildFrameGraph(FrameGraph& fg, size_t postProcessPassCount) {
+    struct DepthPassData {
+        FrameGraphId<FrameGraphTexture> depth;
+    };
+    auto& depthPass = fg.addPass<DepthPassData>("Depth pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.depth = builder.create<FrameGraphTexture>("Depth Buffer",
+                        { .width = 1920, .height = 1080, .format = TextureFormat::DEPTH32F });
+                data.depth = builder.write(data.depth, FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                builder.declareRenderPass("Depth target", { .attachments = { .depth = data.depth }});
+            },
+            [](FrameGraphResources const&, auto const&, DriverApi&) {});
+
+    struct GBufferPassData {
+        FrameGraphId<FrameGraphTexture> depth;
+        FrameGraphId<FrameGraphTexture> gbuf1;
+        FrameGraphId<FrameGraphTexture> gbuf2;
+    };
+    auto& gBufferPass = fg.addPass<GBufferPassData>("Gbuffer pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.depth = builder.read(depthPass->depth,
+                        FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                FrameGraphTexture::Descriptor desc{ .width = 1920, .height = 1080 };
+                data.gbuf1 = builder.create<FrameGraphTexture>("Gbuffer 1", desc);
+                data.gbuf2 = builder.create<FrameGraphTexture>("Gbuffer 2", desc);
+                data.depth = builder.write(data.depth, FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                data.gbuf1 = builder.write(data.gbuf1, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                data.gbuf2 = builder.write(data.gbuf2, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                builder.declareRenderPass("Gbuffer target", { .attachments = {
+                        .color = { data.gbuf1, data.gbuf2 }, .depth = data.depth }});
+            },
+            [](FrameGraphResources const&, auto const&, DriverApi&) {});
+
+    struct ColorPassData {
+        FrameGraphId<FrameGraphTexture> input;
+        FrameGraphId<FrameGraphTexture> output;
+    };
+    auto& lightingPass = fg.addPass<ColorPassData>("Lighting pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                builder.sample(gBufferPass->depth);
+                builder.sample(gBufferPass->gbuf2);
+                data.input = builder.sample(gBufferPass->gbuf1);
+                data.output = builder.create<FrameGraphTexture>("Lighting buffer",
+                        { .width = 1920, .height = 1080 });
+                data.output = builder.declareRenderPass(data.output);
+            },
+            [](FrameGraphResources const&, auto const&, DriverApi&) {});
+
+    FrameGraphId<FrameGraphTexture> input = lightingPass->output;
+    for (size_t i = 0; i < postProcessPassCount; i++) {
+        auto& pass = fg.addPass<ColorPassData>("Post-process pass",
+                [&](FrameGraph::Builder& builder, auto& data) {
+                    data.input = builder.sample(input);
+                    data.output = builder.create<FrameGraphTexture>("Post-process buffer",
+                            { .width = 1920, .height = 1080 });
+                    data.output = builder.declareRenderPass(data.output);
+                },
+                [](FrameGraphResources const&, auto const&, DriverApi&) {});
+        // every 4th pass is a debug pass whose output is never used, so it gets culled
+        if (i % 4 != 3) {
+            input = pass->output;
+        }
+    }
+
+    fg.present(input);
+}
+
+} // anonymous namespace
+
+static void frameGraphCompile(benchmark::State& state) {
+    const size_t postProcessPassCount = size_t(state.range(0));
+    const bool cached = state.range(1) != 0;
+    NoopResourceAllocator resourceAllocator;
+    FrameGraph::CompileCache cache;
+    for (auto _ : state) {
+        FrameGraph fg(resourceAllocator);
+        buildFrameGraph(fg, postProcessPassCount);
+        fg.compile(cached ? &cache : nullptr);
+        benchmark::DoNotOptimize(fg.getTransientMemory());
+    }
+}
+
+BENCHMARK(frameGraphCompile)
+        ->ArgNames({ "passes", "cached" })
+        ->Args({   8, 0 })
+        ->Args({   8, 1 })
+        ->Args({  32, 0 })
+        ->Args({  32, 1 })
+        ->Args({ 128, 0 })
+        ->Args({ 128, 1 });
@@ -97,6 +97,7 @@ class FColorGrading;
  * - Tone mapping: ACESLegacyToneMapper
  * - Luminance scaling: false
  * - Gamut mapping: false
+ * - GPU baking: false
  *
  * @see View
  */
@@ -241,6 +242,30 @@ public:
          */
         Builder& gamutMapping(bool gamutMapping) noexcept;
 
+        /**
+         * Enables or disables baking the 3D LUT on the GPU. When enabled, the color adjustments
+         * are evaluated by a post-processing material the first time this ColorGrading is used
+         * for rendering, instead of on the CPU when it is built. This makes building a new
+         * ColorGrading much cheaper, which is useful when the color adjustments are animated.
+         *
+         * The tone mapping step (tone mapper, luminance scaling and gamut mapping) is still
+         * evaluated on the CPU, in its own LUT which is shared by all the ColorGrading objects
+         * built with the same tone mapper and settings. A tone mapper is identified by its
+         * address and its response to a few sample colors, creating a new ToneMapper rather
+         * than modifying one that is in use is recommended.
+         *
+         * The result is slightly different from the LUT generated on the CPU, which remains the
+         * reference. GPU baking is only supported by the OpenGL backend; with other backends, or
+         * when the GPU can't render to the LUT's format, the LUT is generated on the CPU.
+         *
+         * The default is false.
+         *
+         * @param gpuBaking Enables or disables baking the 3D LUT on the GPU
+         *
+         * @return This Builder, for chaining calls
+         */
+        Builder& gpuBaking(bool gpuBaking) noexcept;
+
         /**
          * Adjusts the exposure of this image. The exposure is specified in stops:
          * each stop brightens (positive values) or darkens (negative values) the image by
@@ -118,12 +118,34 @@ public:
 
     DataSource getDataSource(const char* name) const noexcept;
 
+    /**
+     * CPU time spent in the main stages of the frames rendered since the
+     * "d.renderer.frameStats" property was set to true, in milliseconds. This is the
+     * "d.renderer.frameStats" data source, it is updated by Renderer::endFrame().
+     *
+     * Stage times are exclusive, e.g. the commands generated and sorted while the frame graph
+     * executes are only accounted for in commandGeneration and sort. Froxelization runs in a
+     * job, concurrently with the other stages.
+     */
+    struct FrameStats {
+        using duration_ms = double;
+        duration_ms scenePrepare{};         //!< scene preparation and renderables' UBOs update
+        duration_ms culling{};              //!< renderables and lights culling
+        duration_ms shadows{};              //!< shadow maps setup and shadow casters culling
+        duration_ms froxelization{};        //!< lights froxelization
+        duration_ms commandGeneration{};    //!< render commands generation
+        duration_ms sort{};                 //!< render commands sort
+        duration_ms execute{};              //!< frame graph compile and execute
+        uint32_t frameCount = 0;            //!< number of frames the times are accumulated over
+    };
+
     struct FrameHistory {
         using duration_ms = float;
         duration_ms target{};
         duration_ms targetWithHeadroom{};
         duration_ms frameTime{};
         duration_ms frameTimeDenoised{};
+        duration_ms cpuFrameTime{};
         float scale = 1.0f;
         float pid_e = 0.0f;
         float pid_i = 0.0f;
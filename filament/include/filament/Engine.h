@@ -21,6 +21,8 @@
 
 #include <utils/compiler.h>
 
+#include <stdint.h>
+
 namespace utils {
 class Entity;
 class EntityManager;
@@ -152,6 +154,25 @@ public:
     using Platform = backend::Platform;
     using Backend = backend::Backend;
 
+    /**
+     * Engine configuration, see create()
+     */
+    struct Config {
+        /**
+         * Size in MiB of the backend's handle arena, where the backend objects (textures,
+         * buffers, etc...) are allocated. 0 uses the backend's default. Objects that don't fit
+         * in the arena are allocated on the heap, which is slower.
+         */
+        uint32_t driverHandleArenaSizeMB = 0;
+
+        /**
+         * Relative sizes of the small, medium and large handle pools within the handle arena.
+         * The arena is split proportionally to these weights, which must not be 0. Debug
+         * builds log the pools' high watermarks when the Engine is destroyed, to help tune them.
+         */
+        uint32_t driverHandlePoolSizes[3] = { 1, 15, 16 };
+    };
+
     /**
      * Creates an instance of Engine
      *
@@ -175,6 +196,8 @@ public:
      *                          Setting this parameter will force filament to use the OpenGL
      *                          implementation (instead of Vulkan for instance).
      *
+     * @param config            A pointer to the Engine configuration, or nullptr to use the
+     *                          default configuration.
      *
      * @return A pointer to the newly created Engine, or nullptr if the Engine couldn't be created.
      *
@@ -189,7 +212,8 @@ public:
      * This method is thread-safe.
      */
     static Engine* create(Backend backend = Backend::DEFAULT,
-            Platform* platform = nullptr, void* sharedGLContext = nullptr);
+            Platform* platform = nullptr, void* sharedGLContext = nullptr,
+            const Config* config = nullptr);
 
 #if UTILS_HAS_THREADING
     /**
@@ -231,10 +255,14 @@ public:
      *                          when creating filament's internal context.
      *                          Setting this parameter will force filament to use the OpenGL
      *                          implementation (instead of Vulkan for instance).
+     *
+     * @param config            A pointer to the Engine configuration, or nullptr to use the
+     *                          default configuration.
      */
     static void createAsync(CreateCallback callback, void* user,
             Backend backend = Backend::DEFAULT,
-            Platform* platform = nullptr, void* sharedGLContext = nullptr);
+            Platform* platform = nullptr, void* sharedGLContext = nullptr,
+            const Config* config = nullptr);
 
     /**
      * Retrieve an Engine* from createAsync(). This must be called from the same thread than
@@ -546,6 +574,44 @@ public:
 
     DebugRegistry& getDebugRegistry() noexcept;
 
+    /**
+     * Sets the memory budget of the cache of textures the Engine allocates internally for
+     * rendering (e.g. post-processing buffers or shadow maps). Textures that are no longer in use
+     * are kept in the cache so they can be reused by the next frames, and are evicted, least
+     * recently used first, when the cache exceeds this budget.
+     *
+     * Applications rendering several Views of different resolutions might want to increase this
+     * budget to avoid recreating textures each frame. The default is 64 MiB.
+     *
+     * @param budget Maximum size in bytes of the unused textures kept in the cache.
+     */
+    void setTextureCacheBudget(size_t budget) noexcept;
+
+    /**
+     * @return The memory budget of the internal texture cache in bytes.
+     * @see setTextureCacheBudget
+     */
+    size_t getTextureCacheBudget() const noexcept;
+
+    /**
+     * Statistics of the internal texture cache, counters are accumulated since the Engine was
+     * created.
+     */
+    struct TextureCacheStats {
+        size_t hits;            //!< number of textures taken from the cache
+        size_t misses;          //!< number of textures that had to be created
+        size_t evictions;       //!< number of textures evicted from the cache
+        size_t bytesEvicted;    //!< size in bytes of the textures evicted from the cache
+        size_t cacheSize;       //!< size in bytes of the unused textures currently in the cache
+        size_t inUseSize;       //!< size in bytes of the textures currently in use
+    };
+
+    /**
+     * @return Statistics of the internal texture cache.
+     * @see setTextureCacheBudget
+     */
+    TextureCacheStats getTextureCacheStats() const noexcept;
+
 protected:
     //! \privatesection
     Engine() noexcept = default;
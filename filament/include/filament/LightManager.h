@@ -134,6 +134,9 @@ class FLightManager;
  *    On the other hand, a scene can contain hundreds of non overlapping lights without
  *    incurring a significant overhead.
  *
+ * 3. At most 256 point and spot lights can be visible at once. When more lights are visible,
+ *    only the 256 closest to the camera are used for lighting, the others are ignored.
+ *
  */
 class UTILS_PUBLIC LightManager : public FilamentAPI {
     struct BuilderDetails;
@@ -340,6 +343,21 @@ public:
          * enabled. (2cm by default).
          */
         float shadowBulbRadius = 0.02f;
+
+        /**
+         * Whether the shadow cascades past the first one are updated incrementally. When enabled,
+         * the first cascade is rendered every frame, but only one of the other cascades is, in
+         * turn; the others reuse the shadow map they were last rendered with. This reduces the
+         * number of shadow draw calls significantly with 3 or more cascades, at the cost of
+         * the shadows of moving objects lagging behind in the distant cascades.
+         * A cascade is always rendered when the camera moved enough that its last shadow map
+         * doesn't cover its part of the view frustum anymore.
+         *
+         * This requires stable shadows (see ShadowOptions::stable) and is ignored otherwise.
+         * This is ignored when the View's ShadowType is set to VSM.
+         * (off by default)
+         */
+        bool incrementalCascadeUpdates = false;
     };
 
     struct ShadowCascades {
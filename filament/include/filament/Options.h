@@ -63,6 +63,12 @@ enum class BlendMode : uint8_t {
  * quality:   upscaling quality.
  *            LOW: 1 bilinear tap, Medium: 4 bilinear taps, High: 9 bilinear taps (tent)
  *
+ * controller: how the scale factor is computed from the frame times.
+ *            PID: the scale factor follows the GPU frame time error relative to the target.
+ *            PREDICTIVE: the scale factor that should hit the target is predicted from the GPU
+ *            frame time. The CPU frame time is taken into account, so that the resolution isn't
+ *            lowered when the CPU alone misses the target.
+ *
  * \note
  * Dynamic resolution is only supported on platforms where the time to render
  * a frame can be measured accurately. Dynamic resolution is currently only
@@ -89,6 +95,21 @@ struct DynamicResolutionOptions {
      * The default upscaling quality is set to LOW.
      */
     QualityLevel quality = QualityLevel::LOW;
+
+    /**
+     * Dynamic resolution controller
+     * PID:        follows the GPU frame time error, with a dead band
+     * PREDICTIVE: models the GPU frame time as a function of the resolution and sets the scale
+     *             factor that hits the target, with hysteresis. The CPU frame time is taken
+     *             into account.
+     *
+     * The default controller is PID.
+     */
+    enum class Controller : uint8_t {
+        PID,
+        PREDICTIVE
+    };
+    Controller controller = Controller::PID;
 };
 
 /**
@@ -261,7 +282,7 @@ struct AmbientOcclusionOptions {
     float radius = 0.3f;    //!< Ambient Occlusion radius in meters, between 0 and ~10.
     float power = 1.0f;     //!< Controls ambient occlusion's contrast. Must be positive.
     float bias = 0.0005f;   //!< Self-occlusion bias in meters. Use to avoid self-occlusion. Between 0 and a few mm.
-    float resolution = 0.5f;//!< How each dimension of the AO buffer is scaled. Must be either 0.5 or 1.0.
+    float resolution = 0.5f;//!< How each dimension of the AO buffer is scaled. Must be either 0.25, 0.5 or 1.0.
     float intensity = 1.0f; //!< Strength of the Ambient Occlusion effect.
     float bilateralThreshold = 0.05f; //!< depth distance that constitute an edge for filtering
     QualityLevel quality = QualityLevel::LOW; //!< affects # of samples used for AO.
@@ -330,6 +351,7 @@ struct ScreenSpaceReflectionsOptions {
     float bias = 0.01f;         //!< bias, in world units, to prevent self-intersections
     float maxDistance = 3.0f;   //!< maximum distance, in world units, to raycast
     float stride = 2.0f;        //!< stride, in texels, for samples along the ray.
+    float resolution = 1.0f;    //!< How each dimension of the reflection buffer is scaled. Must be either 0.5 or 1.0.
     bool enabled = false;
 };
 
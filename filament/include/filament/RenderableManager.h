@@ -253,6 +253,19 @@ public:
          */
         Builder& screenSpaceContactShadows(bool enable) noexcept;
 
+        /**
+         * Hints that this renderable is a static shadow caster, false by default.
+         *
+         * The depth of static shadow casters is cached across frames and only re-rendered when
+         * the shadow map's light frustum changes, or when a static shadow caster is added,
+         * removed, moved or changes its static state. The other shadow casters are rendered on
+         * top of the cached depth every frame.
+         *
+         * A static shadow caster's geometry and materials must not change while it is static.
+         * This has no effect when the View's shadow type is ShadowType::VSM.
+         */
+        Builder& staticShadowCaster(bool enable) noexcept;
+
         /**
          * Allows bones to be swapped out and shared using SkinningBuffer.
          *
@@ -499,6 +512,20 @@ public:
      */
     void setScreenSpaceContactShadows(Instance instance, bool enable) noexcept;
 
+    /**
+     * Changes whether or not the renderable is a static shadow caster.
+     *
+     * \see Builder::staticShadowCaster()
+     */
+    void setStaticShadowCaster(Instance instance, bool enable) noexcept;
+
+    /**
+     * Checks if the renderable is a static shadow caster.
+     *
+     * \see Builder::staticShadowCaster()
+     */
+    bool isStaticShadowCaster(Instance instance) const noexcept;
+
     /**
      * Checks if the renderable can cast shadows.
      *
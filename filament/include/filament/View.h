@@ -531,6 +531,21 @@ public:
      */
     void setDynamicLightingOptions(float zLightNear, float zLightFar) noexcept;
 
+    /**
+     * Enables or disables adaptive dynamic lighting, disabled by default.
+     *
+     * When enabled, the range set with setDynamicLightingOptions() is tightened every frame to
+     * the depth range of the visible renderables: zLightNear can be pushed further and zLightFar
+     * brought closer, which concentrates the froxel slices where the geometry is and skips
+     * lights that can't reach any visible renderable.
+     *
+     * @param enabled true to enable adaptive dynamic lighting, false to disable it.
+     */
+    void setAdaptiveDynamicLightingEnabled(bool enabled) noexcept;
+
+    //! Returns true if adaptive dynamic lighting is enabled.
+    bool isAdaptiveDynamicLightingEnabled() const noexcept;
+
     /*
      * Set the shadow mapping technique this View uses.
      *
@@ -29,6 +29,10 @@
 #    define FILAMENT_PER_FRAME_COMMANDS_SIZE_IN_MB 2
 #endif
 
+#ifndef FILAMENT_FRAMES_IN_FLIGHT
+#    define FILAMENT_FRAMES_IN_FLIGHT 2
+#endif
+
 namespace filament {
 
 // per render pass allocations
@@ -38,9 +42,15 @@ static constexpr size_t CONFIG_PER_RENDER_PASS_ARENA_SIZE  = FILAMENT_PER_RENDER
 // size of the high-level draw commands buffer (comes from the per-render pass allocator)
 static constexpr size_t CONFIG_PER_FRAME_COMMANDS_SIZE     = FILAMENT_PER_FRAME_COMMANDS_SIZE_IN_MB * 1024 * 1024;
 
+// number of frames the main thread can run ahead of the gpu. The command stream is sized so the
+// main thread can prepare a frame while the driver thread and the gpu process the previous ones.
+static constexpr size_t CONFIG_FRAMES_IN_FLIGHT            = FILAMENT_FRAMES_IN_FLIGHT;
+static_assert(CONFIG_FRAMES_IN_FLIGHT >= 1 && CONFIG_FRAMES_IN_FLIGHT <= 4,
+        "FILAMENT_FRAMES_IN_FLIGHT must be between 1 and 4");
+
 // size of a command-stream buffer (comes from mmap -- not the per-engine arena)
 static constexpr size_t CONFIG_MIN_COMMAND_BUFFERS_SIZE    = FILAMENT_MIN_COMMAND_BUFFERS_SIZE_IN_MB * 1024 * 1024;
-static constexpr size_t CONFIG_COMMAND_BUFFERS_SIZE        = 3 * CONFIG_MIN_COMMAND_BUFFERS_SIZE;
+static constexpr size_t CONFIG_COMMAND_BUFFERS_SIZE        = (CONFIG_FRAMES_IN_FLIGHT + 1) * CONFIG_MIN_COMMAND_BUFFERS_SIZE;
 
 #ifndef NDEBUG
 
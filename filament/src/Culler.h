@@ -42,7 +42,7 @@ public:
         return (count + (MODULO - 1)) & ~(MODULO - 1);
     }
 
-    using result_type = uint16_t;
+    using result_type = uint32_t;
 
     /*
      * returns whether each AABB in an array intersects with the frustum
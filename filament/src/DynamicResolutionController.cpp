@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DynamicResolutionController.h"
+
+#include <utils/compiler.h>
+
+#include <math/scalar.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace filament {
+
+using namespace math;
+
+DynamicResolutionController::~DynamicResolutionController() noexcept = default;
+
+float2 DynamicResolutionController::getAxisScale(
+        float scale, float w, float h, bool homogeneous) noexcept {
+    if (scale < 1.0f && !homogeneous) {
+        // figure out the major and minor axis
+        const float major = std::max(w, h);
+        const float minor = std::min(w, h);
+
+        // the major axis is scaled down first, down to the minor axis
+        const float maxMajorScale = minor / major;
+        const float majorScale = std::max(scale, maxMajorScale);
+
+        // then the minor axis is scaled down to the original aspect-ratio
+        const float minorScale = std::max(scale / majorScale, majorScale * maxMajorScale);
+
+        // if we have some scaling capacity left, scale homogeneously
+        const float homogeneousScale = scale / (majorScale * minorScale);
+
+        // finally, write the scale factors
+        float2 result;
+        float& majorRef = w > h ? result.x : result.y;
+        float& minorRef = w > h ? result.y : result.x;
+        majorRef = std::sqrt(homogeneousScale) * majorScale;
+        minorRef = std::sqrt(homogeneousScale) * minorScale;
+        return result;
+    }
+    // when scaling up, we're always using homogeneous scaling.
+    return std::sqrt(scale);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+PIDResolutionController::PIDResolutionController() noexcept {
+    // Integral term is used to fight back the dead-band below, we limit how much it can act.
+    mPidController.setIntegralLimits(-100.0f, 100.0f);
+
+    // dead-band, 1% for scaling down, 5% for scaling up. This stabilizes all the jitters.
+    mPidController.setOutputDeadBand(-0.01f, 0.05f);
+}
+
+float PIDResolutionController::update(Input const& input, float scale) noexcept {
+    const float dt = 1.0f; // we don't really need dt here, setting it to 1, means our parameters are in "frames"
+    const float out = mPidController.update(input.gpuFrameTime / input.target, 1.0f, dt);
+
+    // maps pid command to a scale (absolute or relative, see below)
+    const float command = out < 0.0f ? (1.0f / (1.0f - out)) : (1.0f + out);
+
+    /*
+     * There is two ways we can control the scale factor, either by having the PID controller
+     * output a new scale factor directly (like a "position" control), or having it evaluate
+     * a relative scale factor (like a "velocity" control).
+     * More experimentation is needed to figure out which works better in more cases.
+     */
+
+    // direct scaling ("position" control)
+    //return command;
+    // relative scaling ("velocity" control)
+    return scale * command;
+}
+
+void PIDResolutionController::setSaturated(bool saturated) noexcept {
+    // disable the integration term when we're outside the controllable range
+    // (i.e. we clamped). This help not to have to wait too long for the Integral term
+    // to kick in after a clamping event.
+    mPidController.setIntegralInhibitionEnabled(saturated);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+float PredictiveResolutionController::update(Input const& input, float scale) noexcept {
+    // The frame times lag behind the scale factor (timer queries are read a few frames late and
+    // the frame times are median filtered), wait for them to settle after each change. The scale
+    // factor is the product of the per-axis scale factors, so it's compared with a tolerance.
+    if (std::abs(scale - mScale) > SCALE_EPSILON * mScale) {
+        mScale = scale;
+        mFramesSinceChange = 0;
+    }
+    if (mFramesSinceChange < input.latency) {
+        mFramesSinceChange++;
+        return scale;
+    }
+
+    const float gpu = input.gpuFrameTime;
+    if (UTILS_UNLIKELY(gpu <= 0.0f || scale <= 0.0f)) {
+        return scale;
+    }
+
+    // estimate how much of the GPU time depends on the scale factor from the last two settled
+    // frames, if their scale factors are different enough.
+    if (mSampleScale > 0.0f) {
+        const float scaleChange = scale / mSampleScale - 1.0f;
+        if (std::abs(scaleChange) > MIN_SCALE_CHANGE) {
+            const float ratio = (gpu / mSampleTime - 1.0f) / scaleChange;
+            mScalableRatio = mix(mScalableRatio, clamp(ratio, MIN_SCALABLE_RATIO, 1.0f), 0.5f);
+        }
+    }
+    mSampleScale = scale;
+    mSampleTime = gpu;
+
+    // lowering the resolution doesn't help when we're bound by the CPU
+    const float budget = std::max(input.target, input.cpuFrameTime);
+    if (gpu <= budget && gpu >= budget * (1.0f - HYSTERESIS)) {
+        return scale;
+    }
+
+    // aim at the middle of the hysteresis band, with gpu(s) = gpu * (1 - r + r * s / scale)
+    const float goal = budget * (1.0f - 0.5f * HYSTERESIS);
+    const float change = clamp(1.0f + (goal / gpu - 1.0f) / mScalableRatio, 0.25f, 4.0f);
+    if (change < 1.0f) {
+        // we're missing the target, scale down right away
+        return scale * change;
+    }
+    const float rate = 1.0f - std::exp(-input.scaleRate * float(std::max(input.latency, 1u)));
+    return scale * std::pow(change, rate);
+}
+
+} // namespace filament
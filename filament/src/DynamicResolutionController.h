@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_DYNAMICRESOLUTIONCONTROLLER_H
+#define TNT_FILAMENT_DYNAMICRESOLUTIONCONTROLLER_H
+
+#include "PIDController.h"
+
+#include <math/vec2.h>
+
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * A DynamicResolutionController computes the scale factor (i.e. the ratio of pixels rendered)
+ * of a View from its measured frame times. Controllers don't depend on the engine, so they can
+ * be driven by recorded frame timings (see benchmark_dynamic_resolution.cpp).
+ */
+class DynamicResolutionController {
+public:
+    // all times are in ms
+    struct Input {
+        float gpuFrameTime;     // denoised GPU frame time
+        float cpuFrameTime;     // denoised CPU frame time, 0 if unknown
+        float target;           // target frame time, including the headroom
+        float scaleRate;        // rate at which the controller reacts to load changes
+        uint32_t latency;       // number of frames before a scale change shows in the frame times
+    };
+
+    virtual ~DynamicResolutionController() noexcept;
+
+    // Returns the new scale factor, given the scale factor currently used. The returned value is
+    // not clamped, setSaturated() is called when the caller had to.
+    virtual float update(Input const& input, float scale) noexcept = 0;
+
+    // called after each update() with whether the new scale factor had to be clamped
+    virtual void setSaturated(bool saturated) noexcept { }
+
+    // Distributes the scale factor on each axis of a w x h viewport. Unless homogeneous is set,
+    // the major axis is scaled down first, down to the minor axis.
+    static math::float2 getAxisScale(float scale, float w, float h, bool homogeneous) noexcept;
+};
+
+/*
+ * The PID controller only looks at the GPU frame time, and reacts to the error relative to the
+ * target with a dead band.
+ */
+class PIDResolutionController final : public DynamicResolutionController {
+public:
+    // the proportional gain derives from FrameRateOptions::scaleRate
+    static constexpr float DEFAULT_Ki = 0.002f;
+    static constexpr float DEFAULT_Kd = 0.0f;
+
+    PIDResolutionController() noexcept;
+
+    void setGains(float Kp, float Ki, float Kd) noexcept {
+        mPidController.setParallelGains(Kp, Ki, Kd);
+    }
+
+    PIDController const& getPIDController() const noexcept {
+        return mPidController;
+    }
+
+    float update(Input const& input, float scale) noexcept override;
+
+    void setSaturated(bool saturated) noexcept override;
+
+private:
+    PIDController mPidController;
+};
+
+/*
+ * The predictive controller models the GPU frame time as a fixed cost plus a cost proportional
+ * to the scale factor, and sets the scale factor that should hit the target directly. The ratio
+ * of the two costs is estimated each time the scale changes.
+ *
+ * The frame rate is bound by the slowest of the CPU and the GPU, so when the CPU alone misses
+ * the target, the GPU is allowed to use the CPU frame time: lowering the resolution wouldn't
+ * help.
+ *
+ * The scale factor doesn't change while the GPU frame time is within HYSTERESIS of the budget,
+ * and doesn't change again until the frame times reflect the last change. Scaling down is
+ * immediate, scaling up is rate-limited by scaleRate.
+ */
+class PredictiveResolutionController final : public DynamicResolutionController {
+public:
+    // the scale factor is kept while the GPU time is in [1 - HYSTERESIS, 1] x budget
+    static constexpr float HYSTERESIS = 0.1f;
+
+    float update(Input const& input, float scale) noexcept override;
+
+    float getScalableRatio() const noexcept {
+        return mScalableRatio;
+    }
+
+private:
+    // relative difference below which two scale factors are the same
+    static constexpr float SCALE_EPSILON = 1e-4f;
+    // smallest relative scale change used to estimate the scalable ratio
+    static constexpr float MIN_SCALE_CHANGE = 0.05f;
+    // we always assume that some of the GPU frame time depends on the resolution
+    static constexpr float MIN_SCALABLE_RATIO = 0.25f;
+
+    float mScale = 0.0f;            // scale factor seen by the last update()
+    uint32_t mFramesSinceChange = 0;
+    float mSampleScale = 0.0f;      // scale factor and GPU time of the last settled frame
+    float mSampleTime = 0.0f;
+    float mScalableRatio = 1.0f;    // ratio of the GPU time proportional to the scale factor
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_DYNAMICRESOLUTIONCONTROLLER_H
@@ -16,6 +16,8 @@
 
 #include "details/Engine.h"
 
+#include "ResourceAllocator.h"
+
 #include "details/BufferObject.h"
 #include "details/Camera.h"
 #include "details/Fence.h"
@@ -44,8 +46,9 @@ namespace filament {
 using namespace math;
 using namespace backend;
 
-Engine* Engine::create(Backend backend, Platform* platform, void* sharedGLContext) {
-    return FEngine::create(backend, platform, sharedGLContext);
+Engine* Engine::create(Backend backend, Platform* platform, void* sharedGLContext,
+        const Config* config) {
+    return FEngine::create(backend, platform, sharedGLContext, config);
 }
 
 void Engine::destroy(Engine* engine) {
@@ -54,8 +57,8 @@ void Engine::destroy(Engine* engine) {
 
 #if UTILS_HAS_THREADING
 void Engine::createAsync(Engine::CreateCallback callback, void* user, Backend backend,
-        Platform* platform, void* sharedGLContext) {
-    FEngine::createAsync(callback, user, backend, platform, sharedGLContext);
+        Platform* platform, void* sharedGLContext, const Config* config) {
+    FEngine::createAsync(callback, user, backend, platform, sharedGLContext, config);
 }
 
 Engine* Engine::getEngine(void* token) {
@@ -247,6 +250,26 @@ DebugRegistry& Engine::getDebugRegistry() noexcept {
     return upcast(this)->getDebugRegistry();
 }
 
+void Engine::setTextureCacheBudget(size_t budget) noexcept {
+    upcast(this)->getResourceAllocator().setCacheBudget(budget);
+}
+
+size_t Engine::getTextureCacheBudget() const noexcept {
+    return upcast(this)->getResourceAllocator().getCacheBudget();
+}
+
+Engine::TextureCacheStats Engine::getTextureCacheStats() const noexcept {
+    ResourceAllocator::Stats const stats = upcast(this)->getResourceAllocator().getStats();
+    return {
+            .hits = stats.hits,
+            .misses = stats.misses,
+            .evictions = stats.evictions,
+            .bytesEvicted = stats.bytesEvicted,
+            .cacheSize = stats.cacheSize,
+            .inUseSize = stats.inUseSize
+    };
+}
+
 void Engine::pumpMessageQueues() {
     upcast(this)->pumpMessageQueues();
 }
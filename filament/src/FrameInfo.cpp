@@ -59,21 +59,26 @@ void FrameInfoManager::beginFrame(DriverApi& driver,Config const& config, uint32
         // conversion to our duration happens here
         mFrameTime = std::chrono::duration<uint64_t, std::nano>(elapsed);
     }
-    update(config, mFrameTime);
+    // the CPU frame time is available immediately, it's the one of the previous frame
+    update(config, mFrameTime, mCpuFrameTime);
+    mCpuFrameStart = clock::now();
 }
 
 void FrameInfoManager::endFrame(DriverApi& driver) noexcept {
+    mCpuFrameTime = clock::now() - mCpuFrameStart;
     driver.endTimerQuery(mQueries[mIndex]);
     mIndex = (mIndex + 1) % POOL_COUNT;
 }
 
-void FrameInfoManager::update(Config const& config, FrameInfoManager::duration lastFrameTime) noexcept {
+void FrameInfoManager::update(Config const& config,
+        FrameInfoManager::duration lastFrameTime, FrameInfoManager::duration lastCpuFrameTime) noexcept {
     // keep an history of frame times
     auto& history = mFrameTimeHistory;
 
     // this is like doing { pop_back(); push_front(); }
     filament::move_backward(history.begin(), history.end() - 1, history.end());
     history[0].frameTime = lastFrameTime;
+    history[0].cpuFrameTime = lastCpuFrameTime;
 
     mFrameTimeHistorySize = std::min(++mFrameTimeHistorySize, uint32_t(MAX_FRAMETIME_HISTORY));
     if (UTILS_UNLIKELY(mFrameTimeHistorySize < 3)) {
@@ -92,7 +97,14 @@ void FrameInfoManager::update(Config const& config, FrameInfoManager::duration l
     std::sort(median.begin(), median.begin() + size);
     duration denoisedFrameTime = median[size / 2];
 
+    for (size_t i = 0; i < size; ++i) {
+        median[i] = history[i].cpuFrameTime;
+    }
+    std::sort(median.begin(), median.begin() + size);
+    duration denoisedCpuFrameTime = median[size / 2];
+
     history[0].denoisedFrameTime = denoisedFrameTime;
+    history[0].denoisedCpuFrameTime = denoisedCpuFrameTime;
     history[0].valid = true;
 }
 
@@ -32,14 +32,18 @@ struct FrameInfo {
     using duration = std::chrono::duration<float, std::milli>;
     duration frameTime{};            // frame period
     duration denoisedFrameTime{};    // frame period (median filter)
+    duration cpuFrameTime{};         // time between Renderer::beginFrame() and endFrame()
+    duration denoisedCpuFrameTime{}; // time between Renderer::beginFrame() and endFrame() (median filter)
     bool valid = false;
 };
 
 class FrameInfoManager {
-    static constexpr size_t POOL_COUNT = 4;
     static constexpr size_t MAX_FRAMETIME_HISTORY = 31u;
 
 public:
+    // number of timer queries, this bounds the number of frames in flight
+    static constexpr size_t POOL_COUNT = 4;
+
     using duration = FrameInfo::duration;
 
     struct Config {
@@ -66,9 +70,12 @@ public:
     }
 
 private:
-    void update(Config const& config, duration lastFrameTime) noexcept;
+    using clock = std::chrono::steady_clock;
+    void update(Config const& config, duration lastFrameTime, duration lastCpuFrameTime) noexcept;
     backend::Handle<backend::HwTimerQuery> mQueries[POOL_COUNT];
     duration mFrameTime{};
+    duration mCpuFrameTime{};
+    clock::time_point mCpuFrameStart{};
     uint32_t mIndex = 0;
     uint32_t mLast = 0;
 
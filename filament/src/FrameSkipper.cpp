@@ -28,7 +28,8 @@ using namespace backend;
 
 FrameSkipper::FrameSkipper(size_t latency) noexcept
         : mLast(latency) {
-    assert_invariant(latency <= MAX_FRAME_LATENCY);
+    // mDelayedSyncs[latency] must be a valid entry
+    assert_invariant(latency < MAX_FRAME_LATENCY);
 }
 
 FrameSkipper::~FrameSkipper() noexcept = default;
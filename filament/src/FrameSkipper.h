@@ -25,8 +25,10 @@
 namespace filament {
 
 class FrameSkipper {
-    static constexpr size_t MAX_FRAME_LATENCY = 4;
 public:
+    static constexpr size_t MAX_FRAME_LATENCY = 4;
+
+    // latency is the number of frames the gpu can be behind, in addition to the current one.
     explicit FrameSkipper(size_t latency = 2) noexcept;
     ~FrameSkipper() noexcept;
 
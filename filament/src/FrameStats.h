@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_FRAMESTATS_H
+#define TNT_FILAMENT_FRAMESTATS_H
+
+#include <filament/DebugRegistry.h>
+
+#include <utils/compiler.h>
+
+#include <atomic>
+#include <chrono>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+/*
+ * FrameStats accumulates the CPU time spent in the main stages of a frame. It is disabled by
+ * default, in which case recording a stage costs a single relaxed load. It is enabled and
+ * disabled between frames, with the "d.renderer.frameStats" debug property.
+ *
+ * Stage times are exclusive: when a stage is recorded while another one is in progress on the
+ * same thread (e.g. command generation during execute), its time is only accounted for in the
+ * inner stage. Stages recorded from a job (e.g. froxelization) overlap with the stages of the
+ * main thread.
+ *
+ * The accumulated times are published at the end of each frame in the "d.renderer.frameStats"
+ * debug data source (see DebugRegistry::FrameStats), which is used by tools such as
+ * benchmark_frame.
+ */
+class FrameStats {
+public:
+    using clock = std::chrono::steady_clock;
+    using duration = std::chrono::duration<double, std::milli>;
+
+    enum class Stage : uint8_t {
+        SCENE_PREPARE,          // FScene::prepare() and FScene::updateUBOs()
+        CULLING,                // renderables and lights culling, visibility partitioning
+        SHADOWS,                // shadow maps setup and shadow casters culling
+        FROXELIZATION,          // lights froxelization
+        COMMAND_GENERATION,     // RenderPass::appendCommands()
+        SORT,                   // RenderPass::sortCommands()
+        EXECUTE,                // FrameGraph compile and execute
+    };
+
+    static constexpr size_t STAGE_COUNT = size_t(Stage::EXECUTE) + 1;
+
+    // Records the time spent in a stage until the end of the enclosing scope.
+    class Scope {
+    public:
+        Scope(FrameStats& stats, Stage stage) noexcept
+                : mStats(stats.isEnabled() ? &stats : nullptr), mStage(stage) {
+            if (UTILS_UNLIKELY(mStats)) {
+                mParent = sCurrent;
+                sCurrent = this;
+                mStart = clock::now();
+            }
+        }
+
+        ~Scope() noexcept {
+            if (UTILS_UNLIKELY(mStats)) {
+                const clock::duration d = clock::now() - mStart;
+                sCurrent = mParent;
+                if (mParent) {
+                    mParent->mChildren += d;
+                }
+                mStats->add(mStage, d - mChildren);
+            }
+        }
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        // innermost scope in progress on this thread
+        static inline thread_local Scope* sCurrent = nullptr;
+
+        FrameStats* const mStats;
+        const Stage mStage;
+        Scope* mParent = nullptr;
+        clock::time_point mStart;
+        clock::duration mChildren{};
+    };
+
+    // enabling the stats resets them
+    void setEnabled(bool enabled) noexcept {
+        if (enabled) {
+            reset();
+        }
+        mEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool isEnabled() const noexcept {
+        return mEnabled.load(std::memory_order_relaxed);
+    }
+
+    // returns the time accumulated in a stage since the stats were enabled
+    duration getTime(Stage stage) const noexcept {
+        int64_t ns = mTimes[size_t(stage)].load(std::memory_order_relaxed);
+        return std::chrono::nanoseconds(ns);
+    }
+
+    // copies the accumulated times to the debug data source, called at the end of each frame
+    void publish() noexcept {
+        mPublished.scenePrepare = getTime(Stage::SCENE_PREPARE).count();
+        mPublished.culling = getTime(Stage::CULLING).count();
+        mPublished.shadows = getTime(Stage::SHADOWS).count();
+        mPublished.froxelization = getTime(Stage::FROXELIZATION).count();
+        mPublished.commandGeneration = getTime(Stage::COMMAND_GENERATION).count();
+        mPublished.sort = getTime(Stage::SORT).count();
+        mPublished.execute = getTime(Stage::EXECUTE).count();
+        mPublished.frameCount++;
+    }
+
+    DebugRegistry::FrameStats const* getPublished() const noexcept {
+        return &mPublished;
+    }
+
+private:
+    void reset() noexcept {
+        for (auto& t : mTimes) {
+            t.store(0, std::memory_order_relaxed);
+        }
+        mPublished = {};
+    }
+
+    void add(Stage stage, clock::duration d) noexcept {
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+        mTimes[size_t(stage)].fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    std::atomic<int64_t> mTimes[STAGE_COUNT] = {};
+    std::atomic<bool> mEnabled{ false };
+    DebugRegistry::FrameStats mPublished;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_FRAMESTATS_H
@@ -59,9 +59,11 @@ constexpr size_t RECORD_BUFFER_WIDTH        = 1u << RECORD_BUFFER_WIDTH_SHIFT;
 constexpr size_t RECORD_BUFFER_HEIGHT       = 1024;
 constexpr size_t RECORD_BUFFER_ENTRY_COUNT  = RECORD_BUFFER_WIDTH * RECORD_BUFFER_HEIGHT; // 16K
 
-// Buffer needed for Froxelizer internal data structures (~256 KiB)
+// Buffer needed for Froxelizer internal data structures (~384 KiB)
+// (there is at most one tile per froxel)
 constexpr size_t PER_FROXELDATA_ARENA_SIZE = sizeof(float4) *
                                                  (FROXEL_BUFFER_ENTRY_COUNT_MAX +
+                                                  FROXEL_BUFFER_ENTRY_COUNT_MAX +
                                                   FROXEL_BUFFER_ENTRY_COUNT_MAX + 3 +
                                                   FEngine::CONFIG_FROXEL_SLICE_COUNT / 4 + 1);
 
@@ -104,6 +106,7 @@ void Froxelizer::terminate(DriverApi& driverApi) noexcept {
     // call reset() on our LinearAllocator arenas
     mArena.reset();
 
+    mTileBoundingSpheres = nullptr;
     mBoundingSpheres = nullptr;
     mPlanesY = nullptr;
     mPlanesX = nullptr;
@@ -261,11 +264,14 @@ bool Froxelizer::update() noexcept {
         // froxel count must fit on 16 bits
         const uint16_t froxelCount = uint16_t(froxelCountX * froxelCountY * froxelCountZ);
         mFroxelCount = froxelCount;
+        mTileCountX = uint16_t((froxelCountX + TILE_SIZE - 1) / TILE_SIZE);
+        mTileCountY = uint16_t((froxelCountY + TILE_SIZE - 1) / TILE_SIZE);
 
         if (mDistancesZ) {
             // this is a LinearAllocator arena, use rewind() instead of free (which is a no op).
             mArena.rewind(mDistancesZ);
 
+            mTileBoundingSpheres = nullptr;
             mBoundingSpheres = nullptr;
             mPlanesY = nullptr;
             mPlanesX = nullptr;
@@ -276,11 +282,13 @@ bool Froxelizer::update() noexcept {
         mPlanesX         = mArena.alloc<float4>(froxelCountX + 1);
         mPlanesY         = mArena.alloc<float4>(froxelCountY + 1);
         mBoundingSpheres = mArena.alloc<float4>(froxelCount);
+        mTileBoundingSpheres = mArena.alloc<float4>(mTileCountX * mTileCountY * froxelCountZ);
 
         assert_invariant(mDistancesZ);
         assert_invariant(mPlanesX);
         assert_invariant(mPlanesY);
         assert_invariant(mBoundingSpheres);
+        assert_invariant(mTileBoundingSpheres);
 
         mDistancesZ[0] = 0.0f;
         const float zLightNear = mZLightNear;
@@ -311,6 +319,7 @@ bool Froxelizer::update() noexcept {
         assert_invariant(mPlanesX);
         assert_invariant(mPlanesY);
         assert_invariant(mBoundingSpheres);
+        assert_invariant(mTileBoundingSpheres);
 
         // clip-space dimensions
         const float froxelWidthInClipSpace  = (2.0f * mFroxelDimension.x) / mViewport.width;
@@ -420,6 +429,41 @@ bool Froxelizer::update() noexcept {
             }
         }
 
+        // The bounding sphere of each tile contains the bounding spheres of its froxels, so a
+        // spotlight that misses a tile misses all its froxels.
+        float4* const UTILS_RESTRICT tileBoundingSpheres = mTileBoundingSpheres;
+        for (size_t iz = 0, ti = 0, nz = mFroxelCountZ; iz < nz; ++iz) {
+            for (size_t ty = 0; ty < mTileCountY; ++ty) {
+                for (size_t tx = 0; tx < mTileCountX; ++tx) {
+                    assert_invariant(getTileIndex(tx * TILE_SIZE, ty * TILE_SIZE, iz) == ti);
+                    const size_t x0 = tx * TILE_SIZE;
+                    const size_t y0 = ty * TILE_SIZE;
+                    const size_t x1 = std::min(x0 + TILE_SIZE, froxelCountX);
+                    const size_t y1 = std::min(y0 + TILE_SIZE, froxelCountY);
+                    float3 minp{ std::numeric_limits<float>::max() };
+                    float3 maxp{ std::numeric_limits<float>::lowest() };
+                    for (size_t iy = y0; iy < y1; ++iy) {
+                        for (size_t ix = x0; ix < x1; ++ix) {
+                            float4 const& sphere = boundingSpheres[getFroxelIndex(ix, iy, iz)];
+                            minp = min(minp, sphere.xyz - sphere.w);
+                            maxp = max(maxp, sphere.xyz + sphere.w);
+                        }
+                    }
+                    const float3 center = (maxp + minp) * 0.5f;
+                    float radius = 0.0f;
+                    for (size_t iy = y0; iy < y1; ++iy) {
+                        for (size_t ix = x0; ix < x1; ++ix) {
+                            float4 const& sphere = boundingSpheres[getFroxelIndex(ix, iy, iz)];
+                            radius = std::max(radius, length(sphere.xyz - center) + sphere.w);
+                        }
+                    }
+                    // a bit of margin so rounding errors can't make the tile test fail when a
+                    // froxel test wouldn't
+                    tileBoundingSpheres[ti++] = { center, radius * (1.0f + 1.0f / 1024.0f) };
+                }
+            }
+        }
+
         float Pz = mProjection[2][2];
         float Pw = mProjection[3][2];
         if (mProjection[2][3] != 0) {
@@ -754,6 +798,24 @@ static inline float2 project(mat4f const& p, float3 const& v) noexcept {
     return float2{ x, y } * (1 / w);
 }
 
+Froxelizer::FroxelRect Froxelizer::projectBox(mat4f const& p,
+        float2 const& lo, float2 const& hi, float znear, float zfar) const noexcept {
+    float2 xyLeftNear  = project(p, { lo, znear });
+    float2 xyLeftFar   = project(p, { lo, zfar  });
+    float2 xyRightNear = project(p, { hi, znear });
+    float2 xyRightFar  = project(p, { hi, zfar  });
+
+    // handle inverted frustums (e.g. x or y symmetries)
+    if (xyLeftNear.x > xyRightNear.x)   std::swap(xyLeftNear.x, xyRightNear.x);
+    if (xyLeftNear.y > xyRightNear.y)   std::swap(xyLeftNear.y, xyRightNear.y);
+    if (xyLeftFar.x  > xyRightFar.x)    std::swap(xyLeftFar.x, xyRightFar.x);
+    if (xyLeftFar.y  > xyRightFar.y)    std::swap(xyLeftFar.y, xyRightFar.y);
+
+    const auto imin = clipToIndices(min(xyLeftNear, xyLeftFar));
+    const auto imax = clipToIndices(max(xyRightNear, xyRightFar));
+    return { imin.first, imin.second, imax.first, imax.second };
+}
+
 void Froxelizer::froxelizePointAndSpotLight(
         FroxelThreadData& froxelThread, size_t bit,
         mat4f const& UTILS_RESTRICT p,
@@ -783,25 +845,15 @@ void Froxelizer::froxelizePointAndSpotLight(
     const float znear = std::min(-mNear, aabb.center.z + aabb.halfExtent.z); // z values are negative
     const float zfar  =                  aabb.center.z - aabb.halfExtent.z;
 
-    float2 xyLeftNear  = project(p, { aabb.center.xy - aabb.halfExtent.xy, znear });
-    float2 xyLeftFar   = project(p, { aabb.center.xy - aabb.halfExtent.xy, zfar  });
-    float2 xyRightNear = project(p, { aabb.center.xy + aabb.halfExtent.xy, znear });
-    float2 xyRightFar  = project(p, { aabb.center.xy + aabb.halfExtent.xy, zfar  });
-
-    // handle inverted frustums (e.g. x or y symmetries)
-    if (xyLeftNear.x > xyRightNear.x)   std::swap(xyLeftNear.x, xyRightNear.x);
-    if (xyLeftNear.y > xyRightNear.y)   std::swap(xyLeftNear.y, xyRightNear.y);
-    if (xyLeftFar.x  > xyRightFar.x)    std::swap(xyLeftFar.x, xyRightFar.x);
-    if (xyLeftFar.y  > xyRightFar.y)    std::swap(xyLeftFar.y, xyRightFar.y);
-
-    const auto imin = clipToIndices(min(xyLeftNear, xyLeftFar));
-    const size_t x0 = imin.first;
-    const size_t y0 = imin.second;
+    const FroxelRect rect = projectBox(p,
+            aabb.center.xy - aabb.halfExtent.xy, aabb.center.xy + aabb.halfExtent.xy,
+            znear, zfar);
+    const size_t x0 = rect.x0;
+    const size_t y0 = rect.y0;
     const size_t z0 = findSliceZ(znear);
 
-    const auto imax = clipToIndices(max(xyRightNear, xyRightFar));
-    const size_t x1 = imax.first  + 1;  // x1 points to 1 past the last value (like end() does
-    const size_t y1 = imax.second;      // y1 points to the last value
+    const size_t x1 = rect.x1 + 1;      // x1 points to 1 past the last value (like end() does
+    const size_t y1 = rect.y1;          // y1 points to the last value
     const size_t z1 = findSliceZ(zfar); // z1 points to the last value
 
     assert_invariant(x0 < x1);
@@ -814,6 +866,7 @@ void Froxelizer::froxelizePointAndSpotLight(
     float4 const * const UTILS_RESTRICT planesY = mPlanesY;
     float const * const UTILS_RESTRICT planesZ = mDistancesZ;
     float4 const * const UTILS_RESTRICT boundingSpheres = mBoundingSpheres;
+    float4 const * const UTILS_RESTRICT tileBoundingSpheres = mTileBoundingSpheres;
     for (size_t iz = z0 ; iz <= z1; ++iz) {
         float4 cz(s);
         // froxel that contain the center if ths sphere is special, we don't even need to do the
@@ -831,7 +884,27 @@ void Froxelizer::froxelizePointAndSpotLight(
             const size_t xcenter = indices.first;
             const size_t ycenter = indices.second;
 
-            for (size_t iy = y0; iy <= y1; ++iy) {
+            // Coarse pass: the part of the sphere within this slice is contained in the box
+            // of half-extent sqrt(cz.w) spanning the slice's depth, which is much tighter
+            // than the whole light's bounding-box for all but the center slice. This skips
+            // most of the empty froxels of large lights.
+            size_t sx0 = x0, sy0 = y0, sx1 = x1, sy1 = y1;
+#ifndef DEBUG_FROXEL
+            if (UTILS_LIKELY(iz != zcenter)) {
+                const float r = std::sqrt(cz.w);
+                const float sznear = std::min(-mNear, std::min(-planesZ[iz], znear));
+                // the last slice extends past mZLightFar
+                const float szfar  = (iz + 1 < mFroxelCountZ) ?
+                        std::max(-planesZ[iz + 1], zfar) : zfar;
+                const FroxelRect slice = projectBox(p, cz.xy - r, cz.xy + r, sznear, szfar);
+                sx0 = std::max(sx0, slice.x0);
+                sy0 = std::max(sy0, slice.y0);
+                sx1 = std::min(sx1, slice.x1 + 1);
+                sy1 = std::min(sy1, slice.y1);
+            }
+#endif
+
+            for (size_t iy = sy0; iy <= sy1; ++iy) {
                 float4 cy(cz);
                 // froxel that contain the center if ths sphere is special, we don't even need to
                 // do the intersection check, it's always true.
@@ -847,23 +920,17 @@ void Froxelizer::froxelizePointAndSpotLight(
                     size_t ex = 0; // horizontal end index
 
                     // find the begin index (left side)
-                    for (size_t ix = x0; ix < x1; ++ix) {
+                    // this loop is branch-less so it can be vectorized (8 froxels at a time w/ AVX)
+                    for (size_t ix = sx0; ix < sx1; ++ix) {
                         // The froxel that contains the center of the sphere is special,
                         // we don't even need to do the intersection check, it's always true.
-                        if (UTILS_LIKELY(ix != xcenter)) {
-                            float4 const& plane = ix < xcenter ? planesX[ix + 1] : planesX[ix];
-                            if (spherePlaneDistanceSquared(cy, plane.x, plane.z) > 0) {
-                                // The reduced sphere from the previous stage intersects this
-                                // vertical plane, we record the min/max froxel indices
-                                bx = std::min(bx, ix);
-                                ex = std::max(ex, ix);
-                            }
-                        } else {
-                            // this is the froxel containing the center of the sphere, it is
-                            // definitely participating
-                            bx = std::min(bx, ix);
-                            ex = std::max(ex, ix);
-                        }
+                        // Otherwise, if the reduced sphere from the previous stage intersects this
+                        // vertical plane, we record the min/max froxel indices.
+                        float4 const& plane = ix < xcenter ? planesX[ix + 1] : planesX[ix];
+                        const bool hit = (ix == xcenter) ||
+                                (spherePlaneDistanceSquared(cy, plane.x, plane.z) > 0);
+                        bx = hit ? std::min(bx, ix) : bx;
+                        ex = hit ? std::max(ex, ix) : ex;
                     }
 
                     if (UTILS_UNLIKELY(bx > ex)) {
@@ -877,12 +944,25 @@ void Froxelizer::froxelizePointAndSpotLight(
                     size_t fi = getFroxelIndex(bx, iy, iz);
                     if (light.invSin != std::numeric_limits<float>::infinity()) {
                         // This is a spotlight (common case)
-                        // this loops gets vectorized (on arm64) w/ clang
-                        while (bx++ != ex) {
-                            // see if this froxel intersects the cone
-                            bool intersect = sphereConeIntersectionFast(boundingSpheres[fi],
-                                    light.position, light.axis, light.invSin, light.cosSqr);
-                            froxelThread[fi++] |= LightGroupType(intersect) << bit;
+                        // The cone is first tested against the tile, the froxels of the tiles
+                        // it misses are skipped.
+                        float4 const* const tiles = tileBoundingSpheres + getTileIndex(0, iy, iz);
+                        while (bx != ex) {
+                            const size_t tx = bx / TILE_SIZE;
+                            const size_t tileEnd = std::min(ex, (tx + 1) * TILE_SIZE);
+                            if (!sphereConeIntersectionFast(tiles[tx],
+                                    light.position, light.axis, light.invSin, light.cosSqr)) {
+                                fi += tileEnd - bx;
+                                bx = tileEnd;
+                                continue;
+                            }
+                            // this loops gets vectorized (on arm64) w/ clang
+                            for (; bx != tileEnd; ++bx) {
+                                // see if this froxel intersects the cone
+                                bool intersect = sphereConeIntersectionFast(boundingSpheres[fi],
+                                        light.position, light.axis, light.invSin, light.cosSqr);
+                                froxelThread[fi++] |= LightGroupType(intersect) << bit;
+                            }
                         }
                     } else {
                         // this loops gets vectorized (on arm64) w/ clang
@@ -18,6 +18,7 @@
 #define TNT_FILAMENT_DETAILS_FROXELIZER_H
 
 #include "Allocators.h"
+#include "TypedUniformBuffer.h"
 
 #include "details/Scene.h"
 #include "details/Engine.h"
@@ -33,6 +34,9 @@
 #include <math/mat4.h>
 #include <math/vec4.h>
 
+// for gtest
+class FilamentTest_FroxelSpotLightTiles_Test;
+
 namespace filament {
 
 class FEngine;
@@ -123,10 +127,11 @@ public:
     void froxelizeLights(FEngine& engine, math::mat4f const& viewMatrix,
             const FScene::LightSoa& lightData) noexcept;
 
-    void updateUniforms(PerViewUib& s) {
-        s.zParams = mParamsZ;
-        s.fParams = mParamsF;
-        s.froxelCountXY = math::float2{ mViewport.width, mViewport.height } / mFroxelDimension;
+    void updateUniforms(TypedUniformBuffer<PerViewUib>& uniforms) {
+        uniforms.setUniform(&PerViewUib::zParams, mParamsZ);
+        uniforms.setUniform(&PerViewUib::fParams, mParamsF);
+        uniforms.setUniform(&PerViewUib::froxelCountXY,
+                math::float2{ mViewport.width, mViewport.height } / mFroxelDimension);
     }
 
     // send froxel data to GPU
@@ -158,6 +163,8 @@ public:
     using LightGroupType = uint32_t;
 
 private:
+    friend class ::FilamentTest_FroxelSpotLightTiles_Test;
+
     struct LightRecord {
         using bitset = utils::bitset<uint64_t, (CONFIG_MAX_LIGHT_COUNT + 63) / 64>;
         bitset lights;
@@ -207,10 +214,25 @@ private:
         return uint16_t(ix + (iy * mFroxelCountX) + (iz * mFroxelCountX * mFroxelCountY));
     }
 
+    // spotlights are first tested against tiles of TILE_SIZE x TILE_SIZE froxels of a slice
+    static constexpr size_t TILE_SIZE = 4;
+
+    // index of the tile containing the froxel ix, iy, iz
+    size_t getTileIndex(size_t ix, size_t iy, size_t iz) const noexcept {
+        return ix / TILE_SIZE + (iy / TILE_SIZE) * mTileCountX + iz * mTileCountX * mTileCountY;
+    }
+
     size_t findSliceZ(float viewSpaceZ) const noexcept UTILS_PURE;
 
     std::pair<size_t, size_t> clipToIndices(math::float2 const& clip) const noexcept;
 
+    // froxel x/y indices covered by a view-space box, all bounds are inclusive
+    struct FroxelRect {
+        size_t x0, y0, x1, y1;
+    };
+    FroxelRect projectBox(math::mat4f const& p, math::float2 const& lo, math::float2 const& hi,
+            float znear, float zfar) const noexcept;
+
     static void computeFroxelLayout(
             math::uint2* dim, uint16_t* countX, uint16_t* countY, uint16_t* countZ,
             Viewport const& viewport) noexcept;
@@ -222,6 +244,7 @@ private:
     math::float4* mPlanesX = nullptr;
     math::float4* mPlanesY = nullptr;
     math::float4* mBoundingSpheres = nullptr;
+    math::float4* mTileBoundingSpheres = nullptr;
 
     utils::Slice<FroxelThreadData> mFroxelShardedData;  // 256 KiB w/  256 lights
     utils::Slice<FroxelEntry> mFroxelBufferUser;        //  32 KiB w/ 8192 froxels
@@ -234,6 +257,8 @@ private:
     uint16_t mFroxelCountY = 0;
     uint16_t mFroxelCountZ = 0;
     uint16_t mFroxelCount = 0;
+    uint16_t mTileCountX = 0;
+    uint16_t mTileCountY = 0;
     math::uint2 mFroxelDimension = {};
 
     math::mat4f mProjection;
@@ -73,60 +73,54 @@ void PerViewUniforms::prepareCamera(const CameraInfo& camera) noexcept {
     const mat4f clipFromWorld{ highPrecisionMultiply(clipFromView, viewFromWorld) };
     const mat4f worldFromClip{ highPrecisionMultiply(worldFromView, viewFromClip) };
 
-    auto& s = mUniforms.edit();
-    s.viewFromWorldMatrix = viewFromWorld;    // view
-    s.worldFromViewMatrix = worldFromView;    // model
-    s.clipFromViewMatrix  = clipFromView;     // projection
-    s.viewFromClipMatrix  = viewFromClip;     // 1/projection
-    s.clipFromWorldMatrix = clipFromWorld;    // projection * view
-    s.worldFromClipMatrix = worldFromClip;    // 1/(projection * view)
-    s.cameraPosition = float3{ camera.getPosition() };
-    s.worldOffset = camera.getWorldOffset();
-    s.cameraFar = camera.zf;
-    s.oneOverFarMinusNear = 1.0f / (camera.zf - camera.zn);
-    s.nearOverFarMinusNear = camera.zn / (camera.zf - camera.zn);
-    s.clipControl = mClipControl;
+    mUniforms.setUniform(&PerViewUib::viewFromWorldMatrix, viewFromWorld);  // view
+    mUniforms.setUniform(&PerViewUib::worldFromViewMatrix, worldFromView);  // model
+    mUniforms.setUniform(&PerViewUib::clipFromViewMatrix,  clipFromView);   // projection
+    mUniforms.setUniform(&PerViewUib::viewFromClipMatrix,  viewFromClip);   // 1/projection
+    mUniforms.setUniform(&PerViewUib::clipFromWorldMatrix, clipFromWorld);  // projection * view
+    mUniforms.setUniform(&PerViewUib::worldFromClipMatrix, worldFromClip);  // 1/(projection * view)
+    mUniforms.setUniform(&PerViewUib::cameraPosition, float3{ camera.getPosition() });
+    mUniforms.setUniform(&PerViewUib::worldOffset, camera.getWorldOffset());
+    mUniforms.setUniform(&PerViewUib::cameraFar, camera.zf);
+    mUniforms.setUniform(&PerViewUib::oneOverFarMinusNear, 1.0f / (camera.zf - camera.zn));
+    mUniforms.setUniform(&PerViewUib::nearOverFarMinusNear, camera.zn / (camera.zf - camera.zn));
+    mUniforms.setUniform(&PerViewUib::clipControl, mClipControl);
 }
 
 void PerViewUniforms::prepareUpscaler(math::float2 scale,
         DynamicResolutionOptions const& options) noexcept {
-    auto& s = mUniforms.edit();
     if (options.quality >= QualityLevel::HIGH) {
-        s.lodBias = std::log2(std::min(scale.x, scale.y));
+        mUniforms.setUniform(&PerViewUib::lodBias, std::log2(std::min(scale.x, scale.y)));
     } else {
-        s.lodBias = 0.0f;
+        mUniforms.setUniform(&PerViewUib::lodBias, 0.0f);
     }
 }
 
 void PerViewUniforms::prepareExposure(float ev100) noexcept {
     const float exposure = Exposure::exposure(ev100);
-    auto& s = mUniforms.edit();
-    s.exposure = exposure;
-    s.ev100 = ev100;
+    mUniforms.setUniform(&PerViewUib::exposure, exposure);
+    mUniforms.setUniform(&PerViewUib::ev100, ev100);
 }
 
 void PerViewUniforms::prepareViewport(const filament::Viewport& viewport,
         uint32_t xoffset, uint32_t yoffset) noexcept {
     const float w = float(viewport.width);
     const float h = float(viewport.height);
-    auto& s = mUniforms.edit();
-    s.resolution = float4{ w, h, 1.0f / w, 1.0f / h };
-    s.origin = float2{ viewport.left, viewport.bottom };
-    s.offset = float2{ xoffset, yoffset };
+    mUniforms.setUniform(&PerViewUib::resolution, float4{ w, h, 1.0f / w, 1.0f / h });
+    mUniforms.setUniform(&PerViewUib::origin, float2{ viewport.left, viewport.bottom });
+    mUniforms.setUniform(&PerViewUib::offset, float2{ xoffset, yoffset });
 }
 
 void PerViewUniforms::prepareTime(math::float4 const& userTime) noexcept {
-    auto& s = mUniforms.edit();
     const uint64_t oneSecondRemainder = mEngine.getEngineTime().count() % 1000000000;
     const float fraction = float(double(oneSecondRemainder) / 1000000000.0);
-    s.time = fraction;
-    s.userTime = userTime;
+    mUniforms.setUniform(&PerViewUib::time, fraction);
+    mUniforms.setUniform(&PerViewUib::userTime, userTime);
 }
 
 void PerViewUniforms::prepareTemporalNoise(TemporalAntiAliasingOptions const& options) noexcept {
-    auto& s = mUniforms.edit();
     const float temporalNoise = mUniformDistribution(mEngine.getRandomEngine());
-    s.temporalNoise = options.enabled ? temporalNoise : 0.0f;
+    mUniforms.setUniform(&PerViewUib::temporalNoise, options.enabled ? temporalNoise : 0.0f);
 }
 
 void PerViewUniforms::prepareFog(float3 const& cameraPosition, FogOptions const& options) noexcept {
@@ -140,24 +134,24 @@ void PerViewUniforms::prepareFog(float3 const& cameraPosition, FogOptions const&
             std::exp(-heightFalloff * (cameraPosition.y - options.height)))
                     * float(1.0f / F_LN2);
 
-    auto& s = mUniforms.edit();
-    s.fogStart             = options.distance;
-    s.fogMaxOpacity        = options.maximumOpacity;
-    s.fogHeight            = options.height;
-    s.fogHeightFalloff     = heightFalloff;
-    s.fogColor             = options.color;
-    s.fogDensity           = density;
-    s.fogInscatteringStart = options.inScatteringStart;
-    s.fogInscatteringSize  = options.inScatteringSize;
-    s.fogColorFromIbl      = options.fogColorFromIbl ? 1.0f : 0.0f;
+    mUniforms.setUniform(&PerViewUib::fogStart, options.distance);
+    mUniforms.setUniform(&PerViewUib::fogMaxOpacity, options.maximumOpacity);
+    mUniforms.setUniform(&PerViewUib::fogHeight, options.height);
+    mUniforms.setUniform(&PerViewUib::fogHeightFalloff, heightFalloff);
+    mUniforms.setUniform(&PerViewUib::fogColor, options.color);
+    mUniforms.setUniform(&PerViewUib::fogDensity, density);
+    mUniforms.setUniform(&PerViewUib::fogInscatteringStart, options.inScatteringStart);
+    mUniforms.setUniform(&PerViewUib::fogInscatteringSize, options.inScatteringSize);
+    mUniforms.setUniform(&PerViewUib::fogColorFromIbl, options.fogColorFromIbl ? 1.0f : 0.0f);
 }
 
 void PerViewUniforms::prepareSSAO(Handle<HwTexture> ssao,
         AmbientOcclusionOptions const& options) noexcept {
     // High quality sampling is enabled only if AO itself is enabled and upsampling quality is at
-    // least set to high and of course only if upsampling is needed.
-    const bool highQualitySampling = options.upsampling >= QualityLevel::HIGH
-            && options.resolution < 1.0f;
+    // least set to high (or AO is at quarter resolution) and of course only if upsampling is
+    // needed. This must match PostProcessManager::screenSpaceAmbientOcclusion().
+    const bool highQualitySampling = options.resolution < 1.0f &&
+            (options.upsampling >= QualityLevel::HIGH || options.resolution < 0.5f);
 
     // LINEAR filtering is only needed when AO is enabled and low-quality upsampling is used.
     mSamplers.setSampler(PerViewSib::SSAO, ssao, {
@@ -166,14 +160,14 @@ void PerViewUniforms::prepareSSAO(Handle<HwTexture> ssao,
     });
 
     const float edgeDistance = 1.0f / options.bilateralThreshold;
-    auto& s = mUniforms.edit();
-    s.aoSamplingQualityAndEdgeDistance =
-            options.enabled && highQualitySampling ? edgeDistance : 0.0f;
-    s.aoBentNormals = options.enabled && options.bentNormals ? 1.0f : 0.0f;
+    mUniforms.setUniform(&PerViewUib::aoSamplingQualityAndEdgeDistance,
+            options.enabled && highQualitySampling ? edgeDistance : 0.0f);
+    mUniforms.setUniform(&PerViewUib::aoBentNormals,
+            options.enabled && options.bentNormals ? 1.0f : 0.0f);
 }
 
 void PerViewUniforms::prepareBlending(bool needsAlphaChannel) noexcept {
-    mUniforms.edit().needsAlphaChannel = needsAlphaChannel ? 1.0f : 0.0f;
+    mUniforms.setUniform(&PerViewUib::needsAlphaChannel, needsAlphaChannel ? 1.0f : 0.0f);
 }
 
 void PerViewUniforms::prepareSSR(Handle<HwTexture> ssr,
@@ -185,9 +179,9 @@ void PerViewUniforms::prepareSSR(Handle<HwTexture> ssr,
         .filterMin = SamplerMinFilter::LINEAR_MIPMAP_LINEAR
     });
 
-    auto& s = mUniforms.edit();
-    s.refractionLodOffset = refractionLodOffset;
-    s.ssrDistance = ssrOptions.enabled ? ssrOptions.maxDistance : 0.0f;
+    mUniforms.setUniform(&PerViewUib::refractionLodOffset, refractionLodOffset);
+    mUniforms.setUniform(&PerViewUib::ssrDistance,
+            ssrOptions.enabled ? ssrOptions.maxDistance : 0.0f);
 }
 
 void PerViewUniforms::prepareHistorySSR(Handle<HwTexture> ssr,
@@ -200,13 +194,13 @@ void PerViewUniforms::prepareHistorySSR(Handle<HwTexture> ssr,
         .filterMin = SamplerMinFilter::LINEAR
     });
 
-    auto& s = mUniforms.edit();
-    s.ssrReprojection = historyProjection;
-    s.ssrUvFromViewMatrix = uvFromViewMatrix;
-    s.ssrThickness = ssrOptions.thickness;
-    s.ssrBias = ssrOptions.bias;
-    s.ssrDistance = ssrOptions.enabled ? ssrOptions.maxDistance : 0.0f;
-    s.ssrStride = ssrOptions.stride;
+    mUniforms.setUniform(&PerViewUib::ssrReprojection, historyProjection);
+    mUniforms.setUniform(&PerViewUib::ssrUvFromViewMatrix, uvFromViewMatrix);
+    mUniforms.setUniform(&PerViewUib::ssrThickness, ssrOptions.thickness);
+    mUniforms.setUniform(&PerViewUib::ssrBias, ssrOptions.bias);
+    mUniforms.setUniform(&PerViewUib::ssrDistance,
+            ssrOptions.enabled ? ssrOptions.maxDistance : 0.0f);
+    mUniforms.setUniform(&PerViewUib::ssrStride, ssrOptions.stride);
 }
 
 void PerViewUniforms::prepareStructure(Handle<HwTexture> structure) noexcept {
@@ -219,7 +213,6 @@ void PerViewUniforms::prepareDirectionalLight(
         float3 const& sceneSpaceDirection,
         PerViewUniforms::LightManagerInstance directionalLight) noexcept {
     FLightManager& lcm = mEngine.getLightManager();
-    auto& s = mUniforms.edit();
 
     const float3 l = -sceneSpaceDirection; // guaranteed normalized
 
@@ -227,9 +220,9 @@ void PerViewUniforms::prepareDirectionalLight(
         const float4 colorIntensity = {
                 lcm.getColor(directionalLight), lcm.getIntensity(directionalLight) * exposure };
 
-        s.lightDirection = l;
-        s.lightColorIntensity = colorIntensity;
-        s.lightChannels = lcm.getLightChannels(directionalLight);
+        mUniforms.setUniform(&PerViewUib::lightDirection, l);
+        mUniforms.setUniform(&PerViewUib::lightColorIntensity, colorIntensity);
+        mUniforms.setUniform(&PerViewUib::lightChannels, lcm.getLightChannels(directionalLight));
 
         const bool isSun = lcm.isSunLight(directionalLight);
         // The last parameter must be < 0.0f for regular directional lights
@@ -245,25 +238,23 @@ void PerViewUniforms::prepareDirectionalLight(
             sun.z = 1.0f / (std::cos(radius * haloSize) - sun.x);
             sun.w = haloFalloff;
         }
-        s.sun = sun;
+        mUniforms.setUniform(&PerViewUib::sun, sun);
     } else {
         // Disable the sun if there's no directional light
-        s.sun = float4{ 0.0f, 0.0f, 0.0f, -1.0f };
+        mUniforms.setUniform(&PerViewUib::sun, float4{ 0.0f, 0.0f, 0.0f, -1.0f });
     }
 }
 
 void PerViewUniforms::prepareAmbientLight(FIndirectLight const& ibl,
         float intensity, float exposure) noexcept {
     auto& engine = mEngine;
-    auto& s = mUniforms.edit();
 
     // Set up uniforms and sampler for the IBL, guaranteed to be non-null at this point.
     float iblRoughnessOneLevel = ibl.getLevelCount() - 1.0f;
-    s.iblRoughnessOneLevel = iblRoughnessOneLevel;
-    s.iblLuminance = intensity * exposure;
-    std::transform(ibl.getSH(), ibl.getSH() + 9, s.iblSH, [](float3 v) {
-        return float4(v, 0.0f);
-    });
+    mUniforms.setUniform(&PerViewUib::iblRoughnessOneLevel, iblRoughnessOneLevel);
+    mUniforms.setUniform(&PerViewUib::iblLuminance, intensity * exposure);
+    std::transform(ibl.getSH(), ibl.getSH() + 9, mUniforms.editUniform(&PerViewUib::iblSH),
+            [](float3 v) { return float4(v, 0.0f); });
 
     // We always sample from the reflection texture, so provide a dummy texture if necessary.
     Handle<HwTexture> reflection = ibl.getReflectionHwHandle();
@@ -278,27 +269,28 @@ void PerViewUniforms::prepareAmbientLight(FIndirectLight const& ibl,
 }
 
 void PerViewUniforms::prepareDynamicLights(Froxelizer& froxelizer) noexcept {
-    auto& s = mUniforms.edit();
-    froxelizer.updateUniforms(s);
+    froxelizer.updateUniforms(mUniforms);
     float f = froxelizer.getLightFar();
     mSamplers.setSampler(PerViewSib::FROXELS, { froxelizer.getFroxelTexture() });
-    s.lightFarAttenuationParams = 0.5f * float2{ 10.0f, 10.0f / (f * f) };
+    mUniforms.setUniform(&PerViewUib::lightFarAttenuationParams,
+            0.5f * float2{ 10.0f, 10.0f / (f * f) });
 }
 
 void PerViewUniforms::prepareShadowMapping() noexcept {
-    auto& s = mUniforms.edit();
-    s.vsmExponent = 5.54f;  // fp16: max 5.54f, fp32: max 42.0
+    mUniforms.setUniform(&PerViewUib::vsmExponent, 5.54f);  // fp16: max 5.54f, fp32: max 42.0
 }
 
-void PerViewUniforms::prepareShadowSampling(PerViewUib& uniforms,
+void PerViewUniforms::prepareShadowSampling(TypedUniformBuffer<PerViewUib>& uniforms,
         ShadowMappingUniforms const& shadowMappingUniforms) noexcept {
-    uniforms.lightFromWorldMatrix       = shadowMappingUniforms.lightFromWorldMatrix;
-    uniforms.cascadeSplits              = shadowMappingUniforms.cascadeSplits;
-    uniforms.shadowBulbRadiusLs         = shadowMappingUniforms.shadowBulbRadiusLs;
-    uniforms.shadowBias                 = shadowMappingUniforms.shadowBias;
-    uniforms.ssContactShadowDistance    = shadowMappingUniforms.ssContactShadowDistance;
-    uniforms.directionalShadows         = shadowMappingUniforms.directionalShadows;
-    uniforms.cascades                   = shadowMappingUniforms.cascades;
+    uniforms.setUniform(&PerViewUib::lightFromWorldMatrix,
+            shadowMappingUniforms.lightFromWorldMatrix);
+    uniforms.setUniform(&PerViewUib::cascadeSplits, shadowMappingUniforms.cascadeSplits);
+    uniforms.setUniform(&PerViewUib::shadowBulbRadiusLs, shadowMappingUniforms.shadowBulbRadiusLs);
+    uniforms.setUniform(&PerViewUib::shadowBias, shadowMappingUniforms.shadowBias);
+    uniforms.setUniform(&PerViewUib::ssContactShadowDistance,
+            shadowMappingUniforms.ssContactShadowDistance);
+    uniforms.setUniform(&PerViewUib::directionalShadows, shadowMappingUniforms.directionalShadows);
+    uniforms.setUniform(&PerViewUib::cascades, shadowMappingUniforms.cascades);
 }
 
 void PerViewUniforms::prepareShadowVSM(Handle<HwTexture> texture,
@@ -314,12 +306,13 @@ void PerViewUniforms::prepareShadowVSM(Handle<HwTexture> texture,
                     .filterMin = filterMin,
                     .anisotropyLog2 = options.anisotropy,
             }});
-    auto& s = mUniforms.edit();
-    s.shadowSamplingType = SHADOW_SAMPLING_RUNTIME_VSM;
-    s.vsmExponent = 5.54f;  // fp16: max 5.54f, fp32: max 42.0
-    s.vsmDepthScale = options.minVarianceScale * 0.01f * s.vsmExponent;
-    s.vsmLightBleedReduction = options.lightBleedReduction;
-    PerViewUniforms::prepareShadowSampling(s, shadowMappingUniforms);
+    mUniforms.setUniform(&PerViewUib::shadowSamplingType, SHADOW_SAMPLING_RUNTIME_VSM);
+    const float vsmExponent = 5.54f;  // fp16: max 5.54f, fp32: max 42.0
+    mUniforms.setUniform(&PerViewUib::vsmExponent, vsmExponent);
+    mUniforms.setUniform(&PerViewUib::vsmDepthScale,
+            options.minVarianceScale * 0.01f * vsmExponent);
+    mUniforms.setUniform(&PerViewUib::vsmLightBleedReduction, options.lightBleedReduction);
+    PerViewUniforms::prepareShadowSampling(mUniforms, shadowMappingUniforms);
 }
 
 void PerViewUniforms::prepareShadowPCF(Handle<HwTexture> texture,
@@ -331,34 +324,31 @@ void PerViewUniforms::prepareShadowPCF(Handle<HwTexture> texture,
                     .compareMode = SamplerCompareMode::COMPARE_TO_TEXTURE,
                     .compareFunc = SamplerCompareFunc::GE
             }});
-    auto& s = mUniforms.edit();
-    s.shadowSamplingType = SHADOW_SAMPLING_RUNTIME_PCF;
-    PerViewUniforms::prepareShadowSampling(s, shadowMappingUniforms);
+    mUniforms.setUniform(&PerViewUib::shadowSamplingType, SHADOW_SAMPLING_RUNTIME_PCF);
+    PerViewUniforms::prepareShadowSampling(mUniforms, shadowMappingUniforms);
 }
 
 void PerViewUniforms::prepareShadowDPCF(Handle<HwTexture> texture,
         ShadowMappingUniforms const& shadowMappingUniforms,
         SoftShadowOptions const& options) noexcept {
     mSamplers.setSampler(PerViewSib::SHADOW_MAP, { texture, {}});
-    auto& s = mUniforms.edit();
-    s.shadowSamplingType = SHADOW_SAMPLING_RUNTIME_DPCF;
-    s.shadowPenumbraRatioScale = options.penumbraRatioScale;
-    PerViewUniforms::prepareShadowSampling(s, shadowMappingUniforms);
+    mUniforms.setUniform(&PerViewUib::shadowSamplingType, SHADOW_SAMPLING_RUNTIME_DPCF);
+    mUniforms.setUniform(&PerViewUib::shadowPenumbraRatioScale, options.penumbraRatioScale);
+    PerViewUniforms::prepareShadowSampling(mUniforms, shadowMappingUniforms);
 }
 
 void PerViewUniforms::prepareShadowPCSS(Handle<HwTexture> texture,
         ShadowMappingUniforms const& shadowMappingUniforms,
         SoftShadowOptions const& options) noexcept {
     mSamplers.setSampler(PerViewSib::SHADOW_MAP, { texture, {}});
-    auto& s = mUniforms.edit();
-    s.shadowSamplingType = SHADOW_SAMPLING_RUNTIME_PCSS;
-    s.shadowPenumbraRatioScale = options.penumbraRatioScale;
-    PerViewUniforms::prepareShadowSampling(s, shadowMappingUniforms);
+    mUniforms.setUniform(&PerViewUib::shadowSamplingType, SHADOW_SAMPLING_RUNTIME_PCSS);
+    mUniforms.setUniform(&PerViewUib::shadowPenumbraRatioScale, options.penumbraRatioScale);
+    PerViewUniforms::prepareShadowSampling(mUniforms, shadowMappingUniforms);
 }
 
 void PerViewUniforms::commit(backend::DriverApi& driver) noexcept {
     if (mUniforms.isDirty()) {
-        driver.updateBufferObject(mUniformBufferHandle, mUniforms.toBufferDescriptor(driver), 0);
+        mUniforms.commit(driver, mUniformBufferHandle);
     }
     if (mSamplers.isDirty()) {
         driver.updateSamplerGroup(mSamplerGroupHandle, std::move(mSamplers.toCommandStream()));
@@ -133,7 +133,7 @@ private:
     backend::Handle<backend::HwBufferObject> mUniformBufferHandle;
     backend::Handle<backend::HwSamplerGroup> mSamplerGroupHandle;
     std::uniform_real_distribution<float> mUniformDistribution{ 0.0f, 1.0f };
-    static void prepareShadowSampling(PerViewUib& uniforms,
+    static void prepareShadowSampling(TypedUniformBuffer<PerViewUib>& uniforms,
             ShadowMappingUniforms const& shadowMappingUniforms) noexcept;
 };
 
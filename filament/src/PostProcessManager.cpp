@@ -212,6 +212,7 @@ static const MaterialInfo sMaterialList[] = {
         { "bloomUpsample",              MATERIAL(BLOOMUPSAMPLE) },
         { "colorGrading",               MATERIAL(COLORGRADING) },
         { "colorGradingAsSubpass",      MATERIAL(COLORGRADINGASSUBPASS) },
+        { "colorGradingBake",           MATERIAL(COLORGRADINGBAKE) },
         { "customResolveAsSubpass",     MATERIAL(CUSTOMRESOLVEASSUBPASS) },
         { "dof",                        MATERIAL(DOF) },
         { "dofCoc",                     MATERIAL(DOFCOC) },
@@ -222,6 +223,7 @@ static const MaterialInfo sMaterialList[] = {
         { "dofMipmap",                  MATERIAL(DOFMIPMAP) },
         { "dofTiles",                   MATERIAL(DOFTILES) },
         { "dofTilesSwizzle",            MATERIAL(DOFTILESSWIZZLE) },
+        { "dofTilesMask",               MATERIAL(DOFTILESMASK) },
         { "flare",                      MATERIAL(FLARE) },
         { "fxaa",                       MATERIAL(FXAA) },
         { "mipmapDepth",                MATERIAL(MIPMAPDEPTH) },
@@ -307,6 +309,162 @@ void PostProcessManager::terminate(DriverApi& driver) noexcept {
     }
 }
 
+void PostProcessManager::prepare(PrepareConfig const& config) noexcept {
+    const Variant::type_t variant = Variant::type_t(config.translucent ?
+            PostProcessVariant::TRANSLUCENT : PostProcessVariant::OPAQUE);
+
+    // Materials are parsed the first time they're used and their programs are created the first
+    // time a variant is used. Doing it here, before the FrameGraph is built, gives the backend
+    // more time to compile the programs and keeps the pass execution down to recording
+    // commands. Only the variants used by the effects are prepared.
+    auto prepareMaterial = [this](StaticString name, Variant::type_t key = 0) {
+        FMaterial const* const material = getPostProcessMaterial(name).getMaterial(mEngine);
+        material->prepareProgram(Variant{ key });
+    };
+
+    if (config.vsm) {
+        // the blur is set per light, we don't know here whether it's used
+        prepareMaterial(getGaussianBlurMaterialName(TextureFormat::RG16F, true));
+        if (config.vsmMipmap) {
+            prepareMaterial("vsmMipmap");
+        }
+    }
+    if (config.ssao || config.ssr || config.contactShadows) {
+        prepareMaterial("mipmapDepth");
+    }
+    if (config.ssao) {
+        prepareMaterial(getSsaoMaterialName(config.ssaoBentNormals));
+        prepareMaterial(getBilateralBlurMaterialName(config.ssaoBentNormals));
+    }
+    if (config.ssr || config.refraction) {
+        // mipmaps of the reflection/refraction buffer, see prepareMipmapSSR()
+        prepareMaterial(getGaussianBlurMaterialName(config.ssr ?
+                TextureFormat::RGBA16F : TextureFormat::R11F_G11F_B10F, false));
+    }
+    if (config.taa) {
+        prepareMaterial("taa", variant);
+    }
+    if (config.dof) {
+        prepareMaterial(getDofDownsampleMaterialName(config.dofOptions.nativeResolution));
+        prepareMaterial("dofMipmap", variant);
+        if (!Texture::isTextureSwizzleSupported(mEngine)) {
+            prepareMaterial("dofTilesSwizzle");
+        }
+        prepareMaterial("dofTiles");
+        prepareMaterial("dofDilate");
+        prepareMaterial("dofTilesMask");
+        prepareMaterial("dof");
+        if (config.dofOptions.filter != DepthOfFieldOptions::Filter::NONE) {
+            prepareMaterial("dofMedian");
+        }
+        prepareMaterial("dofCombine");
+    }
+    if (config.bloom) {
+        prepareMaterial("bloomDownsample");
+        prepareMaterial("bloomUpsample");
+        if (config.flare) {
+            prepareMaterial("flare");
+            prepareMaterial(getGaussianBlurMaterialName(TextureFormat::R11F_G11F_B10F, false));
+        }
+    }
+    if (config.colorGradingBake) {
+        prepareMaterial("colorGradingBake");
+    }
+    if (config.colorGradingAsSubpass) {
+        // both variants are needed, see colorGradingPrepareSubpass()
+        prepareMaterial("colorGradingAsSubpass",
+                Variant::type_t(PostProcessVariant::OPAQUE));
+        prepareMaterial("colorGradingAsSubpass",
+                Variant::type_t(PostProcessVariant::TRANSLUCENT));
+    } else if (config.colorGrading) {
+        prepareMaterial("colorGrading", variant);
+    }
+    if (config.customResolve) {
+        prepareMaterial("customResolveAsSubpass");
+    }
+    if (config.fxaa) {
+        // fxaa() blends when there is no color grading, see FRenderer::renderJob()
+        prepareMaterial("fxaa", Variant::type_t(config.translucent || !config.colorGrading ?
+                PostProcessVariant::TRANSLUCENT : PostProcessVariant::OPAQUE));
+    }
+    // without upscaling, a blended view is composited with blit(), which uses the low quality
+    // upscaler
+    UpscaleConfig const upscaleConfig = getUpscaleConfig(config.blending, config.upscale ?
+            config.dsrOptions : DynamicResolutionOptions{ .quality = QualityLevel::LOW });
+    if ((config.upscale || config.blending) && !upscaleConfig.opaqueBlit) {
+        if (upscaleConfig.twoPassesEASU) {
+            prepareMaterial("fsr_easu_mobileF");
+        }
+        prepareMaterial(upscaleConfig.blitter);
+        if (upscaleConfig.rcas) {
+            prepareMaterial("fsr_rcas", Variant::type_t(config.blending ?
+                    PostProcessVariant::TRANSLUCENT : PostProcessVariant::OPAQUE));
+        }
+    }
+}
+
+StaticString PostProcessManager::getSsaoMaterialName(bool bentNormals) noexcept {
+    if (bentNormals) {
+        return "saoBentNormals";
+    }
+    return "sao";
+}
+
+StaticString PostProcessManager::getBilateralBlurMaterialName(bool bentNormals) noexcept {
+    if (bentNormals) {
+        return "bilateralBlurBentNormals";
+    }
+    return "bilateralBlur";
+}
+
+StaticString PostProcessManager::getDofDownsampleMaterialName(bool nativeResolution) noexcept {
+    if (nativeResolution) {
+        return "dofCoc";
+    }
+    return "dofDownsample";
+}
+
+StaticString PostProcessManager::getGaussianBlurMaterialName(
+        TextureFormat format, bool is2dArray) noexcept {
+    switch (backend::getFormatSize(format)) {
+        case 1: return is2dArray ?
+                StaticString("separableGaussianBlur1L") : StaticString("separableGaussianBlur1");
+        case 2: return is2dArray ?
+                StaticString("separableGaussianBlur2L") : StaticString("separableGaussianBlur2");
+        case 3: return is2dArray ?
+                StaticString("separableGaussianBlur3L") : StaticString("separableGaussianBlur3");
+        default: return is2dArray ?
+                StaticString("separableGaussianBlur4L") : StaticString("separableGaussianBlur4");
+    }
+}
+
+PostProcessManager::UpscaleConfig PostProcessManager::getUpscaleConfig(bool translucent,
+        DynamicResolutionOptions dsrOptions) const noexcept {
+    UpscaleConfig config{};
+    config.opaqueBlit = !translucent && dsrOptions.quality == QualityLevel::LOW;
+
+    const bool lowQualityFallback = translucent && dsrOptions.quality != QualityLevel::LOW;
+    if (lowQualityFallback) {
+        // FidelityFX-FSR doesn't support the alpha channel currently
+        dsrOptions.quality = QualityLevel::LOW;
+    }
+
+    config.twoPassesEASU = mWorkaroundSplitEasu &&
+            (dsrOptions.quality == QualityLevel::MEDIUM
+                || dsrOptions.quality == QualityLevel::HIGH);
+
+    const StaticString blitterNames[4] = {
+            "blitLow", "fsr_easu_mobile", "fsr_easu_mobile", "fsr_easu" };
+    config.blitter = blitterNames[std::min(3u, (unsigned)dsrOptions.quality)];
+
+    // if we had to take the low quality fallback, we still do the "sharpen pass"
+    config.rcas = dsrOptions.sharpness > 0.0f &&
+            (dsrOptions.quality != QualityLevel::LOW || lowQualityFallback);
+
+    config.dsrOptions = dsrOptions;
+    return config;
+}
+
 backend::Handle<backend::HwTexture> PostProcessManager::getOneTexture() const {
     return mEngine.getOneTexture();
 }
@@ -654,8 +812,9 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::screenSpaceAmbientOcclusion(
 
     const bool computeBentNormals = options.bentNormals;
 
-    const bool highQualityUpsampling =
-            options.upsampling >= QualityLevel::HIGH && options.resolution < 1.0f;
+    // at quarter resolution, the depth-aware upsampling is always used
+    const bool highQualityUpsampling = options.resolution < 1.0f &&
+            (options.upsampling >= QualityLevel::HIGH || options.resolution < 0.5f);
 
     const bool lowPassFilterEnabled = options.lowPassFilter != QualityLevel::LOW;
 
@@ -770,9 +929,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::screenSpaceAmbientOcclusion(
                         0.0, 0.0, 0.0, 1.0
                 }};
 
-                auto& material = computeBentNormals ?
-                            getPostProcessMaterial("saoBentNormals") :
-                            getPostProcessMaterial("sao");
+                auto& material = getPostProcessMaterial(getSsaoMaterialName(computeBentNormals));
 
                 FMaterialInstance* const mi = material.getMaterialInstance(mEngine);
                 mi->setParameter("depth", depth, {
@@ -923,9 +1080,8 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::bilateralBlurPass(FrameGraph
                 uint32_t kGaussianCount = gaussianKernel(kGaussianSamples,
                         config.kernelSize, config.standardDeviation);
 
-                auto& material = config.bentNormals ?
-                        getPostProcessMaterial("bilateralBlurBentNormals") :
-                        getPostProcessMaterial("bilateralBlur");
+                auto& material = getPostProcessMaterial(
+                        getBilateralBlurMaterialName(config.bentNormals));
                 FMaterialInstance* const mi = material.getMaterialInstance(mEngine);
                 mi->setParameter("ssao", ssao, { /* only reads level 0 */ });
                 mi->setParameter("axis", axis / float2{desc.width, desc.height});
@@ -1070,27 +1226,8 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::gaussianBlurPass(FrameGraph&
                 FGTD const& outDesc = resources.getDescriptor(data.out);
                 FGTD const& tempDesc = resources.getDescriptor(data.temp);
 
-                utils::StaticString materialName;
-                const bool is2dArray = inDesc.type == SamplerType::SAMPLER_2D_ARRAY;
-                switch (backend::getFormatSize(outDesc.format)) {
-                    case 1: materialName  = is2dArray ?
-                            utils::StaticString("separableGaussianBlur1L") :
-                            utils::StaticString("separableGaussianBlur1");
-                            break;
-                    case 2: materialName  = is2dArray ?
-                            utils::StaticString("separableGaussianBlur2L") :
-                            utils::StaticString("separableGaussianBlur2");
-                            break;
-                    case 3: materialName  = is2dArray ?
-                            utils::StaticString("separableGaussianBlur3L") :
-                            utils::StaticString("separableGaussianBlur3");
-                            break;
-                    default: materialName = is2dArray ?
-                            utils::StaticString("separableGaussianBlur4L") :
-                            utils::StaticString("separableGaussianBlur4");
-                            break;
-                }
-
+                const utils::StaticString materialName = getGaussianBlurMaterialName(
+                        outDesc.format, inDesc.type == SamplerType::SAMPLER_2D_ARRAY);
                 auto const& separableGaussianBlur = getPostProcessMaterial(materialName);
                 FMaterialInstance* const mi = separableGaussianBlur.getMaterialInstance(mEngine);
                 const size_t kernelStorageSize = mi->getMaterial()->reflect("kernel")->size;
@@ -1516,9 +1653,8 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                 auto const& out = resources.getRenderPassInfo();
                 auto color = resources.getTexture(data.color);
                 auto depth = resources.getTexture(data.depth);
-                auto const& material = (dofResolution == 1) ?
-                        getPostProcessMaterial("dofCoc") :
-                        getPostProcessMaterial("dofDownsample");
+                auto const& material = getPostProcessMaterial(
+                        getDofDownsampleMaterialName(dofResolution == 1));
                 FMaterialInstance* const mi = material.getMaterialInstance(mEngine);
                 mi->setParameter("color", color, { .filterMin = SamplerMinFilter::NEAREST });
                 mi->setParameter("depth", depth, { .filterMin = SamplerMinFilter::NEAREST });
@@ -1692,6 +1828,10 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
 
     /*
      * DoF blur pass
+     *
+     * In-focus (trivial) tiles are resolved first by a cheap pass which also marks the tiles that
+     * need to be blurred in a depth buffer. The DoF pass (and the median pass below) then use the
+     * depth test to skip the in-focus tiles entirely, instead of early-exiting in the shader.
      */
 
     struct PostProcessDof {
@@ -1700,6 +1840,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
         FrameGraphId<FrameGraphTexture> tilesCocMinMax;
         FrameGraphId<FrameGraphTexture> outColor;
         FrameGraphId<FrameGraphTexture> outAlpha;
+        FrameGraphId<FrameGraphTexture> tilesMask;
     };
 
     auto& ppDoF = fg.addPass<PostProcessDof>("DoF",
@@ -1719,10 +1860,17 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                         .height = colorDesc.height / dofResolution,
                         .format = TextureFormat::R8
                 });
+                data.tilesMask = builder.createTexture("dof tiles mask", {
+                        .width  = colorDesc.width  / dofResolution,
+                        .height = colorDesc.height / dofResolution,
+                        .format = TextureFormat::DEPTH16
+                });
                 data.outColor  = builder.write(data.outColor, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
                 data.outAlpha  = builder.write(data.outAlpha, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                data.tilesMask = builder.write(data.tilesMask, FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
                 builder.declareRenderPass("DoF Target", {
-                        .attachments = { .color = { data.outColor, data.outAlpha }}
+                        .attachments = { .color = { data.outColor, data.outAlpha },
+                                         .depth = data.tilesMask }
                 });
             },
             [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
@@ -1734,6 +1882,12 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
 
                 auto const& inputDesc = resources.getDescriptor(data.coc);
 
+                auto const& maskMaterial = getPostProcessMaterial("dofTilesMask");
+                FMaterialInstance* const maskMi = maskMaterial.getMaterialInstance(mEngine);
+                maskMi->setParameter("tiles", tilesCocMinMax,
+                        { .filterMin = SamplerMinFilter::NEAREST });
+                maskMi->commit(driver);
+
                 auto const& material = getPostProcessMaterial("dof");
                 FMaterialInstance* const mi = material.getMaterialInstance(mEngine);
                 // it's not safe to use bilinear filtering in the general case (causes artifacts around edges)
@@ -1757,7 +1911,18 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                     0.0 // unused for now
                 });
                 mi->setParameter("bokehAngle",  bokehAngle);
-                commitAndRender(out, material, driver);
+                mi->commit(driver);
+
+                PipelineState pipeline(material.getPipelineState(mEngine));
+                pipeline.rasterState.depthFunc = SamplerCompareFunc::NE;
+
+                auto fullScreenRenderPrimitive = mEngine.getFullScreenRenderPrimitive();
+                driver.beginRenderPass(out.target, out.params);
+                maskMi->use(driver);
+                driver.draw(maskMaterial.getPipelineState(mEngine), fullScreenRenderPrimitive, 1);
+                mi->use(driver);
+                driver.draw(pipeline, fullScreenRenderPrimitive, 1);
+                driver.endRenderPass();
             });
 
     /*
@@ -1768,6 +1933,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
         FrameGraphId<FrameGraphTexture> inColor;
         FrameGraphId<FrameGraphTexture> inAlpha;
         FrameGraphId<FrameGraphTexture> tilesCocMinMax;
+        FrameGraphId<FrameGraphTexture> tilesMask;
         FrameGraphId<FrameGraphTexture> outColor;
         FrameGraphId<FrameGraphTexture> outAlpha;
     };
@@ -1783,8 +1949,14 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                 data.outAlpha = builder.createTexture("dof alpha output", fg.getDescriptor(data.inAlpha));
                 data.outColor = builder.write(data.outColor, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
                 data.outAlpha = builder.write(data.outAlpha, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                // the in-focus tiles are skipped using the mask of the DoF pass, they are cleared
+                // to the same value the DoF pass writes for them
+                data.tilesMask = builder.read(ppDoF->tilesMask,
+                        FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
                 builder.declareRenderPass("DoF Target", {
-                        .attachments = { .color = { data.outColor, data.outAlpha }}
+                        .attachments = { .color = { data.outColor, data.outAlpha },
+                                         .depth = data.tilesMask },
+                        .clearFlags = TargetBufferFlags::COLOR0 | TargetBufferFlags::COLOR1
                 });
             },
             [=](FrameGraphResources const& resources, auto const& data, DriverApi& driver) {
@@ -1799,7 +1971,12 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::dof(FrameGraph& fg,
                 mi->setParameter("dof",   inColor,        { .filterMin = SamplerMinFilter::NEAREST_MIPMAP_NEAREST });
                 mi->setParameter("alpha", inAlpha,        { .filterMin = SamplerMinFilter::NEAREST_MIPMAP_NEAREST });
                 mi->setParameter("tiles", tilesCocMinMax, { .filterMin = SamplerMinFilter::NEAREST });
-                commitAndRender(out, material, driver);
+                mi->commit(driver);
+                mi->use(driver);
+
+                PipelineState pipeline(material.getPipelineState(mEngine));
+                pipeline.rasterState.depthFunc = SamplerCompareFunc::NE;
+                render(out, pipeline, driver);
             });
 
 
@@ -2190,6 +2367,67 @@ void PostProcessManager::colorGradingSubpass(DriverApi& driver,
     driver.draw(material.getPipelineState(mEngine, variant), fullScreenRenderPrimitive, 1);
 }
 
+void PostProcessManager::colorGradingBake(DriverApi& driver, TextureHandle lut,
+        uint32_t dimension, FColorGrading::BakeParameters const& params) noexcept {
+    auto const& material = getPostProcessMaterial("colorGradingBake");
+    FMaterialInstance* const mi = material.getMaterialInstance(mEngine);
+
+    mi->setParameter("toneMappingLut", params.toneMappingLut, {
+            .filterMag = SamplerMagFilter::LINEAR,
+            .filterMin = SamplerMinFilter::LINEAR,
+            .wrapS = SamplerWrapMode::CLAMP_TO_EDGE,
+            .wrapT = SamplerWrapMode::CLAMP_TO_EDGE,
+            .wrapR = SamplerWrapMode::CLAMP_TO_EDGE,
+            .anisotropyLog2 = 0
+    });
+    const float lutDimension = float(dimension);
+    mi->setParameter("toneMappingLutSize", float2{
+            0.5f / lutDimension, (lutDimension - 1.0f) / lutDimension,
+    });
+    mi->setParameter("lutScale", 1.0f / (lutDimension - 1.0f));
+    mi->setParameter("exposure", params.exposure);
+    mi->setParameter("nightAdaptation", params.nightAdaptation);
+    mi->setParameter("colorGradingIn", params.colorGradingIn);
+    mi->setParameter("channelMixer", params.channelMixer);
+    mi->setParameter("luminance", params.luminance);
+    mi->setParameter("shadows", params.shadows);
+    mi->setParameter("midtones", params.midtones);
+    mi->setParameter("highlights", params.highlights);
+    mi->setParameter("tonalRanges", params.tonalRanges);
+    mi->setParameter("slope", params.slope);
+    mi->setParameter("offset", params.offset);
+    mi->setParameter("power", params.power);
+    mi->setParameter("contrast", params.contrast);
+    mi->setParameter("vibrance", params.vibrance);
+    mi->setParameter("saturation", params.saturation);
+    mi->setParameter("shadowGamma", params.shadowGamma);
+    mi->setParameter("midPoint", params.midPoint);
+    mi->setParameter("highlightScale", params.highlightScale);
+    mi->use(driver);
+
+    const PipelineState pipeline(material.getPipelineState(mEngine));
+    const Handle<HwRenderPrimitive> fullScreenRenderPrimitive =
+            mEngine.getFullScreenRenderPrimitive();
+
+    RenderPassParams passParams{};
+    passParams.viewport = { 0, 0, dimension, dimension };
+    passParams.flags.discardStart = TargetBufferFlags::COLOR0;
+
+    // each slice of the 3D texture is rendered as a layer, the backend must support it (see
+    // FColorGrading)
+    for (uint32_t slice = 0; slice < dimension; slice++) {
+        mi->setParameter("slice", float(slice));
+        mi->commit(driver);
+
+        RenderTargetHandle rt = driver.createRenderTarget(TargetBufferFlags::COLOR0,
+                dimension, dimension, 1, { lut, 0, uint16_t(slice) }, {}, {});
+        driver.beginRenderPass(rt, passParams);
+        driver.draw(pipeline, fullScreenRenderPrimitive, 1);
+        driver.endRenderPass();
+        driver.destroyRenderTarget(rt);
+    }
+}
+
 void PostProcessManager::customResolvePrepareSubpass(DriverApi& driver, CustomResolveOp op) noexcept {
     auto const& material = getPostProcessMaterial("customResolveAsSubpass");
     FMaterialInstance* mi = material.getMaterialInstance(mEngine);
@@ -2657,7 +2895,8 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::upscale(FrameGraph& fg, bool
         filament::Viewport const& vp, FrameGraphTexture::Descriptor const& outDesc,
         backend::SamplerMagFilter filter) noexcept {
 
-    if (UTILS_LIKELY(!translucent && dsrOptions.quality == QualityLevel::LOW)) {
+    UpscaleConfig const config = getUpscaleConfig(translucent, dsrOptions);
+    if (UTILS_LIKELY(config.opaqueBlit)) {
         return opaqueBlit(fg, input, vp, outDesc, filter);
     }
 
@@ -2665,15 +2904,9 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::upscale(FrameGraph& fg, bool
     assert_invariant(fg.getSubResourceDescriptor(input).layer == 0);
     assert_invariant(fg.getSubResourceDescriptor(input).level == 0);
 
-    const bool lowQualityFallback = translucent && dsrOptions.quality != QualityLevel::LOW;
-    if (lowQualityFallback) {
-        // FidelityFX-FSR doesn't support the alpha channel currently
-        dsrOptions.quality = QualityLevel::LOW;
-    }
-
-    const bool twoPassesEASU = mWorkaroundSplitEasu &&
-            (dsrOptions.quality == QualityLevel::MEDIUM
-                || dsrOptions.quality == QualityLevel::HIGH);
+    dsrOptions = config.dsrOptions;
+    const bool twoPassesEASU = config.twoPassesEASU;
+    const StaticString blitter = config.blitter;
 
     struct QuadBlitData {
         FrameGraphId<FrameGraphTexture> input;
@@ -2701,7 +2934,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::upscale(FrameGraph& fg, bool
                         .attachments = { .color = { data.output }, .depth = { data.depth }},
                         .clearFlags = TargetBufferFlags::DEPTH });
             },
-            [this, twoPassesEASU, dsrOptions, vp, translucent, filter](FrameGraphResources const& resources,
+            [this, twoPassesEASU, blitter, dsrOptions, vp, translucent, filter](FrameGraphResources const& resources,
                     auto const& data, DriverApi& driver) {
 
                 // helper to set the EASU uniforms
@@ -2758,10 +2991,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::upscale(FrameGraph& fg, bool
                 }
 
                 { // just a scope to not leak local variables
-                    const StaticString blitterNames[4] = {
-                            "blitLow", "fsr_easu_mobile", "fsr_easu_mobile", "fsr_easu" };
-                    unsigned index = std::min(3u, (unsigned)dsrOptions.quality);
-                    easuMaterial = &getPostProcessMaterial(blitterNames[index]);
+                    easuMaterial = &getPostProcessMaterial(blitter);
                     auto* mi = easuMaterial->getMaterialInstance(mEngine);
                     if (dsrOptions.quality != QualityLevel::LOW) {
                         setEasuUniforms(mi, inputDesc, outputDesc);
@@ -2816,7 +3046,7 @@ FrameGraphId<FrameGraphTexture> PostProcessManager::upscale(FrameGraph& fg, bool
     auto output = ppQuadBlit->output;
 
     // if we had to take the low quality fallback, we still do the "sharpen pass"
-    if (dsrOptions.sharpness > 0.0f && (dsrOptions.quality != QualityLevel::LOW || lowQualityFallback)) {
+    if (config.rcas) {
         auto& ppFsrRcas = fg.addPass<QuadBlitData>("FidelityFX FSR1 Rcas",
                 [&](FrameGraph::Builder& builder, auto& data) {
                     data.input = builder.sample(output);
@@ -21,6 +21,8 @@
 
 #include "FrameHistory.h"
 
+#include "details/ColorGrading.h"
+
 #include <fg/FrameGraphId.h>
 #include <fg/FrameGraphResources.h>
 
@@ -39,7 +41,6 @@
 
 namespace filament {
 
-class FColorGrading;
 class FEngine;
 class FMaterial;
 class FMaterialInstance;
@@ -64,12 +65,44 @@ public:
         bool picking{};
     };
 
+    // effects used by the current frame, see prepare()
+    struct PrepareConfig {
+        bool ssao{};
+        bool ssaoBentNormals{};
+        bool ssr{};
+        bool refraction{};
+        bool contactShadows{};
+        bool vsm{};                 // VSM shadow maps are rendered (and possibly blurred)
+        bool vsmMipmap{};
+        bool taa{};
+        bool dof{};
+        bool bloom{};
+        bool flare{};
+        bool colorGrading{};
+        bool colorGradingAsSubpass{};
+        bool colorGradingBake{};    // the color grading LUT is baked this frame
+        bool customResolve{};
+        bool fxaa{};
+        bool upscale{};
+        bool translucent{};         // the buffers have an alpha channel
+        bool blending{};            // the view is blended into its render target
+        DepthOfFieldOptions dofOptions{};
+        DynamicResolutionOptions dsrOptions{};
+    };
+
     explicit PostProcessManager(FEngine& engine) noexcept;
     ~PostProcessManager() noexcept;
 
     void init() noexcept;
     void terminate(backend::DriverApi& driver) noexcept;
 
+    // Loads the materials and creates the programs needed by the effects of the frame, so that
+    // this work doesn't happen in the middle of the FrameGraph execution. This must be called
+    // before the FrameGraph is executed and is cheap once everything is loaded.
+    // This doesn't set any uniform, the passes still set and commit their material instances
+    // when they execute.
+    void prepare(PrepareConfig const& config) noexcept;
+
     // methods below are ordered relative to their position in the pipeline (as much as possible)
 
     // structure (depth) pass
@@ -178,6 +211,10 @@ public:
     void colorGradingSubpass(backend::DriverApi& driver,
             ColorGradingConfig const& colorGradingConfig) noexcept;
 
+    // Bakes a color grading LUT on the GPU, one draw per slice. Called outside of the FrameGraph.
+    void colorGradingBake(backend::DriverApi& driver, backend::TextureHandle lut,
+            uint32_t dimension, FColorGrading::BakeParameters const& params) noexcept;
+
     // custom MSAA resolve as subpass
     enum class CustomResolveOp { COMPRESS, UNCOMPRESS };
     void customResolvePrepareSubpass(backend::DriverApi& driver, CustomResolveOp op) noexcept;
@@ -268,6 +305,24 @@ private:
             math::int2 axis, float zf, backend::TextureFormat format,
             BilateralPassConfig const& config) noexcept;
 
+    // The material selection of the effects is shared with prepare(), so that it prepares the
+    // materials the passes actually use.
+    static utils::StaticString getSsaoMaterialName(bool bentNormals) noexcept;
+    static utils::StaticString getBilateralBlurMaterialName(bool bentNormals) noexcept;
+    static utils::StaticString getDofDownsampleMaterialName(bool nativeResolution) noexcept;
+    static utils::StaticString getGaussianBlurMaterialName(
+            backend::TextureFormat format, bool is2dArray) noexcept;
+
+    struct UpscaleConfig {
+        DynamicResolutionOptions dsrOptions;    // with the quality level actually used
+        utils::StaticString blitter;            // material of the upscaling pass
+        bool opaqueBlit;                        // opaqueBlit() is used, no material is needed
+        bool twoPassesEASU;                     // blitter is preceded by "fsr_easu_mobileF"
+        bool rcas;                              // followed by the "fsr_rcas" sharpening pass
+    };
+    UpscaleConfig getUpscaleConfig(bool translucent,
+            DynamicResolutionOptions dsrOptions) const noexcept;
+
     BloomPassOutput bloomPass(FrameGraph& fg,
             FrameGraphId<FrameGraphTexture> input, backend::TextureFormat outFormat,
             BloomOptions& inoutBloomOptions, math::float2 scale) noexcept;
@@ -95,6 +95,7 @@ void RenderPass::overrideScissor(backend::Viewport const* scissor) noexcept {
 
 void RenderPass::appendCommands(CommandTypeFlags const commandTypeFlags) noexcept {
     SYSTRACE_CONTEXT();
+    FrameStats::Scope stageScope(mEngine.getFrameStats(), FrameStats::Stage::COMMAND_GENERATION);
 
     assert_invariant(mRenderableSoa);
 
@@ -176,6 +177,7 @@ void RenderPass::appendCustomCommand(Pass pass, CustomCommand custom, uint32_t o
 
 void RenderPass::sortCommands() noexcept {
     SYSTRACE_NAME("sort and trim commands");
+    FrameStats::Scope stageScope(mEngine.getFrameStats(), FrameStats::Stage::SORT);
 
     std::sort(mCommandBegin, mCommandEnd);
 
@@ -316,6 +318,8 @@ void RenderPass::generateCommandsImpl(uint32_t extraFlags,
 
     const bool hasShadowing = renderFlags & HAS_SHADOWING;
     const bool viewInverseFrontFaces = renderFlags & HAS_INVERSE_FRONT_FACES;
+    const bool excludeStaticShadowCasters = renderFlags & EXCLUDE_STATIC_SHADOW_CASTERS;
+    const bool excludeDynamicShadowCasters = renderFlags & EXCLUDE_DYNAMIC_SHADOW_CASTERS;
 
     Command cmdColor;
 
@@ -330,9 +334,11 @@ void RenderPass::generateCommandsImpl(uint32_t extraFlags,
     }
 
     for (uint32_t i = range.first; i < range.last; ++i) {
-        // Check if this renderable passes the visibilityMask. If it doesn't, encode SENTINEL
-        // commands (no-op).
-        if (UTILS_UNLIKELY(!(soaVisibilityMask[i] & visibilityMask))) {
+        // Check if this renderable passes the visibilityMask and isn't excluded. If it doesn't,
+        // encode SENTINEL commands (no-op).
+        const bool excluded = soaVisibility[i].staticShadowCaster ?
+                excludeStaticShadowCasters : excludeDynamicShadowCasters;
+        if (UTILS_UNLIKELY(!(soaVisibilityMask[i] & visibilityMask) || excluded)) {
             // We need to encode a SENTINEL for each command that would have been generated
             // otherwise. Color passes get 2 commands per primitive; depth passes get 1.
             const Slice<FRenderPrimitive>& primitives = soaPrimitives[i];
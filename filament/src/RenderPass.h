@@ -251,6 +251,9 @@ public:
     using RenderFlags = uint8_t;
     static constexpr RenderFlags HAS_SHADOWING           = 0x01;
     static constexpr RenderFlags HAS_INVERSE_FRONT_FACES = 0x02;
+    // used by cached shadow maps, to render static and dynamic shadow casters separately
+    static constexpr RenderFlags EXCLUDE_STATIC_SHADOW_CASTERS  = 0x04;
+    static constexpr RenderFlags EXCLUDE_DYNAMIC_SHADOW_CASTERS = 0x08;
 
     // Arena used for commands
     using Arena = utils::Arena<
@@ -68,6 +68,14 @@ void RenderableManager::setScreenSpaceContactShadows(Instance instance, bool ena
     upcast(this)->setScreenSpaceContactShadows(instance, enable);
 }
 
+void RenderableManager::setStaticShadowCaster(Instance instance, bool enable) noexcept {
+    upcast(this)->setStaticShadowCaster(instance, enable);
+}
+
+bool RenderableManager::isStaticShadowCaster(Instance instance) const noexcept {
+    return upcast(this)->isStaticShadowCaster(instance);
+}
+
 bool RenderableManager::isShadowCaster(Instance instance) const noexcept {
     return upcast(this)->isShadowCaster(instance);
 }
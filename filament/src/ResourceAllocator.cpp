@@ -20,11 +20,10 @@
 
 #include "details/Texture.h"
 
-#include <utils/FixedCapacityVector.h>
 #include <utils/Log.h>
 #include <utils/debug.h>
 
-#include <iterator>
+#include <algorithm>
 
 using namespace utils;
 
@@ -34,44 +33,73 @@ using namespace backend;
 
 // ------------------------------------------------------------------------------------------------
 
-template<typename K, typename V, typename H>
-UTILS_NOINLINE
-ResourceAllocator::AssociativeContainer<K, V, H>::AssociativeContainer() {
-    mContainer.reserve(128);
+ResourceAllocator::TextureCache::~TextureCache() noexcept {
+    for (CacheEntry* list : { mFront, mFreeList }) {
+        while (list) {
+            CacheEntry* const next = list->next;
+            delete list;
+            list = next;
+        }
+    }
 }
 
-template<typename K, typename V, typename H>
-UTILS_NOINLINE
-ResourceAllocator::AssociativeContainer<K, V, H>::~AssociativeContainer() noexcept {
+ResourceAllocator::CacheEntry* ResourceAllocator::TextureCache::find(
+        TextureKey const& key) const noexcept {
+    auto const pos = mKeys.find(key);
+    return pos != mKeys.end() ? pos->second : nullptr;
 }
 
-template<typename K, typename V, typename H>
 UTILS_NOINLINE
-typename ResourceAllocator::AssociativeContainer<K, V, H>::iterator
-ResourceAllocator::AssociativeContainer<K, V, H>::erase(iterator it) {
-    return mContainer.erase(it);
-}
-
-template<typename K, typename V, typename H>
-typename ResourceAllocator::AssociativeContainer<K, V, H>::const_iterator
-ResourceAllocator::AssociativeContainer<K, V, H>::find(key_type const& key) const {
-    return const_cast<AssociativeContainer*>(this)->find(key);
+void ResourceAllocator::TextureCache::insert(
+        TextureKey const& key, TextureCachePayload const& payload) {
+    CacheEntry* entry = mFreeList;
+    if (entry) {
+        mFreeList = entry->next;
+    } else {
+        entry = new CacheEntry;
+    }
+    entry->key = key;
+    entry->payload = payload;
+
+    // append to the LRU list
+    entry->prev = mBack;
+    entry->next = nullptr;
+    (mBack ? mBack->next : mFront) = entry;
+    mBack = entry;
+
+    // and make it the first entry of its key
+    auto [pos, inserted] = mKeys.try_emplace(key, entry);
+    entry->prevSameKey = nullptr;
+    entry->nextSameKey = inserted ? nullptr : pos->second;
+    if (!inserted) {
+        pos->second->prevSameKey = entry;
+        pos.value() = entry;
+    }
+    mSize++;
 }
 
-template<typename K, typename V, typename H>
 UTILS_NOINLINE
-typename ResourceAllocator::AssociativeContainer<K, V, H>::iterator
-ResourceAllocator::AssociativeContainer<K, V, H>::find(key_type const& key) {
-    return std::find_if(mContainer.begin(), mContainer.end(), [&key](auto const& v) {
-        return v.first == key;
-    });
-}
+ResourceAllocator::CacheEntry* ResourceAllocator::TextureCache::erase(
+        CacheEntry* entry) noexcept {
+    CacheEntry* const next = entry->next;
+    (entry->prev ? entry->prev->next : mFront) = next;
+    (next ? next->prev : mBack) = entry->prev;
+
+    if (entry->nextSameKey) {
+        entry->nextSameKey->prevSameKey = entry->prevSameKey;
+    }
+    if (entry->prevSameKey) {
+        entry->prevSameKey->nextSameKey = entry->nextSameKey;
+    } else if (entry->nextSameKey) {
+        mKeys.find(entry->key).value() = entry->nextSameKey;
+    } else {
+        mKeys.erase(entry->key);
+    }
 
-template<typename K, typename V, typename H>
-template<typename... ARGS>
-UTILS_NOINLINE
-void ResourceAllocator::AssociativeContainer<K, V, H>::emplace(ARGS&& ... args) {
-    mContainer.emplace_back(std::forward<ARGS>(args)...);
+    entry->next = mFreeList;
+    mFreeList = entry;
+    mSize--;
+    return next;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -106,9 +134,9 @@ ResourceAllocator::~ResourceAllocator() noexcept {
 void ResourceAllocator::terminate() noexcept {
     assert_invariant(!mInUseTextures.size());
     auto& textureCache = mTextureCache;
-    for (auto it = textureCache.begin(); it != textureCache.end();) {
-        mBackend.destroyTexture(it->second.handle);
-        it = textureCache.erase(it);
+    for (CacheEntry* entry = textureCache.front(); entry;) {
+        mBackend.destroyTexture(entry->payload.handle);
+        entry = textureCache.erase(entry);
     }
 }
 
@@ -154,14 +182,25 @@ backend::TextureHandle ResourceAllocator::createTexture(const char* name,
     TextureHandle handle;
     if constexpr (mEnabled) {
         auto& textureCache = mTextureCache;
-        const TextureKey key{ name, target, levels, format, samples, width, height, depth, usage, swizzle };
-        auto it = textureCache.find(key);
-        if (UTILS_LIKELY(it != textureCache.end())) {
+        TextureKey key{ name, target, levels, format, samples, width, height, depth, usage, swizzle };
+        CacheEntry* entry = textureCache.find(key);
+#if !defined(__EMSCRIPTEN__)
+        if (!entry && !(usage & TextureUsage::SAMPLEABLE)) {
+            // Textures that are never sampled are only used as attachments, which can be larger
+            // than their render target (see above), so any large enough texture will do.
+            entry = findAttachment(key);
+        }
+#endif
+        if (UTILS_LIKELY(entry)) {
             // we do, move the entry to the in-use list, and remove from the cache
-            handle = it->second.handle;
-            mCacheSize -= it->second.size;
-            textureCache.erase(it);
+            handle = entry->payload.handle;
+            mCacheSize -= entry->payload.size;
+            key = entry->key;
+            key.name = name;
+            textureCache.erase(entry);
+            mStats.hits++;
         } else {
+            mStats.misses++;
             // we don't, allocate a new texture and populate the in-use list
             if (swizzle == defaultSwizzle) {
                 handle = mBackend.createTexture(
@@ -173,6 +212,7 @@ backend::TextureHandle ResourceAllocator::createTexture(const char* name,
             }
         }
         mInUseTextures.emplace(handle, key);
+        mInUseSize += key.getSize();
     } else {
         if (swizzle == defaultSwizzle) {
             handle = mBackend.createTexture(
@@ -186,6 +226,27 @@ backend::TextureHandle ResourceAllocator::createTexture(const char* name,
     return handle;
 }
 
+ResourceAllocator::CacheEntry* ResourceAllocator::findAttachment(
+        TextureKey const& key) const noexcept {
+    // Find the smallest cached texture that can hold the requested one. We don't accept
+    // textures more than twice as large, otherwise we'd be better off creating a new one and
+    // let the cache purge the large one eventually.
+    const size_t maxSize = key.getSize() * 2;
+    CacheEntry* best = nullptr;
+    for (CacheEntry* entry = mTextureCache.front(); entry; entry = entry->next) {
+        TextureKey const& k = entry->key;
+        if (k.target == key.target && k.levels == key.levels && k.format == key.format &&
+                k.samples == key.samples && k.depth == key.depth && k.usage == key.usage &&
+                k.swizzle == key.swizzle && k.width >= key.width && k.height >= key.height &&
+                entry->payload.size <= maxSize) {
+            if (!best || entry->payload.size < best->payload.size) {
+                best = entry;
+            }
+        }
+    }
+    return best;
+}
+
 void ResourceAllocator::destroyTexture(TextureHandle h) noexcept {
     if constexpr (mEnabled) {
         // find the texture in the in-use list (it must be there!)
@@ -196,8 +257,9 @@ void ResourceAllocator::destroyTexture(TextureHandle h) noexcept {
         const TextureKey key = it->second;
         uint32_t size = key.getSize();
 
-        mTextureCache.emplace(key, TextureCachePayload{ h, mAge, size });
+        mTextureCache.insert(key, TextureCachePayload{ h, mAge, size });
         mCacheSize += size;
+        mInUseSize -= size;
 
         // remove it from the in-use list
         mInUseTextures.erase(it);
@@ -212,54 +274,44 @@ void ResourceAllocator::gc() noexcept {
     // increase our age
     const size_t age = mAge++;
 
+    // Textures are appended to the cache when they're released, so the cache is always sorted
+    // from the least to the most recently used texture.
+    //
     // Purging strategy:
-    //  - remove entries that are older than a certain age
-    //      - remove only one entry per gc(),
-    //      - unless we're at capacity
-    // - remove LRU entries until we're below capacity
+    //  - remove LRU entries until we're within budget
+    //  - remove entries that are older than their maximum age, which is shorter for large
+    //    textures, so they don't hold on to a large part of the budget for too long
+    //      - remove only one such entry per gc(), trying to avoid a burst of work.
 
     auto& textureCache = mTextureCache;
-    for (auto it = textureCache.begin(); it != textureCache.end();) {
-        const size_t ageDiff = age - it->second.age;
-        if (ageDiff >= CACHE_MAX_AGE) {
-            it = purge(it);
-            if (mCacheSize < CACHE_CAPACITY) {
-                // if we're not at capacity, only purge a single entry per gc, trying to
-                // avoid a burst of work.
-                break;
-            }
+    bool purgedExpired = false;
+    for (CacheEntry* entry = textureCache.front(); entry;) {
+        if (UTILS_UNLIKELY(mCacheSize > mCacheBudget)) {
+            entry = purge(entry);
+        } else if (!purgedExpired &&
+                age - entry->payload.age >= getMaxAge(entry->payload.size)) {
+            entry = purge(entry);
+            purgedExpired = true;
         } else {
-            ++it;
+            entry = entry->next;
         }
     }
+    //if (mAge % 60 == 0) dump();
+}
 
-    if (UTILS_UNLIKELY(mCacheSize >= CACHE_CAPACITY)) {
-        // make a copy of our CacheContainer to a vector
-        using Vector = FixedCapacityVector<std::pair<TextureKey, TextureCachePayload>>;
-        auto cache = Vector::with_capacity(textureCache.size());
-        std::copy(textureCache.begin(), textureCache.end(), std::back_insert_iterator<Vector>(cache));
-
-        // sort by least recently used
-        std::sort(cache.begin(), cache.end(), [](auto const& lhs, auto const& rhs) {
-            return lhs.second.age < rhs.second.age;
-        });
-
-        // now remove entries until we're at capacity
-        auto curr = cache.begin();
-        while (mCacheSize >= CACHE_CAPACITY) {
-            // by construction this entry must exist
-            purge(textureCache.find(curr->first));
-            ++curr;
-        }
-
-        // Since we're sorted already, reset the oldestAge of the whole system
-        size_t oldestAge = cache.front().second.age;
-        for (auto& it : textureCache) {
-            it.second.age -= oldestAge;
-        }
-        mAge -= oldestAge;
+size_t ResourceAllocator::getMaxAge(size_t size) const noexcept {
+    // the max age decreases linearly with the fraction of the budget used by the texture
+    if (size >= mCacheBudget) {
+        return 1;
     }
-    //if (mAge % 60 == 0) dump();
+    return std::max(size_t(1), CACHE_MAX_AGE - (CACHE_MAX_AGE * size) / mCacheBudget);
+}
+
+ResourceAllocator::Stats ResourceAllocator::getStats() const noexcept {
+    Stats stats = mStats;
+    stats.cacheSize = mCacheSize;
+    stats.inUseSize = mInUseSize;
+    return stats;
 }
 
 UTILS_NOINLINE
@@ -267,22 +319,23 @@ void ResourceAllocator::dump(bool brief) const noexcept {
     slog.d << "# entries=" << mTextureCache.size() << ", sz=" << mCacheSize / float(1u << 20u)
            << " MiB" << io::endl;
     if (!brief) {
-        for (auto const& it : mTextureCache) {
-            auto w = it.first.width;
-            auto h = it.first.height;
-            auto f = FTexture::getFormatSize(it.first.format);
-            slog.d << it.first.name << ": w=" << w << ", h=" << h << ", f=" << f << ", sz="
-                   << it.second.size / float(1u << 20u) << io::endl;
+        for (CacheEntry const* entry = mTextureCache.front(); entry; entry = entry->next) {
+            auto w = entry->key.width;
+            auto h = entry->key.height;
+            auto f = FTexture::getFormatSize(entry->key.format);
+            slog.d << entry->key.name << ": w=" << w << ", h=" << h << ", f=" << f << ", sz="
+                   << entry->payload.size / float(1u << 20u) << io::endl;
         }
     }
 }
 
-ResourceAllocator::CacheContainer::iterator ResourceAllocator::purge(
-        ResourceAllocator::CacheContainer::iterator const& pos) {
-    //slog.d << "purging " << pos->second.handle.getId() << ", age=" << pos->second.age << io::endl;
-    mBackend.destroyTexture(pos->second.handle);
-    mCacheSize -= pos->second.size;
-    return mTextureCache.erase(pos);
+ResourceAllocator::CacheEntry* ResourceAllocator::purge(CacheEntry* entry) {
+    //slog.d << "purging " << entry->payload.handle.getId() << ", age=" << entry->payload.age << io::endl;
+    mBackend.destroyTexture(entry->payload.handle);
+    mCacheSize -= entry->payload.size;
+    mStats.evictions++;
+    mStats.bytesEvicted += entry->payload.size;
+    return mTextureCache.erase(entry);
 }
 
 } // namespace filament
@@ -25,8 +25,9 @@
 
 #include <utils/Hash.h>
 
+#include <tsl/robin_map.h>
+
 #include <array>
-#include <vector>
 
 #include <stdint.h>
 
@@ -88,10 +89,27 @@ public:
 
     void gc() noexcept;
 
+    static constexpr size_t DEFAULT_CACHE_BUDGET = 64u << 20u;   // 64 MiB
+
+    // maximum size in bytes of the unused textures kept in the cache
+    void setCacheBudget(size_t budget) noexcept { mCacheBudget = budget; }
+    size_t getCacheBudget() const noexcept { return mCacheBudget; }
+
+    struct Stats {
+        size_t hits = 0;            // textures taken from the cache
+        size_t misses = 0;          // textures that had to be created
+        size_t evictions = 0;       // textures evicted from the cache
+        size_t bytesEvicted = 0;    // size of the textures evicted from the cache
+        size_t cacheSize = 0;       // size of the unused textures in the cache
+        size_t inUseSize = 0;       // size of the textures in use
+    };
+
+    Stats getStats() const noexcept;
+
 private:
-    // TODO: these should be settings of the engine
-    static constexpr size_t CACHE_CAPACITY = 64u << 20u;   // 64 MiB
-    static constexpr size_t CACHE_MAX_AGE  = 30u;
+    // Number of gc() after which an unused texture is evicted. This is reduced for large
+    // textures (see getMaxAge()).
+    static constexpr size_t CACHE_MAX_AGE = 30u;
 
     struct TextureKey {
         const char* name; // doesn't participate in the hash
@@ -159,44 +177,66 @@ private:
 
     inline void dump(bool brief = false) const noexcept;
 
-    template<typename Key, typename Value, typename Hasher = Hasher<Key>>
-    class AssociativeContainer {
-        // We use a std::vector instead of a std::multimap because we don't expect many items
-        // in the cache and std::multimap generates tons of code. std::multimap starts getting
-        // significantly better around 1000 items.
-        using Container = std::vector<std::pair<Key, Value>>;
-        Container mContainer;
+    // A texture in the cache. Entries are linked from the least to the most recently used, and
+    // with the other entries of the same key, so that both can be updated in O(1).
+    struct CacheEntry {
+        TextureKey key;
+        TextureCachePayload payload;
+        CacheEntry* prev = nullptr;
+        CacheEntry* next = nullptr;
+        CacheEntry* prevSameKey = nullptr;
+        CacheEntry* nextSameKey = nullptr;
+    };
 
+    class TextureCache {
     public:
-        AssociativeContainer();
-        ~AssociativeContainer() noexcept;
-        using iterator = typename Container::iterator;
-        using const_iterator = typename Container::const_iterator;
-        using key_type = typename Container::value_type::first_type;
-        using value_type = typename Container::value_type::second_type;
-
-        size_t size() const { return mContainer.size(); }
-        iterator begin() { return mContainer.begin(); }
-        const_iterator begin() const { return mContainer.begin(); }
-        iterator end() { return mContainer.end(); }
-        const_iterator end() const  { return mContainer.end(); }
-        iterator erase(iterator it);
-        const_iterator find(key_type const& key) const;
-        iterator find(key_type const& key);
-        template<typename ... ARGS>
-        void emplace(ARGS&&... args);
+        TextureCache() noexcept = default;
+        TextureCache(TextureCache const&) = delete;
+        TextureCache& operator=(TextureCache const&) = delete;
+        ~TextureCache() noexcept;
+
+        size_t size() const noexcept { return mSize; }
+
+        // least recently used entry, use CacheEntry::next to iterate
+        CacheEntry* front() const noexcept { return mFront; }
+
+        // an entry matching key, or nullptr
+        CacheEntry* find(TextureKey const& key) const noexcept;
+
+        // adds an entry as the most recently used
+        void insert(TextureKey const& key, TextureCachePayload const& payload);
+
+        // removes entry and returns the next one
+        CacheEntry* erase(CacheEntry* entry) noexcept;
+
+    private:
+        // most recently used entry for each key
+        tsl::robin_map<TextureKey, CacheEntry*, Hasher<TextureKey>> mKeys;
+        CacheEntry* mFront = nullptr;
+        CacheEntry* mBack = nullptr;
+        CacheEntry* mFreeList = nullptr;    // erased entries, linked with next
+        size_t mSize = 0;
     };
 
-    using CacheContainer = AssociativeContainer<TextureKey, TextureCachePayload>;
-    using InUseContainer = AssociativeContainer<backend::TextureHandle, TextureKey>;
+    using InUseContainer = tsl::robin_map<backend::TextureHandle, TextureKey,
+            Hasher<backend::TextureHandle>>;
+
+    CacheEntry* purge(CacheEntry* entry);
+
+    size_t getMaxAge(size_t size) const noexcept;
 
-    CacheContainer::iterator purge(CacheContainer::iterator const& pos);
+    // finds a cached texture that can be used as an attachment in place of the one described
+    // by key, returns nullptr if there isn't any.
+    CacheEntry* findAttachment(TextureKey const& key) const noexcept;
 
     backend::DriverApi& mBackend;
-    CacheContainer mTextureCache;
+    TextureCache mTextureCache;
     InUseContainer mInUseTextures;
     size_t mAge = 0;
-    uint32_t mCacheSize = 0;
+    size_t mCacheSize = 0;
+    size_t mCacheBudget = DEFAULT_CACHE_BUDGET;
+    size_t mInUseSize = 0;
+    Stats mStats;
     static constexpr bool mEnabled = true;
 };
 
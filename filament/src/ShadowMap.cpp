@@ -104,25 +104,18 @@ void ShadowMap::updateDirectional(const FScene::LightSoa& lightData, size_t inde
 
 #ifndef NDEBUG
     // LISPSM debugging for directional light (works because we only have one)
+    // The cascades are updated concurrently, so the debug values are only read here, they're
+    // initialized by ShadowMapManager::updateCascadeShadowMaps().
     const float dz = camera.zf - camera.zn;
-    float& dzn = mEngine.debug.shadowmap.dzn;
-    float& dzf = mEngine.debug.shadowmap.dzf;
-    if (dzn < 0)    dzn = std::max(0.0f, params.options.shadowNearHint - camera.zn) / dz;
-    else            params.options.shadowNearHint = dzn * dz - camera.zn;
-    if (dzf > 0)    dzf =-std::max(0.0f, camera.zf - params.options.shadowFarHint) / dz;
-    else            params.options.shadowFarHint = dzf * dz + camera.zf;
+    const float dzn = mEngine.debug.shadowmap.dzn;
+    const float dzf = mEngine.debug.shadowmap.dzf;
+    if (dzn >= 0)   params.options.shadowNearHint = dzn * dz - camera.zn;
+    if (dzf <= 0)   params.options.shadowFarHint = dzf * dz + camera.zf;
 #endif
 
     // Adjust the camera's projection for the light's shadowFar
-    mat4f cullingProjection(camera.cullingProjection);
-    if (params.options.shadowFar > 0.0f) {
-        float n = camera.zn;
-        float f = params.options.shadowFar;
-        // orthographic projection
-        assert_invariant(std::abs(cullingProjection[2].w) <= std::numeric_limits<float>::epsilon());
-        cullingProjection[2].z = 2.0f / (n - f);
-        cullingProjection[3].z = (f + n) / (n - f);
-    }
+    const mat4f cullingProjection = getDirectionalCullingProjection(
+            camera, params.options.shadowFar);
 
     auto direction = lightData.elementAt<FScene::DIRECTION>(index);
 
@@ -193,6 +186,11 @@ void ShadowMap::updateDirectional(const FScene::LightSoa& lightData, size_t inde
         lsLightFrustumBounds.min.z = std::max(lsLightFrustumBounds.min.z, sceneInfo.lsNearFar[1]);
     }
 
+    if (mShadowMapInfo.quantizeFrustum &&
+            lsLightFrustumBounds.min.z < lsLightFrustumBounds.max.z) {
+        quantizeRange(lsLightFrustumBounds.min.z, lsLightFrustumBounds.max.z);
+    }
+
     // Now that we know the znear (-lsLightFrustumBounds.max.z), adjust the light's position such
     // that znear = 0, this is only need for VSM, but doesn't hurt PCF.
     const mat4f Mv = getDirectionalLightViewMatrix(direction, direction * -lsLightFrustumBounds.max.z);
@@ -230,8 +228,10 @@ void ShadowMap::updateDirectional(const FScene::LightSoa& lightData, size_t inde
 
     mHasVisibleShadows = vertexCount >= 2;
     if (mHasVisibleShadows) {
-        // We can't use LISPSM in stable mode
-        const bool USE_LISPSM = ENABLE_LISPSM && mEngine.debug.shadowmap.lispsm && !params.options.stable;
+        // We can't use LISPSM in stable mode, nor with a quantized frustum (the warping depends
+        // on the camera's direction)
+        const bool USE_LISPSM = ENABLE_LISPSM && mEngine.debug.shadowmap.lispsm &&
+                !params.options.stable && !mShadowMapInfo.quantizeFrustum;
 
         /*
          * Compute the light's projection matrix
@@ -319,6 +319,13 @@ void ShadowMap::updateDirectional(const FScene::LightSoa& lightData, size_t inde
         assert_invariant(lsLightFrustumBounds.min.x < lsLightFrustumBounds.max.x);
         assert_invariant(lsLightFrustumBounds.min.y < lsLightFrustumBounds.max.y);
 
+        if (mShadowMapInfo.quantizeFrustum) {
+            // Without warping, the light-space x and y axes are fixed w.r.t. the world, so the
+            // quantized bounds only depend on the light direction and the quantization steps.
+            quantizeRange(lsLightFrustumBounds.min.x, lsLightFrustumBounds.max.x);
+            quantizeRange(lsLightFrustumBounds.min.y, lsLightFrustumBounds.max.y);
+        }
+
         // compute focus scale and offset
         float2 s = 2.0f / float2(lsLightFrustumBounds.max.xy - lsLightFrustumBounds.min.xy);
         float2 o =   -s * float2(lsLightFrustumBounds.max.xy + lsLightFrustumBounds.min.xy) * 0.5f;
@@ -570,12 +577,13 @@ mat4 ShadowMap::getTextureCoordsMapping() const noexcept {
             0.0f, 0.0f, 0.0f, 1.0f
     });
 
-    // apply the 1-texel border viewport transform
-    const float o = 1.0f / mShadowMapInfo.atlasDimension;
+    // apply the 1-texel border viewport transform, and the offset of the texture in the atlas
+    const float ox = (1.0f + mShadowMapInfo.atlasOffset.x) / mShadowMapInfo.atlasDimension;
+    const float oy = (1.0f + mShadowMapInfo.atlasOffset.y) / mShadowMapInfo.atlasDimension;
     const float s = 1.0f - 2.0f * (1.0f / mShadowMapInfo.textureDimension);
     const mat4f Mb(mat4f::row_major_init{
-             s,    0.0f, 0.0f, o,
-             0.0f, s,    0.0f, o,
+             s,    0.0f, 0.0f, ox,
+             0.0f, s,    0.0f, oy,
              0.0f, 0.0f, 1.0f, 0.0f,
              0.0f, 0.0f, 0.0f, 1.0f
     });
@@ -591,6 +599,18 @@ mat4 ShadowMap::getTextureCoordsMapping() const noexcept {
     return mat4(Mf * Mb * Mv * Mt);
 }
 
+float4 ShadowMap::getClampToEdgeCoords() const noexcept {
+    const float dimension = mShadowMapInfo.atlasDimension;
+    const float2 offset{ mShadowMapInfo.atlasOffset.x, mShadowMapInfo.atlasOffset.y };
+    const float2 lb = (offset + 1.0f) / dimension;
+    const float2 rt = (offset + float(mShadowMapInfo.textureDimension - 1u)) / dimension;
+    if (mTextureSpaceFlipped) {
+        // see getTextureCoordsMapping()
+        return { lb.x, 1.0f - rt.y, rt.x, 1.0f - lb.y };
+    }
+    return { lb.x, lb.y, rt.x, rt.y };
+}
+
 mat4f ShadowMap::computeVsmLightSpaceMatrix(const mat4f& lightSpacePcf,
         const mat4f& Mv, float znear, float zfar) noexcept {
     // The lightSpacePcf matrix transforms coordinates from world space into (u, v, z) coordinates,
@@ -633,6 +653,15 @@ mat4f ShadowMap::directionalLightFrustum(float near, float far) noexcept {
     return m;
 }
 
+void ShadowMap::quantizeRange(float& lo, float& hi) noexcept {
+    // Grow the range to the next 1/4 octave, and align its start on 1/8 of that size. The range
+    // only changes when [lo, hi] crosses a step, at the cost of up to ~30% of resolution.
+    const float size = std::exp2(std::ceil(std::log2(hi - lo) * 4.0f) * 0.25f);
+    const float step = size * 0.125f;
+    lo = std::floor(lo / step) * step;
+    hi = lo + size + step;
+}
+
 float2 ShadowMap::computeNearFar(const mat4f& view,
         Aabb const& wsShadowCastersVolume) noexcept {
     const Aabb::Corners wsSceneCastersCorners = wsShadowCastersVolume.getCorners();
@@ -733,6 +762,46 @@ void ShadowMap::intersectWithShadowCasters(Aabb& UTILS_RESTRICT lightFrustum,
     lightFrustum.max.xy = min(box.max.xy, lightFrustum.max.xy);
 }
 
+bool ShadowMap::coversDirectional(filament::CameraInfo const& camera, float shadowFar,
+        SceneInfo const& sceneInfo) const noexcept {
+    if (!mHasVisibleShadows) {
+        return false;
+    }
+
+    // the light frustum, as it was last rendered
+    const mat4f lightFromWorld(mCamera->getCullingProjectionMatrix() * mCamera->getViewMatrix());
+    auto contains = [&lightFromWorld](float3 const* wsVertices, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            const float4 p = lightFromWorld * float4{ wsVertices[i], 1.0f };
+            if (std::abs(p.x) > p.w || std::abs(p.y) > p.w) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // updateDirectional() fits the light frustum to either of these
+    float3 wsViewFrustumVertices[8];
+    const mat4f worldToClipMatrix = getDirectionalCullingProjection(camera, shadowFar) * camera.view;
+    computeFrustumCorners(wsViewFrustumVertices, inverse(worldToClipMatrix), sceneInfo.csNearFar);
+    return contains(wsViewFrustumVertices, 8) ||
+           contains(sceneInfo.wsShadowReceiversVolume.getCorners().data(), 8);
+}
+
+mat4f ShadowMap::getDirectionalCullingProjection(
+        filament::CameraInfo const& camera, float shadowFar) noexcept {
+    mat4f cullingProjection(camera.cullingProjection);
+    if (shadowFar > 0.0f) {
+        float n = camera.zn;
+        float f = shadowFar;
+        // orthographic projection
+        assert_invariant(std::abs(cullingProjection[2].w) <= std::numeric_limits<float>::epsilon());
+        cullingProjection[2].z = 2.0f / (n - f);
+        cullingProjection[3].z = (f + n) / (n - f);
+    }
+    return cullingProjection;
+}
+
 void ShadowMap::computeFrustumCorners(float3* UTILS_RESTRICT out,
         const mat4f& UTILS_RESTRICT projectionViewInverse, float2 csNearFar) noexcept {
 
@@ -60,12 +60,12 @@ static constexpr Culler::result_type VISIBLE_SPOT_SHADOW_RENDERABLE_N(size_t n)
 
 // ORing of all the VISIBLE_SPOT_SHADOW_RENDERABLE bits
 static constexpr Culler::result_type VISIBLE_SPOT_SHADOW_RENDERABLE =
-        (0xFFu >> (sizeof(Culler::result_type) * 8u - CONFIG_MAX_SHADOW_CASTING_SPOTS)) << 2u;
+        Culler::result_type((1ull << CONFIG_MAX_SHADOW_CASTING_SPOTS) - 1u) << 2u;
 
-// Because we're using a uint16_t for the visibility mask, we're limited to 14 spot light shadows.
+// Because we're using a uint32_t for the visibility mask, we're limited to 30 spot light shadows.
 // (2 of the bits are used for visible renderables + directional light shadow casters).
 static_assert(CONFIG_MAX_SHADOW_CASTING_SPOTS <= sizeof(Culler::result_type) * 8 - 2,
-        "CONFIG_MAX_SHADOW_CASTING_SPOTS cannot be higher than 14.");
+        "CONFIG_MAX_SHADOW_CASTING_SPOTS cannot be higher than 30.");
 
 class ShadowMap {
 public:
@@ -91,6 +91,9 @@ public:
         // e.g., for a texture dimension of 512, shadowDimension would be 510
         uint16_t shadowDimension = 0;
 
+        // the offset of this shadow map's texture within its atlas layer, in texels
+        math::ushort2 atlasOffset = {};
+
         // This spot shadowmap index.
         uint16_t spotIndex = 0;
 
@@ -99,6 +102,10 @@ public:
 
         // polygon offset
         backend::PolygonOffset polygonOffset{};
+
+        // whether the directional light frustum is quantized, so it stays the same while the
+        // camera moves a little (used by the static shadow casters cache)
+        bool quantizeFrustum = false;
     };
 
     struct SceneInfo {
@@ -140,6 +147,12 @@ public:
             const ShadowMapInfo& shadowMapInfo, FScene const& scene,
             SceneInfo& sceneInfo) noexcept;
 
+    // Returns whether the light frustum computed by the last updateDirectional() still covers
+    // the sceneInfo.csNearFar slice of the camera's view frustum, or the whole shadow receivers
+    // volume. sceneInfo must have been updated by updateDirectional() this frame.
+    bool coversDirectional(filament::CameraInfo const& camera, float shadowFar,
+            SceneInfo const& sceneInfo) const noexcept;
+
     void render(FScene const& scene, utils::Range<uint32_t> range,
             FScene::VisibleMaskType visibilityMask, RenderPass* pass) noexcept;
 
@@ -154,6 +167,11 @@ public:
     float getTexelSizAtOneMeterWs() const noexcept { return mTexelSizeAtOneMeterWs; }
     math::float4 getLightFromWorldZ() const noexcept { return mLightFromWorldZ; }
 
+    // Returns this shadow map's rectangle in the atlas, in texture coordinates (left, bottom,
+    // right, top), excluding the 1-texel border. Shadow samples are clamped to it so that
+    // filtering never reads a neighboring shadow map. Valid after calling update().
+    math::float4 getClampToEdgeCoords() const noexcept;
+
     // Returns the light's projection. Valid after calling update().
     FCamera const& getCamera() const noexcept { return *mCamera; }
 
@@ -192,6 +210,9 @@ private:
             FrustumBoxIntersection const& wsShadowReceiverVolume, size_t vertexCount,
             const math::float3& dir);
 
+    static math::mat4f getDirectionalCullingProjection(
+            filament::CameraInfo const& camera, float shadowFar) noexcept;
+
     static inline void snapLightFrustum(math::float2& s, math::float2& o,
             math::mat4f const& Mv, math::float3 worldOrigin, math::float2 shadowMapResolution) noexcept;
 
@@ -245,6 +266,8 @@ private:
 
     static math::mat4f directionalLightFrustum(float n, float f) noexcept;
 
+    static void quantizeRange(float& lo, float& hi) noexcept;
+
     math::mat4 getTextureCoordsMapping() const noexcept;
 
     static math::mat4f computeVsmLightSpaceMatrix(const math::mat4f& lightSpacePcf,
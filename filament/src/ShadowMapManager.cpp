@@ -16,6 +16,7 @@
 
 #include "ShadowMapManager.h"
 
+#include "Culler.h"
 #include "RenderPass.h"
 #include "ShadowMap.h"
 
@@ -26,6 +27,13 @@
 
 #include <utils/debug.h>
 #include <utils/FixedCapacityVector.h>
+#include <utils/Hash.h>
+#include <utils/JobSystem.h>
+#include <utils/Systrace.h>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
 
 namespace filament {
 
@@ -52,6 +60,8 @@ ShadowMapManager::ShadowMapManager(FEngine& engine) { // NOLINT(cppcoreguideline
 void ShadowMapManager::terminate(FEngine& engine) {
     DriverApi& driver = engine.getDriverApi();
     driver.destroyBufferObject(mShadowUbh);
+    destroyStaticCache(driver);
+    destroyCascadeHistory(driver);
     UTILS_NOUNROLL
     for (auto& entry : mShadowMapCache) {
         std::launder(reinterpret_cast<ShadowMap*>(&entry))->terminate(engine);
@@ -71,7 +81,9 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::update(FEngine& engine, FVie
         FScene::RenderableSoa& renderableData, FScene::LightSoa& lightData) noexcept {
     ShadowTechnique shadowTechnique = {};
 
-    calculateTextureRequirements(engine, view, lightData);
+    calculateTextureRequirements(engine, view, cameraInfo, lightData);
+
+    updateStaticCache(engine, view, renderableData);
 
     ShadowMap::SceneInfo sceneInfo(view.getVisibleLayers());
 
@@ -85,9 +97,7 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::update(FEngine& engine, FVie
             engine, view, cameraInfo, renderableData, lightData, sceneInfo);
 
     if (mShadowUb.isDirty()) {
-        DriverApi& driver = engine.getDriverApi();
-        driver.updateBufferObject(mShadowUbh,
-                mShadowUb.toBufferDescriptor(driver), 0);
+        mShadowUb.commit(engine.getDriverApi(), mShadowUbh);
     }
 
     return shadowTechnique;
@@ -118,8 +128,7 @@ void ShadowMapManager::addSpotShadowMap(size_t lightIndex,
 FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine& engine,
         RenderPass const& pass, FView& view) noexcept {
 
-    constexpr size_t MAX_SHADOW_LAYERS =
-            CONFIG_MAX_SHADOW_CASCADES + CONFIG_MAX_SHADOW_CASTING_SPOTS;
+    constexpr size_t MAX_SHADOW_LAYERS = MAX_SHADOW_MAPS;
 
     const TextureFormat vsmTextureFormat = TextureFormat::RG16F;
 
@@ -131,6 +140,8 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine
         ShadowMapEntry const* shadowMapEntry;
         utils::Range<uint32_t> range;
         FScene::VisibleMaskType visibilityMask;
+        uint8_t index;          // index of the shadow map, cascades first (see mShadowMapCache)
+        bool fromHistory;       // copied from the cascade history instead of rendered
     };
 
     auto passList = utils::FixedCapacityVector<ShadowPass>::with_capacity(MAX_SHADOW_LAYERS);
@@ -143,12 +154,14 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine
 
     // Directional, cascaded shadowmaps
     auto const directionalShadowCastersRange = view.getVisibleDirectionalShadowCasters();
-    if (!directionalShadowCastersRange.empty()) {
-        for (const auto& map : mCascadeShadowMaps) {
-            if (map.hasVisibleShadows()) {
-                passList.push_back({
-                    &map, directionalShadowCastersRange, VISIBLE_DIR_SHADOW_RENDERABLE });
-            }
+    for (size_t i = 0, c = mCascadeShadowMaps.size(); i < c; i++) {
+        const auto& map = mCascadeShadowMaps[i];
+        // the cascades that aren't updated this frame don't need their shadow casters
+        const bool fromHistory = !(mCascadeUpdateMask & (1u << i));
+        if (map.hasVisibleShadows() && (fromHistory || !directionalShadowCastersRange.empty())) {
+            passList.push_back({
+                &map, directionalShadowCastersRange, VISIBLE_DIR_SHADOW_RENDERABLE,
+                uint8_t(i), fromHistory });
         }
     }
 
@@ -159,12 +172,13 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine
             const auto& map = mSpotShadowMaps[i];
             if (map.hasVisibleShadows()) {
                 passList.push_back({
-                    &map, spotShadowCastersRange, VISIBLE_SPOT_SHADOW_RENDERABLE_N(i) });
+                    &map, spotShadowCastersRange, VISIBLE_SPOT_SHADOW_RENDERABLE_N(i),
+                    uint8_t(CONFIG_MAX_SHADOW_CASCADES + i), false });
             }
         }
     }
 
-    assert_invariant(passList.size() <= textureRequirements.layers);
+    assert_invariant(passList.size() <= MAX_SHADOW_LAYERS);
 
     // -------------------------------------------------------------------------------------------
 
@@ -187,6 +201,87 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine
                 view.prepareShadowMap();
             });
 
+    // The depth of static shadow casters is kept across frames in its own texture, laid out like
+    // the atlas. A layer is re-rendered only when the camera or the visible static shadow casters
+    // of one of its shadow maps changed, and each shadow map is copied in the atlas before
+    // rendering the dynamic shadow casters.
+    const bool useStaticCache = bool(mStaticCache);
+    FrameGraphId<FrameGraphTexture> staticCache;
+    if (useStaticCache) {
+        const FrameGraphTexture frameGraphTexture{ .handle = mStaticCache };
+        staticCache = fg.import("Static Shadowmap Cache", {
+                .width = mStaticCacheRequirements.size, .height = mStaticCacheRequirements.size,
+                .depth = mStaticCacheRequirements.layers,
+                .type = SamplerType::SAMPLER_2D_ARRAY,
+                .format = mTextureFormat
+        }, FrameGraphTexture::Usage::DEPTH_ATTACHMENT, frameGraphTexture);
+    }
+
+    // With incremental cascade updates, the last shadow map of each cascade is kept across frames
+    // in its own texture, one layer per cascade. The cascades rendered this frame are saved in it,
+    // the others are copied from it.
+    const bool useCascadeHistory = bool(mCascadeHistory);
+    FrameGraphId<FrameGraphTexture> cascadeHistory;
+    if (useCascadeHistory) {
+        const FrameGraphTexture frameGraphTexture{ .handle = mCascadeHistory };
+        cascadeHistory = fg.import("Cascade History", {
+                .width = mCascadeHistoryKey.dimension, .height = mCascadeHistoryKey.dimension,
+                .depth = mCascadeHistoryKey.cascadeCount,
+                .type = SamplerType::SAMPLER_2D_ARRAY,
+                .format = mTextureFormat
+        }, FrameGraphTexture::Usage::DEPTH_ATTACHMENT, frameGraphTexture);
+    }
+
+    // Find the layers of the static cache that are out of date, they're re-rendered entirely.
+    uint64_t staticCacheDirtyLayers = 0;
+    if (useStaticCache) {
+        auto const& soa = scene->getRenderableData();
+        StaticCacheKeys keys{};
+        std::optional<uint32_t> directionalCastersHash;
+        for (auto const& entry : passList) {
+            if (entry.fromHistory) {
+                continue;
+            }
+            uint32_t castersHash;
+            if (entry.visibilityMask == VISIBLE_DIR_SHADOW_RENDERABLE) {
+                // all the cascades have the same shadow casters
+                if (!directionalCastersHash) {
+                    directionalCastersHash = hashStaticShadowCasters(soa,
+                            entry.range, entry.visibilityMask);
+                }
+                castersHash = *directionalCastersHash;
+            } else {
+                castersHash = hashStaticShadowCasters(soa, entry.range, entry.visibilityMask);
+            }
+
+            ShadowMapEntry const& map = *entry.shadowMapEntry;
+            ShadowMap const& shadowMap = map.getShadowMap();
+            auto const* options = map.getShadowOptions();
+            keys[entry.index] = {
+                    .projection = mat4f(shadowMap.getCamera().getProjectionMatrix()),
+                    .model = mat4f(shadowMap.getCamera().getModelMatrix()),
+                    .polygonOffset = { options->polygonOffsetConstant,
+                                       options->polygonOffsetSlope },
+                    .castersHash = castersHash,
+                    .atlasOffset = map.getAtlasOffset(),
+                    .dimension = map.getTextureDimension(),
+                    .layer = map.getLayer(),
+                    .valid = true
+            };
+        }
+        staticCacheDirtyLayers = updateStaticCacheKeys(mStaticCacheKeys, keys);
+    }
+
+    // Copies a dim x dim square between two depth render targets.
+    auto blitDepth = [](DriverApi& driver,
+            Handle<HwRenderTarget> src, ushort2 srcOffset,
+            Handle<HwRenderTarget> dst, ushort2 dstOffset, uint32_t dim) {
+        driver.blit(TargetBufferFlags::DEPTH,
+                dst, { dstOffset.x, dstOffset.y, dim, dim },
+                src, { srcOffset.x, srcOffset.y, dim, dim },
+                SamplerMagFilter::NEAREST);
+    };
+
     // -------------------------------------------------------------------------------------------
 
     const float vsmMoment2 = std::numeric_limits<half>::max();
@@ -202,9 +297,131 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine
 
     auto& ppm = engine.getPostProcessManager();
 
+    // last output of each layer, when several shadow maps share a layer, only the first pass
+    // rendering into it clears it, the following ones render on top.
+    std::array<FrameGraphId<FrameGraphTexture>, MAX_SHADOW_LAYERS> layerOutputs{};
+
+    // same for the layers of the static cache re-rendered this frame
+    std::array<FrameGraphId<FrameGraphTexture>, MAX_SHADOW_LAYERS> staticCacheLayerOutputs{};
+
     for (auto const& entry : passList) {
         const auto layer = entry.shadowMapEntry->getLayer();
         const auto* options = entry.shadowMapEntry->getShadowOptions();
+        const uint32_t dim = entry.shadowMapEntry->getTextureDimension();
+        const ushort2 offset = entry.shadowMapEntry->getAtlasOffset();
+
+        if (entry.fromHistory) {
+            assert_invariant(useCascadeHistory);
+            struct CascadeHistoryCopyPassData {
+                FrameGraphId<FrameGraphTexture> input;
+                FrameGraphId<FrameGraphTexture> output;
+            };
+            const Handle<HwRenderTarget> historyTarget = mCascadeHistoryTargets[entry.index];
+            fg.addPass<CascadeHistoryCopyPassData>("Cascade History Copy",
+                    [&](FrameGraph::Builder& builder, auto& data) {
+                        data.input = builder.createSubresource(cascadeHistory,
+                                "Cascade History Layer", { .layer = entry.index });
+                        data.input = builder.read(data.input,
+                                FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                        data.output = builder.createSubresource(prepareShadowPass->shadows,
+                                "Shadowmap Layer", { .layer = layer });
+                        data.output = builder.write(data.output,
+                                FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                        builder.declareRenderPass("Cascade History Copy RT",
+                                {{ .depth = data.output }});
+                        layerOutputs[layer] = data.output;
+                    },
+                    [=](FrameGraphResources const& resources,
+                            auto const& data, DriverApi& driver) {
+                        // the whole texture is copied, including its 1-texel border
+                        blitDepth(driver, historyTarget, {},
+                                resources.getRenderPassInfo().target, offset, dim);
+                    });
+            continue;
+        }
+
+        if (useStaticCache) {
+            if (staticCacheDirtyLayers & (uint64_t(1) << layer)) {
+                struct StaticShadowPassData {
+                    FrameGraphId<FrameGraphTexture> cache;
+                };
+                fg.addPass<StaticShadowPassData>("Static Shadow Pass",
+                        [&](FrameGraph::Builder& builder, auto& data) {
+                            // the layer is re-rendered as a whole, only the first pass clears it
+                            const bool firstInLayer = !staticCacheLayerOutputs[layer];
+                            data.cache = firstInLayer ?
+                                    builder.createSubresource(staticCache,
+                                            "Static Shadowmap Layer", { .layer = layer }) :
+                                    builder.read(staticCacheLayerOutputs[layer],
+                                            FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                            data.cache = builder.write(data.cache,
+                                    FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                            builder.declareRenderPass("Static Shadow RT", {
+                                    .attachments = { .depth = data.cache },
+                                    .clearFlags = firstInLayer ?
+                                            TargetBufferFlags::DEPTH : TargetBufferFlags::NONE });
+                            staticCacheLayerOutputs[layer] = data.cache;
+                        },
+                        [=, &engine, &view](FrameGraphResources const& resources,
+                                auto const& data, DriverApi& driver) {
+                            // same as the "Shadow Pass" below, with the static casters only
+                            ShadowMap& shadowMap = entry.shadowMapEntry->getShadowMap();
+                            const CameraInfo cameraInfo(shadowMap.getCamera());
+                            view.updatePrimitivesLod(engine, cameraInfo,
+                                    scene->getRenderableData(), entry.range);
+
+                            RenderPass entryPass(pass);
+                            entryPass.setRenderFlags(entryPass.getRenderFlags()
+                                    | RenderPass::EXCLUDE_DYNAMIC_SHADOW_CASTERS);
+                            shadowMap.render(*scene, entry.range, entry.visibilityMask, &entryPass);
+
+                            view.prepareCamera(cameraInfo);
+                            filament::Viewport viewport{
+                                    int32_t(offset.x + 1u), int32_t(offset.y + 1u),
+                                    dim - 2, dim - 2 };
+                            view.prepareViewport(viewport, 0, 0);
+                            view.commitUniforms(driver);
+
+                            auto rt = resources.getRenderPassInfo();
+                            rt.params.viewport = viewport;
+                            entryPass.getExecutor().execute("Static Shadow Pass",
+                                    rt.target, rt.params);
+                        });
+            }
+
+            struct StaticShadowCopyPassData {
+                FrameGraphId<FrameGraphTexture> input;
+                FrameGraphId<FrameGraphTexture> output;
+            };
+            const Handle<HwRenderTarget> cacheTarget = mStaticCacheTargets[layer];
+            fg.addPass<StaticShadowCopyPassData>("Static Shadow Copy",
+                    [&](FrameGraph::Builder& builder, auto& data) {
+                        data.input = staticCacheLayerOutputs[layer] ?
+                                staticCacheLayerOutputs[layer] :
+                                builder.createSubresource(staticCache,
+                                        "Static Shadowmap Layer", { .layer = layer });
+                        data.input = builder.read(data.input,
+                                FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                        // a shared layer is read first, so the other shadow maps in it are kept
+                        data.output = layerOutputs[layer] ?
+                                builder.read(layerOutputs[layer],
+                                        FrameGraphTexture::Usage::DEPTH_ATTACHMENT) :
+                                builder.createSubresource(prepareShadowPass->shadows,
+                                        "Shadowmap Layer", { .layer = layer });
+                        data.output = builder.write(data.output,
+                                FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                        builder.declareRenderPass("Static Shadow Copy RT",
+                                {{ .depth = data.output }});
+                        // the shadow pass below renders the dynamic casters on top of the copy
+                        layerOutputs[layer] = data.output;
+                    },
+                    [=](FrameGraphResources const& resources,
+                            auto const& data, DriverApi& driver) {
+                        // the whole texture is copied, including its 1-texel border
+                        blitDepth(driver, cacheTarget, offset,
+                                resources.getRenderPassInfo().target, offset, dim);
+                    });
+        }
 
         auto& shadowPass = fg.addPass<ShadowPassData>("Shadow Pass",
                 [&](FrameGraph::Builder& builder, auto& data) {
@@ -212,8 +429,16 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine
 
                     FrameGraphRenderPass::Descriptor renderTargetDesc{};
 
-                    data.output = builder.createSubresource(prepareShadowPass->shadows,
-                            "Shadowmap Layer", { .layer = layer });
+                    const bool firstInLayer = !layerOutputs[layer];
+                    if (firstInLayer) {
+                        data.output = builder.createSubresource(prepareShadowPass->shadows,
+                                "Shadowmap Layer", { .layer = layer });
+                    } else {
+                        // the layer is shared, what was rendered into it so far must be kept
+                        data.output = builder.read(layerOutputs[layer], view.hasVSM() ?
+                                FrameGraphTexture::Usage::COLOR_ATTACHMENT :
+                                FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                    }
 
                     if (view.hasVSM()) {
                         // Each shadow pass has its own sample count, but textures are created with
@@ -267,8 +492,12 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine
                         data.output = builder.write(data.output,
                                 FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
                         renderTargetDesc.attachments.depth = data.output;
-                        renderTargetDesc.clearFlags = TargetBufferFlags::DEPTH;
+                        // clearing is not restricted to the viewport, so only the first pass
+                        // in a layer can clear it.
+                        renderTargetDesc.clearFlags = firstInLayer ?
+                                TargetBufferFlags::DEPTH : TargetBufferFlags::NONE;
                     }
+                    layerOutputs[layer] = data.output;
 
                     // finally, create the shadowmap render target -- one per layer.
                     data.shadowRt = builder.declareRenderPass("Shadow RT", renderTargetDesc);
@@ -284,6 +513,11 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine
 
                     // generate and sort the commands for rendering the shadow map
                     RenderPass entryPass(pass);
+                    if (useStaticCache) {
+                        // the static casters were copied from the cache
+                        entryPass.setRenderFlags(entryPass.getRenderFlags()
+                                | RenderPass::EXCLUDE_STATIC_SHADOW_CASTERS);
+                    }
                     shadowMap.render(*scene, entry.range, entry.visibilityMask, &entryPass);
 
                     const auto& executor = entryPass.getExecutor();
@@ -301,8 +535,8 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine
                     // shadowing.fs). Unfortunately, the APIs don't seem let us clear depth
                     // attachments to anything greater than 1.0, so we'd need a way to do this other
                     // than clearing.
-                    const uint32_t dim = options->mapSize;
-                    filament::Viewport viewport{ 1, 1, dim - 2, dim - 2 };
+                    filament::Viewport viewport{
+                            int32_t(offset.x + 1u), int32_t(offset.y + 1u), dim - 2, dim - 2 };
                     view.prepareViewport(viewport, 0, 0);
 
                     view.commitUniforms(driver);
@@ -315,6 +549,37 @@ FrameGraphId<FrameGraphTexture> ShadowMapManager::render(FrameGraph& fg, FEngine
                     executor.execute("Shadow Pass", rt.target, rt.params);
                 });
 
+        // save the cascades rendered this frame in the history
+        if (useCascadeHistory && entry.index < mCascadeShadowMaps.size()) {
+            struct CascadeHistoryUpdatePassData {
+                FrameGraphId<FrameGraphTexture> input;
+                FrameGraphId<FrameGraphTexture> output;
+            };
+            const Handle<HwRenderTarget> historyTarget = mCascadeHistoryTargets[entry.index];
+            uint8_t& historyLayers = mCascadeHistoryLayers;
+            fg.addPass<CascadeHistoryUpdatePassData>("Cascade History Update",
+                    [&](FrameGraph::Builder& builder, auto& data) {
+                        data.input = builder.read(shadowPass->output,
+                                FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                        data.output = builder.createSubresource(cascadeHistory,
+                                "Cascade History Layer", { .layer = entry.index });
+                        data.output = builder.write(data.output,
+                                FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                        // the copy's source, the history layer has a render target of its own
+                        builder.declareRenderPass("Cascade History Update RT",
+                                {{ .depth = data.input }});
+                        // nothing reads the history this frame, but the next frames do
+                        builder.sideEffect();
+                    },
+                    [=, &historyLayers](FrameGraphResources const& resources,
+                            auto const& data, DriverApi& driver) {
+                        blitDepth(driver, resources.getRenderPassInfo().target, offset,
+                                historyTarget, {}, dim);
+                        // the history holds this cascade only once it's actually been copied
+                        historyLayers |= 1u << entry.index;
+                    });
+        }
+
 
         // now emit the blurring passes
         if (view.hasVSM()) {
@@ -364,9 +629,24 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateCascadeShadowMaps(FEng
             .polygonOffset = { // handle reversed Z
                     .slope    = view.hasVSM() ? 0.0f : -params.options.polygonOffsetSlope,
                     .constant = view.hasVSM() ? 0.0f : -params.options.polygonOffsetConstant
-            }
+            },
+            // the cascades follow the camera, so their static cache could never be reused
+            // unless their frusta are quantized
+            .quantizeFrustum = bool(mStaticCache)
     };
 
+#ifndef NDEBUG
+    {
+        // LISPSM debugging: initialize the near/far hints debug values from the light's options,
+        // before the cascades, which read them, are updated in parallel.
+        const float dz = cameraInfo.zf - cameraInfo.zn;
+        float& dzn = engine.debug.shadowmap.dzn;
+        float& dzf = engine.debug.shadowmap.dzf;
+        if (dzn < 0)    dzn = std::max(0.0f, params.options.shadowNearHint - cameraInfo.zn) / dz;
+        if (dzf > 0)    dzf =-std::max(0.0f, cameraInfo.zf - params.options.shadowFarHint) / dz;
+    }
+#endif
+
     if (!mCascadeShadowMaps.empty()) {
         // Even if we have more than one cascade, we cull directional shadow casters against the
         // entire camera frustum, as if we only had a single cascade.
@@ -438,19 +718,71 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateCascadeShadowMaps(FEng
     ShadowTechnique shadowTechnique{};
     uint32_t directionalShadowsMask = 0;
     uint32_t cascadeHasVisibleShadows = 0;
-    for (size_t i = 0, c = mCascadeShadowMaps.size(); i < c; i++) {
-        auto& entry = mCascadeShadowMaps[i];
 
-        // Compute the frustum for the directional light.
-        ShadowMap& shadowMap = entry.getShadowMap();
+    // With incremental updates, the first cascade is updated every frame but only one of the
+    // others is, in turn. The others keep their light frustum and reuse their last shadow map,
+    // saved in the history, unless it doesn't cover their part of the view frustum anymore.
+    // Stable shadow maps are snapped to texels, which keeps the reused cascades consistent
+    // with the ones updated this frame.
+    const uint32_t allCascades = (1u << cascadeCount) - 1u;
+    uint32_t updateMask = allCascades;
+    const bool incremental = options.incrementalCascadeUpdates && options.stable &&
+            !view.hasVSM() && cascadeCount > 1;
+    updateCascadeHistory(engine, incremental, uint16_t(options.mapSize), uint8_t(cascadeCount));
+    if (incremental) {
+        const CascadeHistoryKey key{
+                .worldOrigin = mat4f(cameraInfo.worldOrigin),
+                .direction = lightData.elementAt<FScene::DIRECTION>(0),
+                .polygonOffset = { options.polygonOffsetConstant, options.polygonOffsetSlope },
+                .constantBias = options.constantBias,
+                .dimension = uint16_t(options.mapSize),
+                .cascadeCount = uint8_t(cascadeCount),
+                .valid = true
+        };
+        if (key != mCascadeHistoryKey) {
+            mCascadeHistoryKey = key;
+            mCascadeHistoryLayers = 0;
+        }
+
+        const size_t next = mNextIncrementalCascade < cascadeCount ? mNextIncrementalCascade : 1;
+        mNextIncrementalCascade = uint8_t(next + 1 < cascadeCount ? next + 1 : 1);
+        updateMask = 0x1u | (0x1u << next) | (allCascades & ~mCascadeHistoryLayers);
+
+        for (size_t i = 1; i < cascadeCount; i++) {
+            if (!(updateMask & (1u << i))) {
+                ShadowMap::SceneInfo cascadeSceneInfo = sceneInfo;
+                cascadeSceneInfo.csNearFar = { csSplitPosition[i], csSplitPosition[i + 1] };
+                if (!mCascadeShadowMaps[i].getShadowMap().coversDirectional(
+                        cameraInfo, options.shadowFar, cascadeSceneInfo)) {
+                    updateMask |= 1u << i;
+                }
+            }
+        }
+    }
+    // the cascades updated this frame are saved in the history by the "Cascade History Update" pass
+    mCascadeHistoryLayers &= ~updateMask;
+    mCascadeUpdateMask = uint8_t(updateMask);
+
+    // Compute the frustum of each cascade, each in its own job. They only share read-only data,
+    // but each needs its own SceneInfo.
+    auto updateCascade = [&](size_t i) {
+        auto& entry = mCascadeShadowMaps[i];
         assert_invariant(entry.getLightIndex() == 0);
+        if (!(updateMask & (1u << i))) {
+            return;
+        }
 
-        sceneInfo.csNearFar = { csSplitPosition[i], csSplitPosition[i + 1] };
+        ShadowMap::SceneInfo cascadeSceneInfo = sceneInfo;
+        cascadeSceneInfo.csNearFar = { csSplitPosition[i], csSplitPosition[i + 1] };
 
-        shadowMap.updateDirectional(lightData, 0,
+        entry.getShadowMap().updateDirectional(lightData, 0,
                 cameraInfo, shadowMapInfo,
-                *scene, sceneInfo);
+                *scene, cascadeSceneInfo);
+    };
+    runShadowMapJobs(engine.getJobSystem(), mCascadeShadowMaps.size(), updateCascade);
 
+    for (size_t i = 0, c = mCascadeShadowMaps.size(); i < c; i++) {
+        ShadowMap const& shadowMap = mCascadeShadowMaps[i].getShadowMap();
         if (shadowMap.hasVisibleShadows()) {
             mShadowMappingUniforms.lightFromWorldMatrix[i] = shadowMap.getLightSpaceMatrix();
             shadowTechnique |= ShadowTechnique::SHADOW_MAP;
@@ -495,20 +827,42 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateSpotShadowMaps(FEngine
     // shadow-map shadows for point/spotlights
     ShadowTechnique shadowTechnique{};
     FScene::ShadowInfo* const shadowInfo = lightData.data<FScene::SHADOW_INFO>();
-    for (size_t i = 0, c = mSpotShadowMaps.size(); i < c; i++) {
-        auto& entry = mSpotShadowMaps[i];
+    utils::JobSystem& js = engine.getJobSystem();
+    const size_t spotCount = mSpotShadowMaps.size();
+
+    // for spotlights, we cull shadow casters first because we already know the frustum,
+    // this will help us find better near/far plane later
+    std::array<Frustum, CONFIG_MAX_SHADOW_CASTING_SPOTS> frusta;
+    for (size_t i = 0; i < spotCount; i++) {
+        const size_t lightIndex = mSpotShadowMaps[i].getLightIndex();
+        const FLightManager::Instance li = lightData.elementAt<FScene::LIGHT_INSTANCE>(lightIndex);
+        const auto position  = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).xyz;
+        const auto direction = lightData.elementAt<FScene::DIRECTION>(lightIndex);
+        const auto radius    = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).w;
+        const auto outerConeAngle = lcm.getSpotLightOuterCone(li);
 
-        // compute the frustum for this light
-        ShadowMap& shadowMap = entry.getShadowMap();
+        const mat4f Mv = ShadowMap::getDirectionalLightViewMatrix(direction, position);
+        const mat4f Mp = mat4f::perspective(outerConeAngle * f::RAD_TO_DEG * 2.0f,
+                1.0f, 0.01f, radius);
+        const mat4f MpMv(math::highPrecisionMultiply(Mp, Mv));
+        frusta[i] = Frustum(MpMv);
+    }
+
+    // Cull shadow casters
+    cullSpotShadowCasters(js, renderableData, frusta.data(), spotCount);
+
+    // Compute the frustum of each spotlight, each in its own job.
+    auto updateSpot = [&](size_t i) {
+        auto& entry = mSpotShadowMaps[i];
         const size_t lightIndex = entry.getLightIndex();
         const FLightManager::Instance li = lightData.elementAt<FScene::LIGHT_INSTANCE>(lightIndex);
-        FLightManager::ShadowParams params = lcm.getShadowParams(li);
+        FLightManager::ShadowParams const& params = lcm.getShadowParams(li);
 
-        FLightManager::ShadowOptions const* const options = entry.getShadowOptions();
         const ShadowMap::ShadowMapInfo shadowMapInfo{
                 .atlasDimension = mTextureAtlasRequirements.size,
-                .textureDimension = uint16_t(options->mapSize),
-                .shadowDimension = uint16_t(options->mapSize - 2u),
+                .textureDimension = entry.getTextureDimension(),
+                .shadowDimension = uint16_t(entry.getTextureDimension() - 2u),
+                .atlasOffset = entry.getAtlasOffset(),
                 .spotIndex = uint16_t(i),
                 .vsm = view.hasVSM(),
                 .polygonOffset = { // handle reversed Z
@@ -517,27 +871,18 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateSpotShadowMaps(FEngine
                 }
         };
 
-        // for spotlights, we cull shadow casters first because we already know the frustum,
-        // this will help us find better near/far plane later
-
-        const auto position  = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).xyz;
-        const auto direction = lightData.elementAt<FScene::DIRECTION>(lightIndex);
-        const auto radius    = lightData.elementAt<FScene::POSITION_RADIUS>(lightIndex).w;
-        const auto outerConeAngle = lcm.getSpotLightOuterCone(li);
-
-        const mat4f Mv = ShadowMap::getDirectionalLightViewMatrix(direction, position);
-        const mat4f Mp = mat4f::perspective(outerConeAngle * f::RAD_TO_DEG * 2.0f,
-                1.0f, 0.01f, radius);
-        const mat4f MpMv(math::highPrecisionMultiply(Mp, Mv));
-        const Frustum frustum(MpMv);
-
-        // Cull shadow casters
-        FView::cullRenderables(engine.getJobSystem(), renderableData, frustum,
-                VISIBLE_SPOT_SHADOW_RENDERABLE_N_BIT(i));
-
-        shadowMap.updateSpot(lightData, lightIndex,
+        ShadowMap::SceneInfo spotSceneInfo = sceneInfo;
+        entry.getShadowMap().updateSpot(lightData, lightIndex,
                 cameraInfo, shadowMapInfo,
-                *view.getScene(), sceneInfo);
+                *view.getScene(), spotSceneInfo);
+    };
+    runShadowMapJobs(js, spotCount, updateSpot);
+
+    for (size_t i = 0; i < spotCount; i++) {
+        auto const& entry = mSpotShadowMaps[i];
+        ShadowMap const& shadowMap = entry.getShadowMap();
+        const size_t lightIndex = entry.getLightIndex();
+        FLightManager::ShadowOptions const* const options = entry.getShadowOptions();
 
         if (shadowMap.hasVisibleShadows()) {
             shadowInfo[lightIndex].castsShadows = true;
@@ -546,18 +891,19 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateSpotShadowMaps(FEngine
 
             const float wsTexelSizeAtOneMeter = shadowMap.getTexelSizAtOneMeterWs();
             // note: normalBias is set to zero for VSM
-            const float normalBias = shadowMapInfo.vsm ? 0.0f : options->normalBias;
+            const float normalBias = view.hasVSM() ? 0.0f : options->normalBias;
 
-            auto& s = mShadowUb.edit();
+            auto& s = mShadowUb.itemAt(i);
             const float n = shadowMap.getCamera().getNear();
             const float f = shadowMap.getCamera().getCullingFar();
-            s.shadows[i].lightFromWorldMatrix = shadowMap.getLightSpaceMatrix();
-            s.shadows[i].direction = direction;
-            s.shadows[i].normalBias = normalBias * wsTexelSizeAtOneMeter;
-            s.shadows[i].lightFromWorldZ = shadowMap.getLightFromWorldZ();
-            s.shadows[i].texelSizeAtOneMeter = wsTexelSizeAtOneMeter;
-            s.shadows[i].nearOverFarMinusNear = n / (f - n);
-            s.shadows[i].bulbRadiusLs =
+            s.lightFromWorldMatrix = shadowMap.getLightSpaceMatrix();
+            s.direction = lightData.elementAt<FScene::DIRECTION>(lightIndex);
+            s.normalBias = normalBias * wsTexelSizeAtOneMeter;
+            s.lightFromWorldZ = shadowMap.getLightFromWorldZ();
+            s.scissorNormalized = shadowMap.getClampToEdgeCoords();
+            s.texelSizeAtOneMeter = wsTexelSizeAtOneMeter;
+            s.nearOverFarMinusNear = n / (f - n);
+            s.bulbRadiusLs =
                     mSoftShadowOptions.penumbraScale * options->shadowBulbRadius / wsTexelSizeAtOneMeter;
 
             shadowTechnique |= ShadowTechnique::SHADOW_MAP;
@@ -579,12 +925,198 @@ ShadowMapManager::ShadowTechnique ShadowMapManager::updateSpotShadowMaps(FEngine
     return shadowTechnique;
 }
 
+template<typename Functor>
+void ShadowMapManager::runShadowMapJobs(utils::JobSystem& js, size_t count,
+        Functor const& functor) noexcept {
+    if (count <= 1) {
+        if (count) {
+            functor(0);
+        }
+        return;
+    }
+    auto* parent = js.createJob();
+    for (size_t i = 0; i < count; i++) {
+        js.run(js.createJob(parent, [&functor, i](utils::JobSystem&, utils::JobSystem::Job*) {
+            functor(i);
+        }));
+    }
+    js.runAndWait(parent);
+}
+
+void ShadowMapManager::cullSpotShadowCasters(utils::JobSystem& js,
+        FScene::RenderableSoa& renderableData, Frustum const* frusta, size_t count) noexcept {
+    SYSTRACE_CALL();
+
+    float3 const* worldAABBCenter = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* worldAABBExtent = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+    FScene::VisibleMaskType* visibleArray = renderableData.data<FScene::VISIBLE_MASK>();
+
+    // Each job culls a range of renderables against all the spotlights, so that jobs never
+    // write the same visibility mask. Ranges are in multiples of Culler::MODULO renderables.
+    auto functor = [=](uint32_t start, uint32_t c) {
+        const size_t first = start * Culler::MODULO;
+        for (size_t i = 0; i < count; i++) {
+            Culler::intersects(
+                    visibleArray + first,
+                    frusta[i],
+                    worldAABBCenter + first,
+                    worldAABBExtent + first, c * Culler::MODULO,
+                    VISIBLE_SPOT_SHADOW_RENDERABLE_N_BIT(i));
+        }
+    };
+
+    const uint32_t groupCount = uint32_t(Culler::round(renderableData.size()) / Culler::MODULO);
+    if (groupCount * count <= JOBS_PARALLEL_FOR_CULLING_COUNT) {
+        // not worth the overhead of the JobSystem
+        functor(0, groupCount);
+    } else {
+        auto* job = utils::jobs::parallel_for(js, nullptr, 0, groupCount, std::cref(functor),
+                utils::jobs::CountSplitter<JOBS_PARALLEL_FOR_CULLING_COUNT / Culler::MODULO, 5>());
+        js.runAndWait(job);
+    }
+}
+
+void ShadowMapManager::updateStaticCache(FEngine& engine, FView& view,
+        FScene::RenderableSoa const& renderableData) noexcept {
+    bool hasStaticCasters = false;
+    if (!view.hasVSM()) {
+        auto const* const visibility = renderableData.data<FScene::VISIBILITY_STATE>();
+        for (size_t i = 0, c = renderableData.size(); i < c && !hasStaticCasters; i++) {
+            hasStaticCasters = visibility[i].castShadows && visibility[i].staticShadowCaster;
+        }
+    }
+
+    // the cache has the same layout as the atlas, so each shadow map only takes its own square
+    const uint16_t size = mTextureAtlasRequirements.size;
+    const uint8_t layers = mTextureAtlasRequirements.layers;
+    const bool needsCache = hasStaticCasters && layers;
+
+    DriverApi& driver = engine.getDriverApi();
+    if (mStaticCache && (!needsCache ||
+            mStaticCacheRequirements.size != size || mStaticCacheRequirements.layers != layers)) {
+        destroyStaticCache(driver);
+    }
+    if (needsCache && !mStaticCache) {
+        mStaticCache = driver.createTexture(SamplerType::SAMPLER_2D_ARRAY, 1, mTextureFormat, 1,
+                size, size, layers, TextureUsage::DEPTH_ATTACHMENT);
+        // the render targets used to copy from the cache live as long as it does
+        for (uint8_t layer = 0; layer < layers; layer++) {
+            mStaticCacheTargets[layer] = driver.createRenderTarget(TargetBufferFlags::DEPTH,
+                    size, size, 1, {}, { mStaticCache, 0, layer }, {});
+        }
+        mStaticCacheRequirements = { size, layers, 1 };
+        mStaticCacheKeys = {};
+    }
+}
+
+void ShadowMapManager::destroyStaticCache(DriverApi& driver) noexcept {
+    if (mStaticCache) {
+        for (uint8_t layer = 0; layer < mStaticCacheRequirements.layers; layer++) {
+            driver.destroyRenderTarget(mStaticCacheTargets[layer]);
+            mStaticCacheTargets[layer].clear();
+        }
+        driver.destroyTexture(mStaticCache);
+        mStaticCache.clear();
+    }
+}
+
+uint32_t ShadowMapManager::hashStaticShadowCasters(FScene::RenderableSoa const& soa,
+        utils::Range<uint32_t> range, FScene::VisibleMaskType visibilityMask) noexcept {
+    // Hash the static shadow casters, so we know when one was added, removed, moved or culled.
+    auto const* const visibility = soa.data<FScene::VISIBILITY_STATE>();
+    auto const* const visibleMasks = soa.data<FScene::VISIBLE_MASK>();
+    auto const* const instances = soa.data<FScene::RENDERABLE_INSTANCE>();
+    auto const* const transforms = soa.data<FScene::WORLD_TRANSFORM>();
+    uint32_t hash = 0;
+    for (uint32_t i : range) {
+        if ((visibleMasks[i] & visibilityMask) &&
+                visibility[i].castShadows && visibility[i].staticShadowCaster) {
+            hash = utils::hash::murmur3(
+                    reinterpret_cast<uint32_t const*>(&transforms[i]),
+                    sizeof(mat4f) / sizeof(uint32_t),
+                    hash ^ instances[i].asValue());
+        }
+    }
+    return hash;
+}
+
+bool ShadowMapManager::StaticCacheKey::operator!=(const StaticCacheKey& rhs) const noexcept {
+    auto differ = [](mat4f const& lhs, mat4f const& rhs) {
+        for (size_t i = 0; i < 4; i++) {
+            const float4 scale = max(float4(1.0f), max(abs(lhs[i]), abs(rhs[i])));
+            if (any(greaterThan(abs(lhs[i] - rhs[i]), scale * STATIC_CACHE_KEY_TOLERANCE))) {
+                return true;
+            }
+        }
+        return false;
+    };
+    return !valid || !rhs.valid ||
+           differ(projection, rhs.projection) ||
+           differ(model, rhs.model) ||
+           polygonOffset != rhs.polygonOffset ||
+           castersHash != rhs.castersHash ||
+           atlasOffset != rhs.atlasOffset ||
+           dimension != rhs.dimension ||
+           layer != rhs.layer;
+}
+
+uint64_t ShadowMapManager::updateStaticCacheKeys(StaticCacheKeys& cachedKeys,
+        StaticCacheKeys const& keys) noexcept {
+    static_assert(MAX_SHADOW_MAPS <= 64, "the dirty layers don't fit in a uint64_t");
+    uint64_t dirtyLayers = 0;
+    for (size_t i = 0; i < MAX_SHADOW_MAPS; i++) {
+        if (keys[i].valid && keys[i] != cachedKeys[i]) {
+            dirtyLayers |= uint64_t(1) << keys[i].layer;
+        }
+    }
+    for (size_t i = 0; i < MAX_SHADOW_MAPS; i++) {
+        if (keys[i].valid && (dirtyLayers & (uint64_t(1) << keys[i].layer))) {
+            // re-rendered this frame
+            cachedKeys[i] = keys[i];
+        } else if (cachedKeys[i].valid && (dirtyLayers & (uint64_t(1) << cachedKeys[i].layer))) {
+            // not rendered this frame, and its square is cleared
+            cachedKeys[i].valid = false;
+        }
+    }
+    return dirtyLayers;
+}
+
+void ShadowMapManager::updateCascadeHistory(FEngine& engine, bool enabled,
+        uint16_t dimension, uint8_t layers) noexcept {
+    DriverApi& driver = engine.getDriverApi();
+    if (mCascadeHistory && (!enabled ||
+            mCascadeHistoryKey.dimension != dimension || mCascadeHistoryKey.cascadeCount != layers)) {
+        destroyCascadeHistory(driver);
+    }
+    if (enabled && !mCascadeHistory) {
+        mCascadeHistory = driver.createTexture(SamplerType::SAMPLER_2D_ARRAY, 1, mTextureFormat, 1,
+                dimension, dimension, layers, TextureUsage::DEPTH_ATTACHMENT);
+        for (uint8_t layer = 0; layer < layers; layer++) {
+            mCascadeHistoryTargets[layer] = driver.createRenderTarget(TargetBufferFlags::DEPTH,
+                    dimension, dimension, 1, {}, { mCascadeHistory, 0, layer }, {});
+        }
+        mCascadeHistoryKey = { .dimension = dimension, .cascadeCount = layers };
+        mCascadeHistoryLayers = 0;
+    }
+}
+
+void ShadowMapManager::destroyCascadeHistory(DriverApi& driver) noexcept {
+    if (mCascadeHistory) {
+        for (uint8_t layer = 0; layer < mCascadeHistoryKey.cascadeCount; layer++) {
+            driver.destroyRenderTarget(mCascadeHistoryTargets[layer]);
+            mCascadeHistoryTargets[layer].clear();
+        }
+        driver.destroyTexture(mCascadeHistory);
+        mCascadeHistory.clear();
+    }
+}
+
 void ShadowMapManager::calculateTextureRequirements(FEngine& engine, FView& view,
-        FScene::LightSoa& lightData) noexcept {
+        CameraInfo const& cameraInfo, FScene::LightSoa& lightData) noexcept {
 
-    // Lay out the shadow maps. For now, we take the largest requested dimension and allocate a
-    // texture of that size. Each cascade / shadow map gets its own layer in the array texture.
-    // The directional shadow cascades start on layer 0, followed by spotlights.
+    // Lay out the shadow maps. We take the largest requested dimension and allocate a texture of
+    // that size. The directional shadow cascades start on layer 0, each gets its own layer.
+    // They're followed by the spotlights, which are packed in the remaining layers (see below).
     uint8_t layer = 0;
     uint32_t maxDimension = 0;
     for (auto& entry : mCascadeShadowMaps) {
@@ -592,11 +1124,73 @@ void ShadowMapManager::calculateTextureRequirements(FEngine& engine, FView& view
         auto const& options = entry.getShadowOptions();
         maxDimension = std::max(maxDimension, options->mapSize);
         entry.setLayer(layer++);
+        entry.setTextureDimension(uint16_t(options->mapSize));
+        entry.setAtlasOffset({});
     }
     for (auto& entry : mSpotShadowMaps) {
         auto const& options = entry.getShadowOptions();
         maxDimension = std::max(maxDimension, options->mapSize);
-        entry.setLayer(layer++);
+    }
+
+    if (view.hasVSM()) {
+        // VSM shadow maps are blurred and mipmapped a whole layer at a time, they can't share it.
+        for (auto& entry : mSpotShadowMaps) {
+            entry.setLayer(layer++);
+            entry.setTextureDimension(uint16_t(entry.getShadowOptions()->mapSize));
+            entry.setAtlasOffset({});
+        }
+    } else if (!mSpotShadowMaps.empty()) {
+        // Each spotlight gets a square of the atlas sized by how much of the screen the light
+        // covers, i.e. a spotlight far away or small gets a fraction of the resolution it asked
+        // for. The squares are power-of-two subdivisions of a layer, so they can be packed
+        // in a quadtree: allocating them from the largest to the smallest and walking the
+        // quadtree in Morton order guarantees that each square is aligned and that nothing
+        // overlaps.
+        constexpr size_t SUBDIVISION = MAX_ATLAS_SUBDIVISION;
+        constexpr uint32_t CELLS_PER_LAYER = 1u << (2u * SUBDIVISION);
+
+        auto const* positionRadius = lightData.data<FScene::POSITION_RADIUS>();
+        std::array<uint8_t, CONFIG_MAX_SHADOW_CASTING_SPOTS> levels; // NOLINT
+        std::array<uint8_t, CONFIG_MAX_SHADOW_CASTING_SPOTS> order; // NOLINT
+        for (size_t i = 0, c = mSpotShadowMaps.size(); i < c; i++) {
+            auto const& entry = mSpotShadowMaps[i];
+            const float coverage = getScreenCoverage(cameraInfo,
+                    positionRadius[entry.getLightIndex()]);
+            // the requested dimension acts as the light's importance, the screen coverage
+            // scales it down. Each level halves the dimension.
+            const float dimension = float(entry.getShadowOptions()->mapSize) * coverage;
+            const float ratio = float(maxDimension) / std::max(dimension, 1.0f);
+            levels[i] = uint8_t(std::clamp(int(std::floor(std::log2(ratio))),
+                    0, int(SUBDIVISION)));
+            order[i] = uint8_t(i);
+        }
+
+        std::stable_sort(order.begin(), order.begin() + mSpotShadowMaps.size(),
+                [&levels](uint8_t lhs, uint8_t rhs) { return levels[lhs] < levels[rhs]; });
+
+        // cursor in units of the smallest cell, in Morton order
+        uint32_t cursor = CELLS_PER_LAYER;
+        for (size_t i = 0, c = mSpotShadowMaps.size(); i < c; i++) {
+            auto& entry = mSpotShadowMaps[order[i]];
+            const uint32_t level = levels[order[i]];
+            const uint32_t cells = 1u << (2u * (SUBDIVISION - level));
+            if (cursor + cells > CELLS_PER_LAYER) {
+                cursor = 0;
+                layer++;
+            }
+            // de-interleave the Morton index of the square at its own level
+            const uint32_t index = cursor >> (2u * (SUBDIVISION - level));
+            uint32_t x = 0, y = 0;
+            for (uint32_t b = 0; b < level; b++) {
+                x |= ((index >> (2u * b)) & 1u) << b;
+                y |= ((index >> (2u * b + 1u)) & 1u) << b;
+            }
+            const uint32_t size = maxDimension >> level;
+            entry.setLayer(layer - 1);
+            entry.setTextureDimension(uint16_t(std::min(size, entry.getShadowOptions()->mapSize)));
+            entry.setAtlasOffset({ x * size, y * size });
+            cursor += cells;
+        }
     }
 
     const uint8_t layersNeeded = layer;
@@ -623,6 +1217,20 @@ void ShadowMapManager::calculateTextureRequirements(FEngine& engine, FView& view
     };
 }
 
+float ShadowMapManager::getScreenCoverage(CameraInfo const& cameraInfo,
+        float4 const& positionRadius) noexcept {
+    const float3 center = (cameraInfo.view * float4{ positionRadius.xyz, 1.0f }).xyz;
+    const float radius = positionRadius.w;
+    const float d2 = dot(center, center) - radius * radius;
+    if (d2 <= 0.0f) {
+        // the camera is inside the light's sphere of influence
+        return 1.0f;
+    }
+    // tangent of the sphere's angular radius, scaled to NDC (the viewport is 2 units high)
+    const float coverage = radius * std::abs(cameraInfo.projection[1][1]) / std::sqrt(d2);
+    return std::min(coverage, 1.0f);
+}
+
 ShadowMapManager::CascadeSplits::CascadeSplits(Params const& params) noexcept
         : mSplitCount(params.cascadeCount + 1) {
     for (size_t s = 0; s < mSplitCount; s++) {
@@ -34,12 +34,16 @@
 #include <backend/Handle.h>
 
 #include <utils/FixedCapacityVector.h>
+#include <utils/Range.h>
 
 #include <math/vec3.h>
 
 #include <array>
 #include <memory>
 
+// for gtest
+class FilamentTest_ShadowStaticCacheInvalidation_Test;
+
 namespace filament {
 
 class FView;
@@ -118,6 +122,8 @@ public:
     auto& getShadowUniformsHandle() const { return mShadowUbh; }
 
 private:
+    friend class ::FilamentTest_ShadowStaticCacheInvalidation_Test;
+
     ShadowMapManager::ShadowTechnique updateCascadeShadowMaps(FEngine& engine,
             FView& view, CameraInfo const& cameraInfo, FScene::RenderableSoa& renderableData,
             FScene::LightSoa& lightData, ShadowMap::SceneInfo& sceneInfo) noexcept;
@@ -126,7 +132,38 @@ private:
             FView& view, CameraInfo const& cameraInfo, FScene::RenderableSoa& renderableData,
             FScene::LightSoa& lightData, ShadowMap::SceneInfo& sceneInfo) noexcept;
 
-    void calculateTextureRequirements(FEngine& engine, FView& view, FScene::LightSoa& lightData) noexcept;
+    // Runs functor(i) for each i in [0, count), each in its own job, and waits for all of them.
+    template<typename Functor>
+    static void runShadowMapJobs(utils::JobSystem& js, size_t count,
+            Functor const& functor) noexcept;
+
+    // Culls the shadow casters of count spotlights, sets VISIBLE_SPOT_SHADOW_RENDERABLE_N_BIT(i)
+    static void cullSpotShadowCasters(utils::JobSystem& js,
+            FScene::RenderableSoa& renderableData, Frustum const* frusta, size_t count) noexcept;
+
+    // Below this many renderables times spotlights, culling is done on the calling thread.
+    static constexpr size_t JOBS_PARALLEL_FOR_CULLING_COUNT = 1024;
+
+    void updateStaticCache(FEngine& engine, FView& view,
+            FScene::RenderableSoa const& renderableData) noexcept;
+
+    void destroyStaticCache(backend::DriverApi& driver) noexcept;
+
+    // Hashes the static shadow casters in range that are visible in visibilityMask
+    static uint32_t hashStaticShadowCasters(FScene::RenderableSoa const& soa,
+            utils::Range<uint32_t> range, FScene::VisibleMaskType visibilityMask) noexcept;
+
+    void updateCascadeHistory(FEngine& engine, bool enabled,
+            uint16_t dimension, uint8_t layers) noexcept;
+
+    void destroyCascadeHistory(backend::DriverApi& driver) noexcept;
+
+    void calculateTextureRequirements(FEngine& engine, FView& view,
+            CameraInfo const& cameraInfo, FScene::LightSoa& lightData) noexcept;
+
+    // Fraction of the viewport's height covered by a light's sphere of influence, in [0, 1].
+    static float getScreenCoverage(CameraInfo const& cameraInfo,
+            math::float4 const& positionRadius) noexcept;
 
     class ShadowMapEntry {
     public:
@@ -141,6 +178,12 @@ private:
         void setLayer(uint8_t layer) noexcept { mLayer = layer; }
         uint8_t getLayer() const noexcept { return mLayer; }
 
+        // dimension of this shadow map's texture, and its offset within its layer, in texels
+        void setTextureDimension(uint16_t dimension) noexcept { mTextureDimension = dimension; }
+        uint16_t getTextureDimension() const noexcept { return mTextureDimension; }
+        void setAtlasOffset(math::ushort2 offset) noexcept { mAtlasOffset = offset; }
+        math::ushort2 getAtlasOffset() const noexcept { return mAtlasOffset; }
+
         LightManager::ShadowOptions const* getShadowOptions() const noexcept { return mOptions; }
         ShadowMap& getShadowMap() const { return *mShadowMap; }
         size_t getLightIndex() const { return mLightIndex; }
@@ -151,6 +194,8 @@ private:
         ShadowMap* mShadowMap = nullptr;
         LightManager::ShadowOptions const* mOptions = nullptr;
         uint32_t mLightIndex = 0;
+        math::ushort2 mAtlasOffset = {};
+        uint16_t mTextureDimension = 0;
         uint8_t mLayer = 0;
     };
 
@@ -191,6 +236,66 @@ private:
         size_t mSplitCount;
     };
 
+    // What the static shadow casters cache of a shadow map was rendered with, and where
+    struct StaticCacheKey {
+        math::mat4f projection;
+        math::mat4f model;
+        math::float2 polygonOffset;
+        uint32_t castersHash = 0;       // static shadow casters visible in this shadow map
+        math::ushort2 atlasOffset = {};
+        uint16_t dimension = 0;
+        uint8_t layer = 0;
+        bool valid = false;
+
+        // The matrices are recomputed each frame and can differ by a few ulps when nothing
+        // moved, they're compared with a tolerance well below the size of a texel.
+        bool operator!=(const StaticCacheKey& rhs) const noexcept;
+    };
+
+    // Relative tolerance used to compare the matrices of two StaticCacheKey
+    static constexpr float STATIC_CACHE_KEY_TOLERANCE = 1.0f / 65536.0f;
+
+    // There are as many shadow maps as there are slots in mShadowMapCache, and at most as many
+    // atlas layers as shadow maps.
+    static constexpr size_t MAX_SHADOW_MAPS =
+            CONFIG_MAX_SHADOW_CASCADES + CONFIG_MAX_SHADOW_CASTING_SPOTS;
+
+    using StaticCacheKeys = std::array<StaticCacheKey, MAX_SHADOW_MAPS>;
+
+    // Updates the keys the static cache was rendered with (one per shadow map) from the keys of
+    // the shadow maps rendered this frame (invalid for the others). The cache has the layout of
+    // the atlas and a layer can only be cleared as a whole, so a layer holding an out-of-date
+    // shadow map is re-rendered entirely: the keys of all the shadow maps rendered in it are
+    // updated, the keys of the other shadow maps it used to hold are invalidated.
+    // Returns the mask of the layers to re-render.
+    static uint64_t updateStaticCacheKeys(StaticCacheKeys& cachedKeys,
+            StaticCacheKeys const& keys) noexcept;
+
+    // What the cascades kept in the history were rendered with
+    struct CascadeHistoryKey {
+        math::mat4f worldOrigin;
+        math::float3 direction;
+        math::float2 polygonOffset;
+        float constantBias = 0.0f;
+        uint16_t dimension = 0;
+        uint8_t cascadeCount = 0;
+        bool valid = false;
+
+        bool operator!=(const CascadeHistoryKey& rhs) const {
+            return !valid || !rhs.valid ||
+                   worldOrigin != rhs.worldOrigin ||
+                   direction != rhs.direction ||
+                   polygonOffset != rhs.polygonOffset ||
+                   constantBias != rhs.constantBias ||
+                   dimension != rhs.dimension ||
+                   cascadeCount != rhs.cascadeCount;
+        }
+    };
+
+    // Spot shadow maps are packed in the atlas layers in a quadtree, a shadow map can be down to
+    // 1/2^MAX_ATLAS_SUBDIVISION of the atlas dimension.
+    static constexpr size_t MAX_ATLAS_SUBDIVISION = 3;
+
     // Atlas requirements, updated in ShadowMapManager::update(),
     // consumed in ShadowMapManager::render()
     struct TextureAtlasRequirements {
@@ -209,11 +314,28 @@ private:
     // TODO: iOS does not support the DEPTH16 texture format.
     backend::TextureFormat mTextureFormat = backend::TextureFormat::DEPTH16;
 
-    mutable TypedUniformBuffer<ShadowUib> mShadowUb;
+    // one item per spot shadow map, so only the ones that changed are uploaded
+    TypedUniformBuffer<ShadowUib::ShadowData, CONFIG_MAX_SHADOW_CASTING_SPOTS> mShadowUb;
     backend::Handle<backend::HwBufferObject> mShadowUbh;
 
     ShadowMappingUniforms mShadowMappingUniforms;
 
+    // static shadow casters cache, only used when there are static shadow casters. It has the
+    // same layout as the atlas, each layer has a render target to copy from.
+    backend::Handle<backend::HwTexture> mStaticCache;
+    std::array<backend::Handle<backend::HwRenderTarget>, MAX_SHADOW_MAPS> mStaticCacheTargets;
+    TextureAtlasRequirements mStaticCacheRequirements;
+    StaticCacheKeys mStaticCacheKeys;
+
+    // last shadow map of each cascade, only used with incremental cascade updates
+    backend::Handle<backend::HwTexture> mCascadeHistory;
+    std::array<backend::Handle<backend::HwRenderTarget>,
+            CONFIG_MAX_SHADOW_CASCADES> mCascadeHistoryTargets;
+    CascadeHistoryKey mCascadeHistoryKey;
+    uint8_t mCascadeHistoryLayers = 0;      // bit i set: the history holds cascade i
+    uint8_t mCascadeUpdateMask = 0xFF;      // bit i set: cascade i is rendered this frame
+    uint8_t mNextIncrementalCascade = 1;
+
     utils::FixedCapacityVector<ShadowMapEntry> mCascadeShadowMaps{
             utils::FixedCapacityVector<ShadowMapEntry>::with_capacity(
                     CONFIG_MAX_SHADOW_CASCADES) };
@@ -226,8 +348,7 @@ private:
     // because ShadowMap doesn't have a default ctor, and we avoid out-of-line allocations.
     // Each ShadowMap is currently 128 bytes.
     using ShadowMapStorage = std::aligned_storage<sizeof(ShadowMap), alignof(ShadowMap)>::type;
-    std::array<ShadowMapStorage,
-            CONFIG_MAX_SHADOW_CASCADES + CONFIG_MAX_SHADOW_CASTING_SPOTS> mShadowMapCache;
+    std::array<ShadowMapStorage, MAX_SHADOW_MAPS> mShadowMapCache;
 };
 
 } // namespace filament
@@ -20,10 +20,15 @@
 #include "private/backend/DriverApi.h"
 
 #include <utils/compiler.h>
+#include <utils/Range.h>
 
 #include <backend/BufferDescriptor.h>
 
+#include <algorithm>
+#include <limits>
+
 #include <stddef.h>
+#include <string.h>
 
 namespace filament {
 
@@ -31,8 +36,9 @@ template<typename T, size_t N = 1>
 class TypedUniformBuffer { // NOLINT(cppcoreguidelines-pro-type-member-init)
 public:
 
+    // invalidates item i and returns it, the whole item is uploaded by commit()
     T& itemAt(size_t i) noexcept {
-        mSomethingDirty = true;
+        invalidateUniforms(i * sizeof(T), sizeof(T));
         return mBuffer[i];
     }
 
@@ -40,14 +46,40 @@ public:
         return itemAt(0);
     }
 
+    // invalidates a single field of item i and returns it, e.g.:
+    //      buffer.editUniform(&PerViewUib::iblSH)[0] = sh;
+    template<typename M>
+    M& editUniform(M T::* field, size_t i = 0) noexcept {
+        M& uniform = mBuffer[i].*field;
+        invalidateUniforms(size_t(reinterpret_cast<char const*>(&uniform) -
+                reinterpret_cast<char const*>(mBuffer)), sizeof(M));
+        return uniform;
+    }
+
+    // sets a single field of item i, e.g.: buffer.setUniform(&PerViewUib::time, 0.5f);
+    template<typename M, typename V>
+    void setUniform(M T::* field, V const& value, size_t i = 0) noexcept {
+        editUniform(field, i) = value;
+    }
+
     // size of the uniform buffer in bytes
     size_t getSize() const noexcept { return sizeof(T) * N; }
 
     // return if any uniform has been changed
-    bool isDirty() const noexcept { return mSomethingDirty; }
+    bool isDirty() const noexcept { return mDirtyBegin < mDirtyEnd; }
+
+    // Smallest range of bytes covering all the uniforms changed since the last clean(),
+    // rounded to 16 bytes (a std140 vec4). Only valid if isDirty().
+    utils::Range<uint32_t> getDirtyRange() const noexcept {
+        return { mDirtyBegin & ~0xFu,
+                 std::min((mDirtyEnd + 0xFu) & ~0xFu, uint32_t(getSize())) };
+    }
 
     // mark the whole buffer as clean (no modified uniforms)
-    void clean() const noexcept { mSomethingDirty = false; }
+    void clean() const noexcept {
+        mDirtyBegin = std::numeric_limits<uint32_t>::max();
+        mDirtyEnd = 0;
+    }
 
     // helper functions
 
@@ -66,9 +98,27 @@ public:
         return p;
     }
 
+    // Uploads the uniforms that changed to the buffer object, and cleans the dirty bits.
+    // Must only be called if isDirty().
+    void commit(backend::DriverApi& driver,
+            backend::Handle<backend::HwBufferObject> ubh) noexcept {
+        assert_invariant(isDirty());
+        const utils::Range<uint32_t> range = getDirtyRange();
+        driver.updateBufferObject(ubh,
+                toBufferDescriptor(driver, range.first, range.size()), range.first);
+    }
+
 private:
+    void invalidateUniforms(size_t offset, size_t size) noexcept {
+        assert_invariant(offset + size <= getSize());
+        mDirtyBegin = std::min(mDirtyBegin, uint32_t(offset));
+        mDirtyEnd = std::max(mDirtyEnd, uint32_t(offset + size));
+    }
+
     T mBuffer[N];
-    mutable bool mSomethingDirty = false;
+    // range of bytes changed since the last clean(), empty if mDirtyBegin >= mDirtyEnd
+    mutable uint32_t mDirtyBegin = std::numeric_limits<uint32_t>::max();
+    mutable uint32_t mDirtyEnd = 0;
 };
 
 } // namespace filament
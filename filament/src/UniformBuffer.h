@@ -24,6 +24,7 @@
 #include <utils/Allocator.h>
 #include <utils/compiler.h>
 #include <utils/Log.h>
+#include <utils/Range.h>
 #include <utils/debug.h>
 
 #include <backend/BufferDescriptor.h>
@@ -31,6 +32,8 @@
 #include <math/mat3.h>
 #include <math/mat4.h>
 
+#include <limits>
+
 #include <stddef.h>
 #include <string.h>
 
@@ -69,7 +72,8 @@ public:
     // invalidate a range of uniforms and return a pointer to it. offset and size given in bytes
     void* invalidateUniforms(size_t offset, size_t size) {
         assert_invariant(offset + size <= mSize);
-        mSomethingDirty = true;
+        mDirtyBegin = std::min(mDirtyBegin, uint32_t(offset));
+        mDirtyEnd = std::max(mDirtyEnd, uint32_t(offset + size));
         return static_cast<char*>(mBuffer) + offset;
     }
 
@@ -84,10 +88,19 @@ public:
     size_t getSize() const noexcept { return mSize; }
 
     // return if any uniform has been changed
-    bool isDirty() const noexcept { return mSomethingDirty; }
+    bool isDirty() const noexcept { return mDirtyBegin < mDirtyEnd; }
+
+    // Smallest range of bytes covering all the uniforms changed since the last clean(),
+    // rounded to 16 bytes (a std140 vec4). Only valid if isDirty().
+    utils::Range<uint32_t> getDirtyRange() const noexcept {
+        return { mDirtyBegin & ~0xFu, std::min((mDirtyEnd + 0xFu) & ~0xFu, mSize) };
+    }
 
     // mark the whole buffer as clean (no modified uniforms)
-    void clean() const noexcept { mSomethingDirty = false; }
+    void clean() const noexcept {
+        mDirtyBegin = std::numeric_limits<uint32_t>::max();
+        mDirtyEnd = 0;
+    }
 
     /*
      * -----------------------------------------------
@@ -177,6 +190,16 @@ public:
         return p;
     }
 
+    // Uploads the uniforms that changed to the buffer object, and cleans the dirty bits.
+    // Must only be called if isDirty().
+    void commit(backend::DriverApi& driver,
+            backend::Handle<backend::HwBufferObject> ubh) const noexcept {
+        assert_invariant(isDirty());
+        const utils::Range<uint32_t> range = getDirtyRange();
+        driver.updateBufferObject(ubh,
+                toBufferDescriptor(driver, range.first, range.size()), range.first);
+    }
+
     // set uniform of known types to the proper offset (e.g.: use offsetof())
     template<size_t Size>
     void setUniformUntyped(size_t offset, void const* UTILS_RESTRICT v) noexcept;
@@ -203,7 +226,9 @@ private:
     char mStorage[96];
     void *mBuffer = nullptr;
     uint32_t mSize = 0;
-    mutable bool mSomethingDirty = false;
+    // range of bytes changed since the last clean(), empty if mDirtyBegin >= mDirtyEnd
+    mutable uint32_t mDirtyBegin = std::numeric_limits<uint32_t>::max();
+    mutable uint32_t mDirtyEnd = 0;
 };
 
 // specialization for mat3f (which has a different alignment, see std140 layout rules)
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "UniformBufferPool.h"
+
+#include "UniformBuffer.h"
+
+#include <utils/debug.h>
+
+#include <algorithm>
+
+#include <string.h>
+
+namespace filament {
+
+using namespace backend;
+
+UniformBufferPool::UniformBufferPool(size_t blockSize) noexcept
+        : mBlockSize(uint32_t(blockSize)),
+          mStride(uint32_t((blockSize + OFFSET_ALIGNMENT - 1) & ~(OFFSET_ALIGNMENT - 1))) {
+    mSlotsPerPage = std::max(1u, uint32_t(PAGE_SIZE / std::max(mStride, 1u)));
+}
+
+UniformBufferPool::~UniformBufferPool() noexcept {
+    assert_invariant(mPages.empty());
+}
+
+void UniformBufferPool::terminate(DriverApi& driver) noexcept {
+    assert_invariant(mFreeSlots.size() == mPages.size() * mSlotsPerPage);
+    for (Page const& page : mPages) {
+        driver.destroyBufferObject(page.buffer);
+    }
+    mPages.clear();
+    mFreeSlots.clear();
+}
+
+UniformBufferPool::Slot UniformBufferPool::allocate(DriverApi& driver) noexcept {
+    assert_invariant(mStride);
+    if (UTILS_UNLIKELY(mFreeSlots.empty())) {
+        const uint32_t size = mStride * mSlotsPerPage;
+        const uint32_t index = uint32_t(mPages.size());
+        Page page;
+        page.buffer = driver.createBufferObject(size,
+                BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
+        page.data.reset(new char[size]());
+        // the free list is a stack, push the slots in reverse order so that the first ones
+        // are allocated first, this helps keeping the uploads contiguous.
+        for (uint32_t i = mSlotsPerPage; i-- > 0;) {
+            mFreeSlots.push_back({ page.buffer, i * mStride, index });
+        }
+        mPages.push_back(std::move(page));
+    }
+    Slot const slot = mFreeSlots.back();
+    mFreeSlots.pop_back();
+    return slot;
+}
+
+void UniformBufferPool::free(Slot const& slot) noexcept {
+    assert_invariant(slot.page < mPages.size());
+    assert_invariant(mPages[slot.page].buffer == slot.buffer);
+    mFreeSlots.push_back(slot);
+}
+
+void UniformBufferPool::commit(DriverApi& driver, Slot const& slot,
+        UniformBuffer const& uniforms) noexcept {
+    assert_invariant(uniforms.isDirty());
+    assert_invariant(uniforms.getSize() <= mBlockSize);
+    Page& page = mPages[slot.page];
+    const utils::Range<uint32_t> range = uniforms.getDirtyRange();
+    const uint32_t begin = slot.offset + range.first;
+    const uint32_t end = slot.offset + range.last;
+    memcpy(page.data.get() + begin,
+            static_cast<char const*>(uniforms.getBuffer()) + range.first, range.size());
+    page.dirtyBegin = std::min(page.dirtyBegin, begin);
+    page.dirtyEnd = std::max(page.dirtyEnd, end);
+    uniforms.clean();
+    if (!mBatching) {
+        flush(driver, page);
+    }
+}
+
+void UniformBufferPool::endBatch(DriverApi& driver) noexcept {
+    for (Page& page : mPages) {
+        flush(driver, page);
+    }
+    mBatching = false;
+}
+
+void UniformBufferPool::flush(DriverApi& driver, Page& page) noexcept {
+    if (page.dirtyBegin < page.dirtyEnd) {
+        const uint32_t size = page.dirtyEnd - page.dirtyBegin;
+        BufferDescriptor bd(driver.allocate(size), size);
+        memcpy(bd.buffer, page.data.get() + page.dirtyBegin, size);
+        driver.updateBufferObject(page.buffer, std::move(bd), page.dirtyBegin);
+        page.dirtyBegin = UINT32_MAX;
+        page.dirtyEnd = 0;
+    }
+}
+
+} // namespace filament
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_FILAMENT_UNIFORMBUFFERPOOL_H
+#define TNT_FILAMENT_UNIFORMBUFFERPOOL_H
+
+#include "private/backend/DriverApi.h"
+
+#include <backend/Handle.h>
+
+#include <memory>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace filament {
+
+class UniformBuffer;
+
+/*
+ * Sub-allocates fixed-size blocks of uniforms from a few large buffer objects (pages), so that
+ * many small uniform buffers (e.g. the ones of material instances) don't each need their own
+ * buffer object. A block is bound with bindUniformBufferRange().
+ *
+ * Each page keeps a CPU copy of its content, commit() copies the modified uniforms of a block
+ * into it. Between beginBatch() and endBatch(), the uploads are deferred so that each page is
+ * updated at most once, with the smallest range covering all its modified blocks.
+ */
+class UniformBufferPool {
+public:
+    struct Slot {
+        backend::Handle<backend::HwBufferObject> buffer;
+        uint32_t offset = 0;
+        uint32_t page = 0;
+    };
+
+    UniformBufferPool() noexcept = default;
+
+    // all blocks can hold blockSize bytes
+    explicit UniformBufferPool(size_t blockSize) noexcept;
+
+    UniformBufferPool(UniformBufferPool const& rhs) = delete;
+    UniformBufferPool& operator=(UniformBufferPool const& rhs) = delete;
+    UniformBufferPool(UniformBufferPool&& rhs) noexcept = default;
+    UniformBufferPool& operator=(UniformBufferPool&& rhs) noexcept = default;
+
+    ~UniformBufferPool() noexcept;
+
+    // destroys all the pages, all slots must have been freed
+    void terminate(backend::DriverApi& driver) noexcept;
+
+    Slot allocate(backend::DriverApi& driver) noexcept;
+
+    void free(Slot const& slot) noexcept;
+
+    // Copies the modified uniforms into the slot and cleans them. Must only be called if
+    // uniforms.isDirty(). Outside of a batch, the page is uploaded immediately.
+    void commit(backend::DriverApi& driver, Slot const& slot,
+            UniformBuffer const& uniforms) noexcept;
+
+    void beginBatch() noexcept { mBatching = true; }
+
+    void endBatch(backend::DriverApi& driver) noexcept;
+
+    size_t getBlockSize() const noexcept { return mBlockSize; }
+
+private:
+    // Pages are kept small enough to be bindable as a whole on all backends (the minimum
+    // GL_MAX_UNIFORM_BLOCK_SIZE is 16 KiB), which also bounds the size of an upload.
+    static constexpr size_t PAGE_SIZE = 16384;
+
+    // worst-case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT and minUniformBufferOffsetAlignment
+    static constexpr size_t OFFSET_ALIGNMENT = 256;
+
+    struct Page {
+        backend::Handle<backend::HwBufferObject> buffer;
+        std::unique_ptr<char[]> data;
+        // range of bytes modified since the last upload, empty if dirtyBegin >= dirtyEnd
+        uint32_t dirtyBegin = UINT32_MAX;
+        uint32_t dirtyEnd = 0;
+    };
+
+    void flush(backend::DriverApi& driver, Page& page) noexcept;
+
+    std::vector<Page> mPages;
+    std::vector<Slot> mFreeSlots;
+    uint32_t mBlockSize = 0;
+    uint32_t mStride = 0;
+    uint32_t mSlotsPerPage = 0;
+    bool mBatching = false;
+};
+
+} // namespace filament
+
+#endif // TNT_FILAMENT_UNIFORMBUFFERPOOL_H
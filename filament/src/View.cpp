@@ -183,6 +183,14 @@ void View::setDynamicLightingOptions(float zLightNear, float zLightFar) noexcept
     upcast(this)->setDynamicLightingOptions(zLightNear, zLightFar);
 }
 
+void View::setAdaptiveDynamicLightingEnabled(bool enabled) noexcept {
+    upcast(this)->setAdaptiveDynamicLightingEnabled(enabled);
+}
+
+bool View::isAdaptiveDynamicLightingEnabled() const noexcept {
+    return upcast(this)->isAdaptiveDynamicLightingEnabled();
+}
+
 void View::setShadowType(View::ShadowType shadow) noexcept {
     upcast(this)->setShadowType(shadow);
 }
@@ -27,10 +27,13 @@
 #include <math/vec3.h>
 #include <math/vec4.h>
 
+#include <utils/Hash.h>
 #include <utils/JobSystem.h>
 #include <utils/SpinLock.h>
 #include <utils/Systrace.h>
 
+#include <algorithm>
+
 #include <math.h>
 #include <stdlib.h>
 
@@ -53,6 +56,8 @@ struct ColorGrading::BuilderDetails {
 #pragma clang diagnostic pop
 
     bool hasAdjustments = false;
+    bool defaultToneMapper = false;     // toneMapper was created from toneMapping
+    bool gpuBaking = false;
 
     // Everything below must be part of the == comparison operator
     LutFormat format = LutFormat::INTEGER;
@@ -94,7 +99,7 @@ struct ColorGrading::BuilderDetails {
     }
 
     bool operator==(const BuilderDetails &rhs) const {
-        // Note: Do NOT compare hasAdjustments and toneMapper
+        // Note: Do NOT compare hasAdjustments, toneMapper and gpuBaking
         return format == rhs.format &&
                dimension == rhs.dimension &&
                luminanceScaling == rhs.luminanceScaling &&
@@ -181,6 +186,11 @@ ColorGrading::Builder& ColorGrading::Builder::gamutMapping(bool gamutMapping) no
     return *this;
 }
 
+ColorGrading::Builder& ColorGrading::Builder::gpuBaking(bool gpuBaking) noexcept {
+    mImpl->gpuBaking = gpuBaking;
+    return *this;
+}
+
 ColorGrading::Builder& ColorGrading::Builder::exposure(float exposure) noexcept {
     mImpl->exposure = exposure;
     return *this;
@@ -282,6 +292,7 @@ ColorGrading* ColorGrading::Builder::build(Engine& engine) {
                 mImpl->toneMapper = new DisplayRangeToneMapper();
                 break;
         }
+        mImpl->defaultToneMapper = true;
     }
 
     FColorGrading* colorGrading = upcast(engine).createColorGrading(*this);
@@ -289,6 +300,7 @@ ColorGrading* ColorGrading::Builder::build(Engine& engine) {
     if (needToneMapper) {
         delete mImpl->toneMapper;
         mImpl->toneMapper = nullptr;
+        mImpl->defaultToneMapper = false;
     }
 
     return colorGrading;
@@ -609,60 +621,83 @@ static float3 selectColorGradingLuminance(ColorGrading::ToneMapping toneMapping)
 // Color grading implementation
 //------------------------------------------------------------------------------
 
-struct Config {
+// Largest LUT dimension accepted by Builder::dimensions()
+static constexpr size_t MAX_LUT_DIMENSION = 64;
+
+// Hash of the response of a tone mapper to a few colors spread over its domain. The address of
+// a ToneMapper alone doesn't identify it: it can be modified, or destroyed and its address
+// reused by a new one.
+static uint32_t hashToneMapperResponse(ToneMapper const& toneMapper) noexcept {
+    const float3 samples[] = {
+            float3{ 0.0f }, float3{ 0.001f }, float3{ 0.01f }, float3{ 0.05f }, float3{ 0.18f },
+            float3{ 0.5f }, float3{ 1.0f }, float3{ 2.0f }, float3{ 4.0f }, float3{ 16.0f },
+            float3{ 64.0f },
+            { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+            { 4.0f, 0.5f, 0.1f }, { 0.02f, 0.1f, 0.6f }
+    };
+    float3 response[sizeof(samples) / sizeof(samples[0])];
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        response[i] = toneMapper(samples[i]);
+    }
+    return hash::murmur3((uint32_t const*)response, sizeof(response) / sizeof(uint32_t), 0);
+}
+
+struct FColorGrading::Config {
     size_t lutDimension;
     mat3f  adaptationTransform;
     mat3f  colorGradingIn;
     mat3f  colorGradingOut;
     float3 colorGradingLuminance;
+    float  exposureScale;
+    bool   adjustments;
+
+    // Adjustments which are not at their neutral value. Skipping a neutral adjustment only
+    // changes the result by floating point rounding errors, far below the LUT's precision.
+    bool   exposure;
+    bool   nightAdaptation;
+    bool   whiteBalance;
+    bool   channelMixer;
+    bool   tonalRanges;
+    bool   colorDecisionList;
+    bool   contrast;
+    bool   vibrance;
+    bool   saturation;
+    bool   curves;
+
+    // LogC_to_linear() of the LUT's input values, the same for all three channels
+    float  linear[MAX_LUT_DIMENSION];
 };
 
-// Inside the FColorGrading constructor, TSAN sporadically detects a data race on the config struct;
-// the Filament thread writes and the Job thread reads. In practice there should be no data race, so
-// we force TSAN off to silence the warning.
-UTILS_NO_SANITIZE_THREAD
-FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
-    SYSTRACE_CALL();
-
-    DriverApi& driver = engine.getDriverApi();
+// Applies f() to a row of texels. Each stage of the pipeline is applied to a whole row at
+// a time, which keeps the branches selecting the stages out of the inner loops.
+template<typename F>
+UTILS_ALWAYS_INLINE
+inline void transform(float3* UTILS_RESTRICT row, size_t count, F f) noexcept {
+    for (size_t i = 0; i < count; i++) {
+        row[i] = f(row[i]);
+    }
+}
 
+// Generates the LUT described by lutConfig in data (half4), using one job per slice. When
+// converted isn't null, the LUT is also converted to UINT_2_10_10_10_REV in it.
+// Inside generateLut, TSAN sporadically detects a data race on the config struct; the Filament
+// thread writes and the Job thread reads. In practice there should be no data race, so we force
+// TSAN off to silence the warning.
+UTILS_NO_SANITIZE_THREAD
+void FColorGrading::generateLut(JobSystem& js, Config const& lutConfig, Builder const& builder,
+        void* data, void* converted) noexcept {
     Config c;
     // This lock protects the data inside Config, which is written to by the Filament thread,
     // and read from multiple Job threads.
     utils::SpinLock configLock;
     {
         std::lock_guard<utils::SpinLock> lock(configLock);
-        c.lutDimension          = builder->dimension;
-        c.adaptationTransform   = adaptationTransform(builder->whiteBalance);
-        c.colorGradingIn        = selectColorGradingTransformIn(builder->toneMapping);
-        c.colorGradingOut       = selectColorGradingTransformOut(builder->toneMapping);
-        c.colorGradingLuminance = selectColorGradingLuminance(builder->toneMapping);
+        c = lutConfig;
     }
 
-    mDimension = c.lutDimension;
-
-    size_t lutElementCount = c.lutDimension * c.lutDimension * c.lutDimension;
-    size_t elementSize = sizeof(half4);
-    void* data = malloc(lutElementCount * elementSize);
-
-    TextureFormat textureFormat;
-    PixelDataFormat format;
-    PixelDataType type;
-    selectLutTextureParams(builder->format, textureFormat, format, type);
-    assert_invariant(FTexture::validatePixelFormatAndType(textureFormat, format, type));
-
-    void* converted = nullptr;
-    if (type == PixelDataType::UINT_2_10_10_10_REV) {
-        // convert input to UINT_2_10_10_10_REV if needed
-        converted = malloc(lutElementCount * sizeof(uint32_t));
-    }
-
-    //auto now = std::chrono::steady_clock::now();
-
     // Multithreadedly generate the tone mapping 3D look-up table using 32 jobs
     // Slices are 8 KiB (128 cache lines) apart.
     // This takes about 3-6ms on Android in Release
-    JobSystem& js = engine.getJobSystem();
     auto *slices = js.createJob();
     for (size_t b = 0; b < c.lutDimension; b++) {
         auto *job = js.createJob(slices,
@@ -672,107 +707,154 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
                 std::lock_guard<utils::SpinLock> lock(configLock);
                 config = c;
             }
-            half4* UTILS_RESTRICT p = (half4*) data + b * config.lutDimension * config.lutDimension;
-            for (size_t g = 0; g < config.lutDimension; g++) {
-                for (size_t r = 0; r < config.lutDimension; r++) {
-                    float3 v = float3{r, g, b} * (1.0f / float(config.lutDimension - 1u));
+            const size_t n = config.lutDimension;
+            const float3 luminance = config.colorGradingLuminance;
 
-                    // LogC encoding
-                    v = LogC_to_linear(v);
+            // Move to color grading color space, white balance is applied in the same
+            // transform when needed
+            const mat3f colorGradingIn = config.whiteBalance ?
+                    config.adaptationTransform * config.colorGradingIn : config.colorGradingIn;
 
-                    // Kill negative values near 0.0f due to imprecision in the log conversion
-                    v = max(v, 0.0f);
+            float3 row[MAX_LUT_DIMENSION];
 
-                    if (builder->hasAdjustments) {
-                        // Exposure
-                        v = adjustExposure(v, builder->exposure);
-
-                        // Purkinje shift ("low-light" vision)
-                        v = scotopicAdaptation(v, builder->nightAdaptation);
-                    }
-
-                    // Move to color grading color space
-                    v = c.colorGradingIn * v;
+            half4* UTILS_RESTRICT p = (half4*) data + b * n * n;
+            for (size_t g = 0; g < n; g++) {
+                for (size_t r = 0; r < n; r++) {
+                    row[r] = float3{ config.linear[r], config.linear[g], config.linear[b] };
+                }
 
-                    if (builder->hasAdjustments) {
-                        // White balance
-                        v = chromaticAdaptation(v, config.adaptationTransform);
+                // Exposure
+                if (config.exposure) {
+                    const float scale = config.exposureScale;
+                    transform(row, n, [=](float3 v) { return v * scale; });
+                }
 
-                        // Kill negative values before the next transforms
-                        v = max(v, 0.0f);
+                // Purkinje shift ("low-light" vision)
+                if (config.nightAdaptation) {
+                    const float nightAdaptation = builder->nightAdaptation;
+                    transform(row, n, [=](float3 v) {
+                        return scotopicAdaptation(v, nightAdaptation);
+                    });
+                }
 
-                        // Channel mixer
-                        v = channelMixer(v, builder->outRed, builder->outGreen, builder->outBlue);
+                // Move to color grading color space (and white balance)
+                transform(row, n, [=](float3 v) { return colorGradingIn * v; });
+
+                if (config.adjustments) {
+                    // Kill negative values before the next transforms
+                    transform(row, n, [](float3 v) { return max(v, 0.0f); });
+
+                    // Channel mixer
+                    if (config.channelMixer) {
+                        const float3 outRed = builder->outRed;
+                        const float3 outGreen = builder->outGreen;
+                        const float3 outBlue = builder->outBlue;
+                        transform(row, n, [=](float3 v) {
+                            return channelMixer(v, outRed, outGreen, outBlue);
+                        });
+                    }
 
-                        // Shadows/mid-tones/highlights
-                        v = tonalRanges(v, c.colorGradingLuminance,
-                                builder->shadows, builder->midtones, builder->highlights,
-                                builder->tonalRanges);
+                    // Shadows/mid-tones/highlights
+                    if (config.tonalRanges) {
+                        const float3 shadows = builder->shadows;
+                        const float3 midtones = builder->midtones;
+                        const float3 highlights = builder->highlights;
+                        const float4 ranges = builder->tonalRanges;
+                        transform(row, n, [=](float3 v) {
+                            return tonalRanges(v, luminance, shadows, midtones, highlights, ranges);
+                        });
+                    }
 
-                        // The adjustments below behave better in log space
-                        v = linear_to_LogC(v);
+                    // The adjustments below behave better in log space
+                    if (config.colorDecisionList || config.contrast) {
+                        transform(row, n, [](float3 v) { return linear_to_LogC(v); });
 
                         // ASC CDL
-                        v = colorDecisionList(v, builder->slope, builder->offset, builder->power);
+                        if (config.colorDecisionList) {
+                            const float3 slope = builder->slope;
+                            const float3 offset = builder->offset;
+                            const float3 power = builder->power;
+                            transform(row, n, [=](float3 v) {
+                                return colorDecisionList(v, slope, offset, power);
+                            });
+                        }
 
                         // Contrast in log space
-                        v = contrast(v, builder->contrast);
+                        if (config.contrast) {
+                            const float amount = builder->contrast;
+                            transform(row, n, [=](float3 v) { return contrast(v, amount); });
+                        }
 
                         // Back to linear space
-                        v = LogC_to_linear(v);
-
-                        // Vibrance in linear space
-                        v = vibrance(v, c.colorGradingLuminance, builder->vibrance);
-
-                        // Saturation in linear space
-                        v = saturation(v, c.colorGradingLuminance, builder->saturation);
-
-                        // Kill negative values before curves
-                        v = max(v, 0.0f);
-
-                        // RGB curves
-                        v = curves(v,
-                                builder->shadowGamma, builder->midPoint, builder->highlightScale);
+                        transform(row, n, [](float3 v) { return LogC_to_linear(v); });
                     }
 
-                    // Tone mapping
-                    if (builder->luminanceScaling) {
-                        v = luminanceScaling(v, *builder->toneMapper, c.colorGradingLuminance);
-                    } else {
-                        v = (*builder->toneMapper)(v);
+                    // Vibrance in linear space
+                    if (config.vibrance) {
+                        const float amount = builder->vibrance;
+                        transform(row, n, [=](float3 v) {
+                            return vibrance(v, luminance, amount);
+                        });
                     }
 
-                    // Go back to display color space
-                    v = c.colorGradingOut * v;
+                    // Saturation in linear space
+                    if (config.saturation) {
+                        const float amount = builder->saturation;
+                        transform(row, n, [=](float3 v) {
+                            return saturation(v, luminance, amount);
+                        });
+                    }
 
-                    // Apply gamut mapping
-                    if (builder->gamutMapping) {
-                        // TODO: This should depend on the output color space
-                        v = gamutMapping_sRGB(v);
+                    // Kill negative values before curves
+                    transform(row, n, [](float3 v) { return max(v, 0.0f); });
+
+                    // RGB curves
+                    if (config.curves) {
+                        const float3 shadowGamma = builder->shadowGamma;
+                        const float3 midPoint = builder->midPoint;
+                        const float3 highlightScale = builder->highlightScale;
+                        transform(row, n, [=](float3 v) {
+                            return curves(v, shadowGamma, midPoint, highlightScale);
+                        });
                     }
+                }
 
-                    // TODO: We should convert to the output color space if we use a working
-                    //       color space that's not sRGB
-                    // TODO: Allow the user to customize the output color space
+                // Tone mapping
+                const ToneMapper& toneMapper = *builder->toneMapper;
+                if (builder->luminanceScaling) {
+                    transform(row, n, [&toneMapper, luminance](float3 v) {
+                        return luminanceScaling(v, toneMapper, luminance);
+                    });
+                } else {
+                    transform(row, n, [&toneMapper](float3 v) { return toneMapper(v); });
+                }
 
-                    // We need to clamp for the output transfer function
-                    v = saturate(v);
+                // Go back to display color space
+                const mat3f colorGradingOut = config.colorGradingOut;
+                transform(row, n, [=](float3 v) { return colorGradingOut * v; });
 
-                    // Apply OETF
-                    v = OETF_sRGB(v);
+                // Apply gamut mapping
+                if (builder->gamutMapping) {
+                    // TODO: This should depend on the output color space
+                    transform(row, n, [](float3 v) { return gamutMapping_sRGB(v); });
+                }
 
-                    *p++ = half4{v, 0.0f};
+                // TODO: We should convert to the output color space if we use a working
+                //       color space that's not sRGB
+                // TODO: Allow the user to customize the output color space
+
+                // We need to clamp for the output transfer function, then apply the OETF
+                for (size_t r = 0; r < n; r++) {
+                    *p++ = half4{ OETF_sRGB(saturate(row[r])), 0.0f };
                 }
             }
 
             if (converted) {
-                uint32_t* const UTILS_RESTRICT dst = (uint32_t*) converted +
-                        b * config.lutDimension * config.lutDimension;
-                half4* UTILS_RESTRICT src = (half4*) data +
-                        b * config.lutDimension * config.lutDimension;
+                uint32_t* const UTILS_RESTRICT dst = (uint32_t*) converted + b * n * n;
+                half4* UTILS_RESTRICT src = (half4*) data + b * n * n;
                 // we use a vectorize width of 8 because, on ARMv8 it allows the compiler to write eight
                 // 32-bits results in one go.
-                const size_t count = (config.lutDimension * config.lutDimension) & ~0x7u; // tell the compiler that we're a multiple of 8
+                const size_t count = (n * n) & ~0x7u; // tell the compiler that we're a multiple of 8
                 #pragma clang loop vectorize_width(8)
                 for (size_t i = 0; i < count; ++i) {
                     float4 v{src[i]};
@@ -787,9 +869,158 @@ FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
         js.run(job);
     }
 
+    js.runAndWait(slices);
+}
+
+FColorGrading::FColorGrading(FEngine& engine, const Builder& builder) {
+    SYSTRACE_CALL();
+
+    DriverApi& driver = engine.getDriverApi();
+    JobSystem& js = engine.getJobSystem();
+
+    Config c;
+    c.lutDimension          = builder->dimension;
+    c.adaptationTransform   = adaptationTransform(builder->whiteBalance);
+    c.colorGradingIn        = selectColorGradingTransformIn(builder->toneMapping);
+    c.colorGradingOut       = selectColorGradingTransformOut(builder->toneMapping);
+    c.colorGradingLuminance = selectColorGradingLuminance(builder->toneMapping);
+    c.exposureScale         = std::exp2(builder->exposure);
+
+    const bool adjustments  = builder->hasAdjustments;
+    c.adjustments           = adjustments;
+    c.exposure              = adjustments && builder->exposure != 0.0f;
+    c.nightAdaptation       = adjustments && builder->nightAdaptation != 0.0f;
+    c.whiteBalance          = adjustments && builder->whiteBalance != float2{0.0f};
+    c.channelMixer          = adjustments && (
+            builder->outRed   != float3{1.0f, 0.0f, 0.0f} ||
+            builder->outGreen != float3{0.0f, 1.0f, 0.0f} ||
+            builder->outBlue  != float3{0.0f, 0.0f, 1.0f});
+    c.tonalRanges           = adjustments && (
+            builder->shadows    != float3{1.0f} ||
+            builder->midtones   != float3{1.0f} ||
+            builder->highlights != float3{1.0f});
+    c.colorDecisionList     = adjustments && (
+            builder->slope  != float3{1.0f} ||
+            builder->offset != float3{0.0f} ||
+            builder->power  != float3{1.0f});
+    c.contrast              = adjustments && builder->contrast != 1.0f;
+    c.vibrance              = adjustments && builder->vibrance != 1.0f;
+    c.saturation            = adjustments && builder->saturation != 1.0f;
+    c.curves                = adjustments && (
+            builder->shadowGamma    != float3{1.0f} ||
+            builder->midPoint       != float3{1.0f} ||
+            builder->highlightScale != float3{1.0f});
+
+    // LogC encoding of the input, the negative values near 0.0f due to imprecision in
+    // the log conversion are killed
+    assert_invariant(c.lutDimension <= MAX_LUT_DIMENSION);
+    for (size_t i = 0; i < c.lutDimension; i++) {
+        float3 v{ float(i) * (1.0f / float(c.lutDimension - 1u)) };
+        c.linear[i] = max(LogC_to_linear(v), 0.0f).x;
+    }
+
+    mDimension = c.lutDimension;
+
+    size_t lutElementCount = c.lutDimension * c.lutDimension * c.lutDimension;
+    size_t elementSize = sizeof(half4);
+
+    TextureFormat textureFormat;
+    PixelDataFormat format;
+    PixelDataType type;
+    selectLutTextureParams(builder->format, textureFormat, format, type);
+    assert_invariant(FTexture::validatePixelFormatAndType(textureFormat, format, type));
+
+    // Baking renders each slice of the 3D LUT as a layer, which only the OpenGL backend supports
+    if (builder->gpuBaking && engine.getBackend() == Backend::OPENGL &&
+            driver.isRenderTargetFormatSupported(textureFormat)) {
+        // Only the tone mapping step is evaluated on the CPU, in a LUT shared with the other
+        // color gradings using the same tone mapper. That LUT is indexed by the LogC encoded
+        // color in the color grading color space, see PostProcessManager::colorGradingBake().
+        const ToneMappingLutCache::Key key{
+                .toneMapper = builder->defaultToneMapper ? nullptr : builder->toneMapper,
+                .response = hashToneMapperResponse(*builder->toneMapper),
+                .toneMapping = builder->toneMapping,
+                .luminanceScaling = builder->luminanceScaling,
+                .gamutMapping = builder->gamutMapping,
+                .dimension = uint8_t(c.lutDimension)
+        };
+
+        ToneMappingLutCache& cache = engine.getColorGradingToneMappingLuts();
+        TextureHandle toneMappingLut = cache.acquire(key);
+        if (!toneMappingLut) {
+            Config toneMapping = c;
+            toneMapping.colorGradingIn = mat3f{};
+            toneMapping.adjustments = false;
+            toneMapping.exposure = false;
+            toneMapping.nightAdaptation = false;
+            toneMapping.whiteBalance = false;
+
+            void* data = malloc(lutElementCount * sizeof(half4));
+            generateLut(js, toneMapping, builder, data, nullptr);
+
+            toneMappingLut = driver.createTexture(SamplerType::SAMPLER_3D, 1,
+                    TextureFormat::RGBA16F, 1,
+                    c.lutDimension, c.lutDimension, c.lutDimension,
+                    TextureUsage::DEFAULT);
+
+            driver.update3DImage(toneMappingLut, 0,
+                    0, 0, 0,
+                    c.lutDimension, c.lutDimension, c.lutDimension,
+                    PixelBufferDescriptor{
+                            data, lutElementCount * sizeof(half4),
+                            PixelDataFormat::RGBA, PixelDataType::HALF,
+                            [](void* buffer, size_t, void*) { free(buffer); }
+                    }
+            );
+
+            cache.add(driver, key, toneMappingLut);
+        }
+
+        mLutHandle = driver.createTexture(SamplerType::SAMPLER_3D, 1, textureFormat, 1,
+                c.lutDimension, c.lutDimension, c.lutDimension,
+                TextureUsage::COLOR_ATTACHMENT | TextureUsage::SAMPLEABLE);
+
+        // The neutral adjustments are not skipped on the GPU, they're cheap there
+        mBakeParameters = {
+                .colorGradingIn = c.whiteBalance ?
+                        c.adaptationTransform * c.colorGradingIn : c.colorGradingIn,
+                .channelMixer = transpose(mat3f{
+                        builder->outRed, builder->outGreen, builder->outBlue }),
+                .luminance = c.colorGradingLuminance,
+                .shadows = builder->shadows,
+                .midtones = builder->midtones,
+                .highlights = builder->highlights,
+                .tonalRanges = builder->tonalRanges,
+                .slope = builder->slope,
+                .offset = builder->offset,
+                .power = builder->power,
+                .shadowGamma = builder->shadowGamma,
+                .midPoint = builder->midPoint,
+                .highlightScale = builder->highlightScale,
+                .exposure = c.exposureScale,
+                .nightAdaptation = builder->nightAdaptation,
+                .contrast = builder->contrast,
+                .vibrance = builder->vibrance,
+                .saturation = builder->saturation,
+                .toneMappingLut = toneMappingLut
+        };
+        mNeedsBaking = true;
+        return;
+    }
+
+    void* data = malloc(lutElementCount * elementSize);
+
+    void* converted = nullptr;
+    if (type == PixelDataType::UINT_2_10_10_10_REV) {
+        // convert input to UINT_2_10_10_10_REV if needed
+        converted = malloc(lutElementCount * sizeof(uint32_t));
+    }
+
+    //auto now = std::chrono::steady_clock::now();
+
     // TODO: Should we do a runAndRetain() and defer the wait() + texture creation until
     //       getHwHandle() is invoked?
-    js.runAndWait(slices);
+    generateLut(js, c, builder, data, converted);
 
     //std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - now;
     //slog.d << "LUT generation time: " << duration.count() << " ms" << io::endl;
@@ -826,6 +1057,63 @@ FColorGrading::~FColorGrading() noexcept = default;
 void FColorGrading::terminate(FEngine& engine) {
     DriverApi& driver = engine.getDriverApi();
     driver.destroyTexture(mLutHandle);
+    if (mNeedsBaking) {
+        engine.getColorGradingToneMappingLuts().release(driver, mBakeParameters.toneMappingLut);
+    }
+}
+
+void FColorGrading::bake(FEngine& engine, DriverApi& driver) const noexcept {
+    assert_invariant(mNeedsBaking);
+    engine.getPostProcessManager().colorGradingBake(driver, mLutHandle, mDimension,
+            mBakeParameters);
+    // the tone mapping LUT is not needed anymore, baking is ordered before its destruction
+    engine.getColorGradingToneMappingLuts().release(driver, mBakeParameters.toneMappingLut);
+    mNeedsBaking = false;
+}
+
+//------------------------------------------------------------------------------
+// Tone mapping LUT cache
+//------------------------------------------------------------------------------
+
+TextureHandle FColorGrading::ToneMappingLutCache::acquire(Key const& key) noexcept {
+    for (Entry& entry : mEntries) {
+        if (entry.key == key) {
+            entry.references++;
+            return entry.lut;
+        }
+    }
+    return {};
+}
+
+void FColorGrading::ToneMappingLutCache::add(DriverApi& driver,
+        Key const& key, TextureHandle lut) noexcept {
+    auto const last = std::remove_if(mEntries.begin(), mEntries.end(), [&driver](Entry& entry) {
+        if (entry.references == 0) {
+            driver.destroyTexture(entry.lut);
+            return true;
+        }
+        return false;
+    });
+    mEntries.erase(last, mEntries.end());
+    mEntries.push_back({ key, lut, 1 });
+}
+
+void FColorGrading::ToneMappingLutCache::release(DriverApi& driver, TextureHandle lut) noexcept {
+    auto pos = std::find_if(mEntries.begin(), mEntries.end(),
+            [lut](Entry const& entry) { return entry.lut == lut; });
+    assert_invariant(pos != mEntries.end() && pos->references > 0);
+    if (--pos->references == 0 && pos != mEntries.end() - 1) {
+        // only the most recent LUT is kept for reuse
+        driver.destroyTexture(pos->lut);
+        mEntries.erase(pos);
+    }
+}
+
+void FColorGrading::ToneMappingLutCache::terminate(DriverApi& driver) noexcept {
+    for (Entry const& entry : mEntries) {
+        driver.destroyTexture(entry.lut);
+    }
+    mEntries.clear();
 }
 
 } //namespace filament
@@ -19,12 +19,24 @@
 
 #include "upcast.h"
 
+#include "private/backend/DriverApiForward.h"
+
 #include <backend/DriverEnums.h>
 #include <backend/Handle.h>
 
 #include <filament/ColorGrading.h>
 
-#include <math/mathfwd.h>
+#include <math/mat3.h>
+#include <math/vec3.h>
+#include <math/vec4.h>
+
+#include <vector>
+
+#include <stdint.h>
+
+namespace utils {
+class JobSystem;
+} // namespace utils
 
 namespace filament {
 
@@ -32,6 +44,72 @@ class FEngine;
 
 class FColorGrading : public ColorGrading {
 public:
+    // Parameters of the color adjustments evaluated when the LUT is baked on the GPU,
+    // see PostProcessManager::colorGradingBake()
+    struct BakeParameters {
+        math::mat3f colorGradingIn;         // includes the white balance
+        math::mat3f channelMixer;
+        math::float3 luminance;
+        math::float3 shadows;
+        math::float3 midtones;
+        math::float3 highlights;
+        math::float4 tonalRanges;
+        math::float3 slope;
+        math::float3 offset;
+        math::float3 power;
+        math::float3 shadowGamma;
+        math::float3 midPoint;
+        math::float3 highlightScale;
+        float exposure;                     // scale, i.e. exp2(exposure)
+        float nightAdaptation;
+        float contrast;
+        float vibrance;
+        float saturation;
+        // LUT of the tone mapping step, in the color grading color space, LogC encoded
+        backend::TextureHandle toneMappingLut;
+    };
+
+    /*
+     * Tone mapping LUTs of the color gradings baked on the GPU. The most recent LUT is kept so
+     * it can be reused by the next color grading built with the same tone mapper and settings,
+     * the other ones are destroyed as soon as the color gradings using them have been baked.
+     */
+    class ToneMappingLutCache {
+    public:
+        struct Key {
+            const ToneMapper* toneMapper;   // nullptr for the tone mappers owned by the builder
+            uint32_t response;              // hash of the tone mapper's response
+            ToneMapping toneMapping;
+            bool luminanceScaling;
+            bool gamutMapping;
+            uint8_t dimension;
+            bool operator==(Key const& rhs) const noexcept {
+                return toneMapper == rhs.toneMapper && response == rhs.response &&
+                       toneMapping == rhs.toneMapping &&
+                       luminanceScaling == rhs.luminanceScaling &&
+                       gamutMapping == rhs.gamutMapping && dimension == rhs.dimension;
+            }
+        };
+
+        // returns the LUT for this key and adds a reference to it, or a null handle
+        backend::TextureHandle acquire(Key const& key) noexcept;
+
+        // adds a new LUT with one reference, unreferenced LUTs are destroyed
+        void add(backend::DriverApi& driver, Key const& key, backend::TextureHandle lut) noexcept;
+
+        void release(backend::DriverApi& driver, backend::TextureHandle lut) noexcept;
+
+        void terminate(backend::DriverApi& driver) noexcept;
+
+    private:
+        struct Entry {
+            Key key;
+            backend::TextureHandle lut;
+            uint32_t references;
+        };
+        std::vector<Entry> mEntries; // the last entry is the most recent one
+    };
+
     FColorGrading(FEngine& engine, const Builder& builder);
     FColorGrading(const FColorGrading& rhs) = delete;
     FColorGrading& operator=(const FColorGrading& rhs) = delete;
@@ -45,9 +123,23 @@ public:
 
     uint32_t getDimension() const noexcept { return mDimension; }
 
+    // true when the LUT must be baked on the GPU before it can be used
+    bool needsBaking() const noexcept { return mNeedsBaking; }
+
+    // Bakes the LUT on the GPU, must be called outside of a render pass
+    void bake(FEngine& engine, backend::DriverApi& driver) const noexcept;
+
 private:
+    struct Config;
+
+    static void generateLut(utils::JobSystem& js, Config const& lutConfig, Builder const& builder,
+            void* data, void* converted) noexcept;
+
     backend::TextureHandle mLutHandle;
     uint32_t mDimension;
+    // the LUT is baked on the GPU the first time it's used
+    mutable bool mNeedsBaking = false;
+    BakeParameters mBakeParameters{};
 };
 
 FILAMENT_UPCAST(ColorGrading)
@@ -61,11 +61,12 @@ namespace filament {
 using namespace backend;
 using namespace filaflat;
 
-FEngine* FEngine::create(Backend backend, Platform* platform, void* sharedGLContext) {
+FEngine* FEngine::create(Backend backend, Platform* platform, void* sharedGLContext,
+        const Config* config) {
     SYSTRACE_ENABLE();
     SYSTRACE_CALL();
 
-    FEngine* instance = new FEngine(backend, platform, sharedGLContext);
+    FEngine* instance = new FEngine(backend, platform, sharedGLContext, config);
 
     // initialize all fields that need an instance of FEngine
     // (this cannot be done safely in the ctor)
@@ -83,7 +84,7 @@ FEngine* FEngine::create(Backend backend, Platform* platform, void* sharedGLCont
             delete instance;
             return nullptr;
         }
-        instance->mDriver = platform->createDriver(sharedGLContext);
+        instance->mDriver = platform->createDriver(sharedGLContext, instance->mDriverConfig);
     } else {
         // start the driver thread
         instance->mDriverThread = std::thread(&FEngine::loop, instance);
@@ -112,10 +113,10 @@ FEngine* FEngine::create(Backend backend, Platform* platform, void* sharedGLCont
 #if UTILS_HAS_THREADING
 
 void FEngine::createAsync(CreateCallback callback, void* user,
-        Backend backend, Platform* platform, void* sharedGLContext) {
+        Backend backend, Platform* platform, void* sharedGLContext, const Config* config) {
     SYSTRACE_ENABLE();
     SYSTRACE_CALL();
-    FEngine* instance = new FEngine(backend, platform, sharedGLContext);
+    FEngine* instance = new FEngine(backend, platform, sharedGLContext, config);
 
     // start the driver thread
     instance->mDriverThread = std::thread(&FEngine::loop, instance);
@@ -167,10 +168,12 @@ static constexpr float4 sFullScreenTriangleVertices[3] = {
 // these must be static because only a pointer is copied to the render stream
 static const uint16_t sFullScreenTriangleIndices[3] = { 0, 1, 2 };
 
-FEngine::FEngine(Backend backend, Platform* platform, void* sharedGLContext) :
+FEngine::FEngine(Backend backend, Platform* platform, void* sharedGLContext,
+        const Config* config) :
         mBackend(backend),
         mPlatform(platform),
         mSharedGLContext(sharedGLContext),
+        mDriverConfig(getDriverConfig(config)),
         mPostProcessManager(*this),
         mEntityManager(EntityManager::get()),
         mRenderableManager(*this),
@@ -193,6 +196,19 @@ FEngine::FEngine(Backend backend, Platform* platform, void* sharedGLContext) :
            << "(threading is " << (UTILS_HAS_THREADING ? "enabled)" : "disabled)") << io::endl;
 }
 
+Platform::DriverConfig FEngine::getDriverConfig(const Config* config) noexcept {
+    Platform::DriverConfig driverConfig{};
+    if (config) {
+        driverConfig.handleArenaSize = size_t(config->driverHandleArenaSizeMB) * 1024u * 1024u;
+        for (size_t i = 0; i < 3; i++) {
+            ASSERT_PRECONDITION(config->driverHandlePoolSizes[i] > 0,
+                    "Engine::Config::driverHandlePoolSizes must not be 0");
+            driverConfig.handlePoolSizes[i] = config->driverHandlePoolSizes[i];
+        }
+    }
+    return driverConfig;
+}
+
 uint32_t FEngine::getJobSystemThreadPoolSize() noexcept {
     // 1 thread for the user, 1 thread for the backend
     int threadCount = (int)std::thread::hardware_concurrency() - 2;
@@ -398,6 +414,7 @@ void FEngine::shutdown() {
     cleanupResourceList(std::move(mScenes));
     cleanupResourceList(std::move(mSkyboxes));
     cleanupResourceList(std::move(mColorGradings));
+    mColorGradingToneMappingLuts.terminate(driver);
 
     // this must be done after Skyboxes and before materials
     destroy(mSkyboxMaterial);
@@ -409,10 +426,11 @@ void FEngine::shutdown() {
     cleanupResourceList(std::move(mVertexBuffers));
     cleanupResourceList(std::move(mTextures));
     cleanupResourceList(std::move(mRenderTargets));
-    cleanupResourceList(std::move(mMaterials));
+    // instances must go first, they return their uniforms to their material
     for (auto& item : mMaterialInstances) {
         cleanupResourceList(std::move(item.second));
     }
+    cleanupResourceList(std::move(mMaterials));
 
     cleanupResourceListLocked(mFenceListLock, std::move(mFences));
 
@@ -466,9 +484,14 @@ void FEngine::prepare() {
     FEngine::DriverApi& driver = getDriverApi();
 
     for (auto& materialInstanceList: mMaterialInstances) {
+        // batch the uploads, so each page of the material's shared uniform buffer is updated
+        // at most once
+        UniformBufferPool& pool = materialInstanceList.first->getUniformPool();
+        pool.beginBatch();
         materialInstanceList.second.forEach([&driver](FMaterialInstance* item) {
             item->commit(driver);
         });
+        pool.endBatch(driver);
     }
 
     // Commit default material instances.
@@ -582,7 +605,7 @@ int FEngine::loop() {
     JobSystem::setThreadName("FEngine::loop");
     JobSystem::setThreadPriority(JobSystem::Priority::DISPLAY);
 
-    mDriver = mPlatform->createDriver(mSharedGLContext);
+    mDriver = mPlatform->createDriver(mSharedGLContext, mDriverConfig);
     mDriverBarrier.latch();
     if (UTILS_UNLIKELY(!mDriver)) {
         // if we get here, it's because the driver couldn't be initialized and the problem has
@@ -21,6 +21,7 @@
 
 #include "Allocators.h"
 #include "DFG.h"
+#include "FrameStats.h"
 #include "PostProcessManager.h"
 #include "ResourceList.h"
 
@@ -130,15 +131,18 @@ public:
     static constexpr size_t CONFIG_PER_FRAME_COMMANDS_SIZE      = filament::CONFIG_PER_FRAME_COMMANDS_SIZE;
     static constexpr size_t CONFIG_MIN_COMMAND_BUFFERS_SIZE     = filament::CONFIG_MIN_COMMAND_BUFFERS_SIZE;
     static constexpr size_t CONFIG_COMMAND_BUFFERS_SIZE         = filament::CONFIG_COMMAND_BUFFERS_SIZE;
+    static constexpr size_t CONFIG_FRAMES_IN_FLIGHT             = filament::CONFIG_FRAMES_IN_FLIGHT;
 
 public:
     static FEngine* create(Backend backend = Backend::DEFAULT,
-            Platform* platform = nullptr, void* sharedGLContext = nullptr);
+            Platform* platform = nullptr, void* sharedGLContext = nullptr,
+            const Config* config = nullptr);
 
 #if UTILS_HAS_THREADING
     static void createAsync(CreateCallback callback, void* user,
             Backend backend = Backend::DEFAULT,
-            Platform* platform = nullptr, void* sharedGLContext = nullptr);
+            Platform* platform = nullptr, void* sharedGLContext = nullptr,
+            const Config* config = nullptr);
 
     static FEngine* getEngine(void* token);
 #endif
@@ -168,6 +172,10 @@ public:
     const FIndirectLight* getDefaultIndirectLight() const noexcept { return mDefaultIbl; }
     const FTexture* getDummyCubemap() const noexcept { return mDefaultIblTexture; }
     const FColorGrading* getDefaultColorGrading() const noexcept { return mDefaultColorGrading; }
+
+    FColorGrading::ToneMappingLutCache& getColorGradingToneMappingLuts() noexcept {
+        return mColorGradingToneMappingLuts;
+    }
     FMorphTargetBuffer* getDummyMorphTargetBuffer() const { return mDummyMorphTargetBuffer; }
 
     backend::Handle<backend::HwRenderPrimitive> getFullScreenRenderPrimitive() const noexcept {
@@ -231,6 +239,11 @@ public:
         return *mResourceAllocator;
     }
 
+    ResourceAllocator const& getResourceAllocator() const noexcept {
+        assert_invariant(mResourceAllocator);
+        return *mResourceAllocator;
+    }
+
     void* streamAlloc(size_t size, size_t alignment) noexcept;
 
     Epoch getEngineEpoch() const { return mEngineEpoch; }
@@ -336,6 +349,10 @@ public:
         return mDebugRegistry;
     }
 
+    FrameStats& getFrameStats() noexcept {
+        return mFrameStats;
+    }
+
     bool execute();
 
     utils::JobSystem& getJobSystem() noexcept {
@@ -357,7 +374,9 @@ public:
     backend::Handle<backend::HwTexture> getOneIntegerTextureArray() const { return mDummyOneIntegerTextureArray; }
 
 private:
-    FEngine(Backend backend, Platform* platform, void* sharedGLContext);
+    FEngine(Backend backend, Platform* platform, void* sharedGLContext, const Config* config);
+
+    static Platform::DriverConfig getDriverConfig(const Config* config) noexcept;
     void init();
     void shutdown();
 
@@ -383,6 +402,7 @@ private:
     Platform* mPlatform = nullptr;
     bool mOwnPlatform = false;
     void* mSharedGLContext = nullptr;
+    const Platform::DriverConfig mDriverConfig;
     backend::Handle<backend::HwRenderPrimitive> mFullScreenTriangleRph;
     FVertexBuffer* mFullScreenTriangleVb = nullptr;
     FIndexBuffer* mFullScreenTriangleIb = nullptr;
@@ -449,6 +469,7 @@ private:
     mutable FIndirectLight* mDefaultIbl = nullptr;
 
     mutable FColorGrading* mDefaultColorGrading = nullptr;
+    FColorGrading::ToneMappingLutCache mColorGradingToneMappingLuts;
     FMorphTargetBuffer* mDummyMorphTargetBuffer = nullptr;
 
     mutable utils::CountDownLatch mDriverBarrier;
@@ -456,6 +477,7 @@ private:
     mutable filaflat::ShaderBuilder mVertexShaderBuilder;
     mutable filaflat::ShaderBuilder mFragmentShaderBuilder;
     FDebugRegistry mDebugRegistry;
+    FrameStats mFrameStats;
 
     backend::Handle<backend::HwTexture> mDummyOneTexture;
     backend::Handle<backend::HwTexture> mDummyOneTextureArray;
@@ -489,6 +511,9 @@ public:
             // When set to true, the backend will attempt to capture the next frame and write the
             // capture to file. At the moment, only supported by the Metal backend.
             bool doFrameCapture = false;
+            // When set to true, the CPU time spent in each stage of the frames is recorded,
+            // see FrameStats.
+            bool frameStats = false;
         } renderer;
         matdbg::DebugServer* server = nullptr;
     } debug;
@@ -307,6 +307,10 @@ FMaterial::FMaterial(FEngine& engine, const Material::Builder& builder)
 
     // we can only initialize the default instance once we're initialized ourselves
     mDefaultInstance.initDefaultInstance(engine, this);
+
+    if (!mUniformInterfaceBlock.isEmpty()) {
+        mUniformPool = UniformBufferPool(mUniformInterfaceBlock.getSize());
+    }
 }
 
 FMaterial::~FMaterial() noexcept {
@@ -325,6 +329,7 @@ void FMaterial::terminate(FEngine& engine) {
 
     destroyPrograms(engine);
     mDefaultInstance.terminate(engine);
+    mUniformPool.terminate(engine.getDriverApi());
 }
 
 FMaterialInstance* FMaterial::createInstance(const char* name) const noexcept {
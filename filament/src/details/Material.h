@@ -19,6 +19,8 @@
 
 #include "upcast.h"
 
+#include "UniformBufferPool.h"
+
 #include "details/MaterialInstance.h"
 
 #include <filament/Material.h>
@@ -77,6 +79,9 @@ public:
 
     FEngine& getEngine() const noexcept  { return mEngine; }
 
+    // shared storage for the uniforms of all instances except the default one
+    UniformBufferPool& getUniformPool() const noexcept { return mUniformPool; }
+
     // prepareProgram creates the program for the material's given variant at the backend level.
     // Must be called outside of backend render pass.
     // Must be called before getProgram() below.
@@ -220,6 +225,7 @@ private:
     bool mSpecularAntiAliasing = false;
 
     FMaterialInstance mDefaultInstance;
+    mutable UniformBufferPool mUniformPool;
     SamplerInterfaceBlock mSamplerInterfaceBlock;
     UniformInterfaceBlock mUniformInterfaceBlock;
     SubpassInfo mSubpassInfo;
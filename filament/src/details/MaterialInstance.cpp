@@ -52,9 +52,10 @@ FMaterialInstance::FMaterialInstance(FEngine& engine,
     FMaterial const* const material = other->getMaterial();
 
     if (!material->getUniformInterfaceBlock().isEmpty()) {
+        // instances share their material's uniform pages, default instances keep their own
+        // buffer because they're often updated in the middle of a frame (e.g. post-processing).
         mUniforms.setUniforms(other->getUniformBuffer());
-        mUbHandle = driver.createBufferObject(mUniforms.getSize(),
-                BufferObjectBinding::UNIFORM, backend::BufferUsage::DYNAMIC);
+        mUbSlot = material->getUniformPool().allocate(driver);
     }
 
     if (!material->getSamplerInterfaceBlock().isEmpty()) {
@@ -123,14 +124,22 @@ FMaterialInstance::~FMaterialInstance() noexcept = default;
 
 void FMaterialInstance::terminate(FEngine& engine) {
     FEngine::DriverApi& driver = engine.getDriverApi();
-    driver.destroyBufferObject(mUbHandle);
+    if (mUbSlot.buffer) {
+        mMaterial->getUniformPool().free(mUbSlot);
+    } else {
+        driver.destroyBufferObject(mUbHandle);
+    }
     driver.destroySamplerGroup(mSbHandle);
 }
 
 void FMaterialInstance::commitSlow(DriverApi& driver) const {
     // update uniforms if needed
     if (mUniforms.isDirty()) {
-        driver.updateBufferObject(mUbHandle, mUniforms.toBufferDescriptor(driver), 0);
+        if (mUbSlot.buffer) {
+            mMaterial->getUniformPool().commit(driver, mUbSlot, mUniforms);
+        } else {
+            mUniforms.commit(driver, mUbHandle);
+        }
     }
     if (mSamplers.isDirty()) {
         driver.updateSamplerGroup(mSbHandle, std::move(mSamplers.toCommandStream()));
@@ -19,6 +19,7 @@
 
 #include "upcast.h"
 #include "UniformBuffer.h"
+#include "UniformBufferPool.h"
 #include "details/Engine.h"
 
 #include "private/backend/DriverApi.h"
@@ -54,7 +55,10 @@ public:
     }
 
     void use(FEngine::DriverApi& driver) const {
-        if (mUbHandle) {
+        if (mUbSlot.buffer) {
+            driver.bindUniformBufferRange(BindingPoints::PER_MATERIAL_INSTANCE,
+                    mUbSlot.buffer, mUbSlot.offset, mUniforms.getSize());
+        } else if (mUbHandle) {
             driver.bindUniformBuffer(BindingPoints::PER_MATERIAL_INSTANCE, mUbHandle);
         }
         if (mSbHandle) {
@@ -67,6 +71,7 @@ public:
     uint64_t getSortingKey() const noexcept { return mMaterialSortingKey; }
 
     UniformBuffer const& getUniformBuffer() const noexcept { return mUniforms; }
+    UniformBufferPool::Slot const& getUniformBufferSlot() const noexcept { return mUbSlot; }
     backend::SamplerGroup const& getSamplerGroup() const noexcept { return mSamplers; }
 
     void setScissor(int32_t left, int32_t bottom, uint32_t width, uint32_t height) noexcept {
@@ -155,6 +160,7 @@ private:
     FMaterial const* mMaterial = nullptr;
     backend::Handle<backend::HwBufferObject> mUbHandle;
     backend::Handle<backend::HwSamplerGroup> mSbHandle;
+    UniformBufferPool::Slot mUbSlot;    // only used by non-default instances
 
     UniformBuffer mUniforms;
     backend::SamplerGroup mSamplers;
@@ -53,9 +53,14 @@ namespace filament {
 
 using namespace backend;
 
+static_assert(FEngine::CONFIG_FRAMES_IN_FLIGHT <= FrameSkipper::MAX_FRAME_LATENCY,
+        "FrameSkipper can't track that many frames in flight");
+static_assert(FEngine::CONFIG_FRAMES_IN_FLIGHT <= FrameInfoManager::POOL_COUNT,
+        "FrameInfoManager needs one timer query per frame in flight");
+
 FRenderer::FRenderer(FEngine& engine) :
         mEngine(engine),
-        mFrameSkipper(1u),
+        mFrameSkipper(FEngine::CONFIG_FRAMES_IN_FLIGHT - 1u),
         mRenderTargetHandle(engine.getDefaultRenderTarget()),
         mFrameInfoManager(engine.getDriverApi()),
         mHdrTranslucent(TextureFormat::RGBA16F),
@@ -68,6 +73,10 @@ FRenderer::FRenderer(FEngine& engine) :
     FDebugRegistry& debugRegistry = engine.getDebugRegistry();
     debugRegistry.registerProperty("d.renderer.doFrameCapture",
             &engine.debug.renderer.doFrameCapture);
+    debugRegistry.registerProperty("d.renderer.frameStats",
+            &engine.debug.renderer.frameStats);
+    debugRegistry.registerDataSource("d.renderer.frameStats",
+            engine.getFrameStats().getPublished(), 1);
 
     DriverApi& driver = engine.getDriverApi();
 
@@ -208,6 +217,12 @@ bool FRenderer::beginFrame(FSwapChain* swapChain, uint64_t vsyncSteadyClockTimeN
         driver.startCapture();
     }
 
+    // frame stats are only enabled or disabled between frames
+    FrameStats& frameStats = engine.getFrameStats();
+    if (UTILS_UNLIKELY(engine.debug.renderer.frameStats != frameStats.isEnabled())) {
+        frameStats.setEnabled(engine.debug.renderer.frameStats);
+    }
+
     // latch the frame time
     std::chrono::duration<double> time(appVsync - mUserEpoch);
     float h = float(time.count());
@@ -302,6 +317,10 @@ void FRenderer::endFrame() {
         engine.debug.renderer.doFrameCapture = false;
     }
 
+    if (UTILS_UNLIKELY(engine.getFrameStats().isEnabled())) {
+        engine.getFrameStats().publish();
+    }
+
     // do this before engine.flush()
     engine.getResourceAllocator().gc();
 
@@ -636,6 +655,41 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
     variant.setFog(view.hasFog());
     variant.setVsm(view.hasShadowing() && view.getShadowType() != ShadowType::PCF);
 
+    // load the post-processing materials and programs this frame needs up-front, rather than
+    // while the FrameGraph executes
+    const bool hasVsm = view.needsShadowMap() && view.hasVSM();
+    const VsmShadowOptions vsmShadowOptions = view.getVsmShadowOptions();
+    ppm.prepare({
+            .ssao = aoOptions.enabled,
+            .ssaoBentNormals = aoOptions.bentNormals,
+            .ssr = ssReflectionsOptions.enabled,
+            .refraction = view.isScreenSpaceRefractionEnabled(),
+            .contactShadows = scene.hasContactShadows(),
+            .vsm = hasVsm,
+            .vsmMipmap = hasVsm &&
+                    (vsmShadowOptions.anisotropy > 0 || vsmShadowOptions.mipmapping),
+            .taa = taaOptions.enabled,
+            .dof = dofOptions.enabled,
+            .bloom = bloomOptions.enabled,
+            .flare = bloomOptions.lensFlare,
+            .colorGrading = hasColorGrading,
+            .colorGradingAsSubpass = colorGradingConfig.asSubpass,
+            .colorGradingBake = hasColorGrading && colorGrading->needsBaking(),
+            .customResolve = colorGradingConfig.customResolve,
+            .fxaa = hasFXAA,
+            .upscale = scaled,
+            .translucent = needsAlphaChannel,
+            .blending = blendModeTranslucent,
+            .dofOptions = dofOptions,
+            .dsrOptions = dsrOptions
+    });
+
+    // a color grading LUT baked on the GPU is baked the first time it's used, the per-view
+    // uniforms it needs are bound by now
+    if (hasColorGrading && colorGrading->needsBaking()) {
+        colorGrading->bake(engine, driver);
+    }
+
     /*
      * Frame graph
      */
@@ -730,6 +784,13 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
     pass.setCamera(cameraInfo);
     pass.setGeometry(scene.getRenderableData(), view.getVisibleRenderables(), scene.getRenderableUBO());
 
+    // The structure buffer is shared by SSAO, SSR, contact shadows and picking. Only SSAO can
+    // run at quarter resolution, the other effects need at least half the resolution.
+    const bool structureNeedsHalfRes = ssReflectionsOptions.enabled ||
+            config.hasContactShadows || view.hasPicking();
+    const float structureScale = structureNeedsHalfRes ?
+            std::max(0.5f, aoOptions.resolution) : aoOptions.resolution;
+
     // view set-ups that need to happen before rendering
     fg.addTrivialSideEffectPass("Prepare View Uniforms",
             [=, &uniforms = view.getPerViewUniforms()](DriverApi& driver) {
@@ -738,7 +799,7 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
                 // The code here is a little fragile. In theory, we need to call prepareViewport()
                 // for each render pass, because the viewport parameters depend on the resolution.
                 // However, in practice, we only have two resolutions: the color pass resolution,
-                // and the structure pass which is governed by aoOptions.resolution (this could
+                // and the structure pass which is governed by structureScale (this could
                 // change in the future).
                 // So here we set the parameters for the structure pass and SSAO passes which
                 // are always done first. The SSR pass will also use these parameters which
@@ -754,8 +815,8 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
                 // currently only used for generating noise, so it's not too bad.
 
                 uniforms.prepareViewport(svp,
-                        xvp.left   * aoOptions.resolution,
-                        xvp.bottom * aoOptions.resolution);
+                        xvp.left   * structureScale,
+                        xvp.bottom * structureScale);
 
                 uniforms.commit(driver);
             });
@@ -765,9 +826,8 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
     // Currently it consists of a simple depth pass.
     // This is normally used by SSAO and contact-shadows
 
-    // TODO: the scaling should depends on all passes that need the structure pass
     const auto [structure, picking_] = ppm.structure(fg, pass, renderFlags, svp.width, svp.height, {
-            .scale = aoOptions.resolution,
+            .scale = structureScale,
             .picking = view.hasPicking()
     });
     blackboard["structure"] = structure;
@@ -790,7 +850,7 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
                 [=, &view](FrameGraphResources const& resources,
                         auto const& data, DriverApi& driver) mutable {
                     auto out = resources.getRenderPassInfo();
-                    view.executePickingQueries(driver, out.target, aoOptions.resolution);
+                    view.executePickingQueries(driver, out.target, structureScale);
                 });
     }
 
@@ -829,7 +889,8 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
                 view.getPerViewUniforms(),
                 structure,
                 ssReflectionsOptions,
-                { .width = svp.width, .height = svp.height });
+                { .width  = uint32_t(float(svp.width ) * ssReflectionsOptions.resolution),
+                  .height = uint32_t(float(svp.height) * ssReflectionsOptions.resolution) });
 
         // generate the mipchain
         reflections = PostProcessManager::generateMipmapSSR(ppm, fg,
@@ -1056,11 +1117,15 @@ void FRenderer::renderJob(ArenaScope& arena, FView& view) {
 
     fg.present(fgViewRenderTarget);
 
-    fg.compile();
+    {
+        FrameStats::Scope stageScope(engine.getFrameStats(), FrameStats::Stage::EXECUTE);
+
+        fg.compile(&mFrameGraphCache);
 
-    //fg.export_graphviz(slog.d, view.getName());
+        //fg.export_graphviz(slog.d, view.getName());
 
-    fg.execute(driver);
+        fg.execute(driver);
+    }
 
     // save the current history entry and destroy the oldest entry
     view.commitFrameHistory(engine);
@@ -31,6 +31,7 @@
 
 #include <fg/FrameGraphId.h>
 #include <fg/FrameGraphTexture.h>
+#include <fg/details/DependencyGraph.h>
 
 #include <filament/Renderer.h>
 #include <filament/Viewport.h>
@@ -180,6 +181,10 @@ private:
     tsl::robin_set<FRenderTarget*> mPreviousRenderTargets;
     std::function<void()> mBeginFrameInternal;
 
+    // the structure of the FrameGraph rarely changes between frames, this lets compile() skip
+    // culling in most frames.
+    DependencyGraph::CullingCache mFrameGraphCache;
+
     // per-frame arena for this Renderer
     LinearAllocatorArena& mPerRenderPassArena;
 };
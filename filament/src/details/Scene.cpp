@@ -149,7 +149,6 @@ void FScene::prepare(const mat4& worldOriginTransform, bool shadowReceiversAreCa
                     worldAABB.halfExtent,           // WORLD_AABB_EXTENT
                     {},                             // PRIMITIVES
                     0,                              // SUMMED_PRIMITIVE_COUNT
-                    {},                             // UBO
                     scale                           // USER_DATA
             );
         }
@@ -200,99 +199,153 @@ void FScene::prepare(const mat4& worldOriginTransform, bool shadowReceiversAreCa
     }
 }
 
-void FScene::prepareVisibleRenderables(Range<uint32_t> visibleRenderables) noexcept {
+void FScene::updateUBOs(
+        Range<uint32_t> visibleRenderables,
+        Handle<HwBufferObject> renderableUbh,
+        FixedCapacityVector<PerRenderableData>& uboData) noexcept {
+    FEngine::DriverApi& driver = mEngine.getDriverApi();
     RenderableSoa& sceneData = mRenderableData;
     FRenderableManager& rcm = mEngine.getRenderableManager();
 
+    // store the UBO handle
+    mRenderableViewUbh = renderableUbh;
+
+    // uboData holds what the UBO currently contains for its first validCount renderables,
+    // only the renderables that don't match are uploaded.
+    assert_invariant(visibleRenderables.last <= uboData.capacity());
+    const size_t validCount = uboData.size();
+    if (uboData.size() < visibleRenderables.last) {
+        uboData.resize(visibleRenderables.last);
+    }
+
+    // dirty ranges of renderables, the last one grows when we run out
+    static constexpr size_t MAX_DIRTY_RANGES = 16;
+    Range<uint32_t> dirtyRanges[MAX_DIRTY_RANGES];
+    size_t dirtyRangeCount = 0;
+
     mHasContactShadows = false;
     for (uint32_t i : visibleRenderables) {
-        PerRenderableData& uboData = sceneData.elementAt<UBO>(i);
-
         auto const visibility = sceneData.elementAt<VISIBILITY_STATE>(i);
         auto const& model = sceneData.elementAt<WORLD_TRANSFORM>(i);
         auto const ri = sceneData.elementAt<RENDERABLE_INSTANCE>(i);
+        PerRenderableData& ubo = uboData[i];
+        const bool valid = i < validCount;
 
-        // Using mat3f::getTransformForNormals handles non-uniform scaling, but DOESN'T guarantee that
-        // the transformed normals will have unit-length, therefore they need to be normalized
-        // in the shader (that's already the case anyway, since normalization is needed after
-        // interpolation).
-        //
-        // We pre-scale normals by the inverse of the largest scale factor to avoid
-        // large post-transform magnitudes in the shader, especially in the fragment shader, where
-        // we use medium precision.
-        //
-        // Note: if the model matrix is known to be a rigid-transform, we could just use it directly.
-
-        mat3f m = mat3f::getTransformForNormals(model.upperLeft());
-        m *= mat3f(1.0f / std::sqrt(max(float3{length2(m[0]), length2(m[1]), length2(m[2])})));
-
-        // The shading normal must be flipped for mirror transformations.
-        // Basically we're shading the other side of the polygon and therefore need to negate the
-        // normal, similar to what we already do to support double-sided lighting.
-        if (visibility.reversedWindingOrder) {
-            m = -m;
-        }
-
-        uboData.worldFromModelMatrix = model;
-
-        uboData.worldFromModelNormalMatrix = m;
+        mHasContactShadows = mHasContactShadows || visibility.screenSpaceContactShadows;
 
-        uboData.flagsChannels = PerRenderableData::packFlagsChannels(
+        const uint32_t flagsChannels = PerRenderableData::packFlagsChannels(
                 visibility.skinning,
                 visibility.morphing,
                 visibility.screenSpaceContactShadows,
                 sceneData.elementAt<CHANNELS>(i));
-
-        uboData.morphTargetCount = sceneData.elementAt<MORPHING_BUFFER>(i).count;
-
-        uboData.objectId = rcm.getEntity(ri).getId();
-
+        const uint32_t morphTargetCount = sceneData.elementAt<MORPHING_BUFFER>(i).count;
+        const uint32_t objectId = rcm.getEntity(ri).getId();
         // TODO: We need to find a better way to provide the scale information per object
-        uboData.userData = sceneData.elementAt<USER_DATA>(i);
+        const float userData = sceneData.elementAt<USER_DATA>(i);
+
+        // the normal matrix (and the winding order) only depend on the model matrix
+        const bool sameModel = valid && ubo.worldFromModelMatrix == model;
+        if (sameModel &&
+                ubo.flagsChannels == flagsChannels &&
+                ubo.morphTargetCount == morphTargetCount &&
+                ubo.objectId == objectId &&
+                ubo.userData == userData) {
+            continue;
+        }
 
-        mHasContactShadows = mHasContactShadows || visibility.screenSpaceContactShadows;
-    }
-}
+        if (!sameModel) {
+            // Using mat3f::getTransformForNormals handles non-uniform scaling, but DOESN'T
+            // guarantee that the transformed normals will have unit-length, therefore they need
+            // to be normalized in the shader (that's already the case anyway, since normalization
+            // is needed after interpolation).
+            //
+            // We pre-scale normals by the inverse of the largest scale factor to avoid
+            // large post-transform magnitudes in the shader, especially in the fragment shader,
+            // where we use medium precision.
+            //
+            // Note: if the model matrix is known to be a rigid-transform, we could just use it
+            // directly.
+
+            mat3f m = mat3f::getTransformForNormals(model.upperLeft());
+            m *= mat3f(1.0f / std::sqrt(max(float3{length2(m[0]), length2(m[1]), length2(m[2])})));
+
+            // The shading normal must be flipped for mirror transformations.
+            // Basically we're shading the other side of the polygon and therefore need to negate
+            // the normal, similar to what we already do to support double-sided lighting.
+            if (visibility.reversedWindingOrder) {
+                m = -m;
+            }
 
-void FScene::updateUBOs(
-        Range<uint32_t> visibleRenderables,
-        Handle<HwBufferObject> renderableUbh) noexcept {
-    FEngine::DriverApi& driver = mEngine.getDriverApi();
+            ubo.worldFromModelMatrix = model;
+            ubo.worldFromModelNormalMatrix = m;
+        }
+        ubo.flagsChannels = flagsChannels;
+        ubo.morphTargetCount = morphTargetCount;
+        ubo.objectId = objectId;
+        ubo.userData = userData;
+
+        if (dirtyRangeCount && dirtyRanges[dirtyRangeCount - 1].last == i) {
+            dirtyRanges[dirtyRangeCount - 1].last = i + 1;
+        } else if (dirtyRangeCount < MAX_DIRTY_RANGES) {
+            dirtyRanges[dirtyRangeCount++] = { i, i + 1 };
+        } else {
+            dirtyRanges[dirtyRangeCount - 1].last = i + 1;
+        }
+    }
 
-    // store the UBO handle
-    mRenderableViewUbh = renderableUbh;
+    size_t dirtyCount = 0;
+    for (size_t r = 0; r < dirtyRangeCount; r++) {
+        dirtyCount += dirtyRanges[r].size();
+    }
 
     // don't allocate more than 16 KiB directly into the render stream
     static constexpr size_t MAX_STREAM_ALLOCATION_COUNT = 64;   // 16 KiB
-    const size_t count = visibleRenderables.size();
-    PerRenderableData* buffer = [&]{
-        if (count >= MAX_STREAM_ALLOCATION_COUNT) {
-            // use the heap allocator
-            return (PerRenderableData*)mBufferPoolAllocator.get(count * sizeof(PerRenderableData));
+    auto upload = [&](Range<uint32_t> range, bool unsynchronized) {
+        // uboData can change before the driver consumes the data, so it's copied
+        const size_t count = range.size();
+        PerRenderableData* buffer = [&]{
+            if (count >= MAX_STREAM_ALLOCATION_COUNT) {
+                // use the heap allocator
+                return (PerRenderableData*)mBufferPoolAllocator.get(
+                        count * sizeof(PerRenderableData));
+            } else {
+                // allocate space into the command stream directly
+                return driver.allocatePod<PerRenderableData>(count);
+            }
+        }();
+        std::copy_n(uboData.data() + range.first, count, buffer);
+
+        BufferDescriptor bd{
+                buffer, count * sizeof(PerRenderableData),
+                +[](void* p, size_t s, void* user) {
+                    if (s >= MAX_STREAM_ALLOCATION_COUNT * sizeof(PerRenderableData)) {
+                        FScene* const that = static_cast<FScene*>(user);
+                        that->mBufferPoolAllocator.put(p);
+                    }
+                }, this
+        };
+        const uint32_t byteOffset = range.first * sizeof(PerRenderableData);
+        if (unsynchronized) {
+            driver.updateBufferObjectUnsynchronized(renderableUbh, std::move(bd), byteOffset);
         } else {
-            // allocate space into the command stream directly
-            return driver.allocatePod<PerRenderableData>(count);
+            driver.updateBufferObject(renderableUbh, std::move(bd), byteOffset);
+        }
+    };
+
+    if (dirtyCount * 2 > visibleRenderables.size()) {
+        // most renderables changed (e.g. the first frame, or the camera moved which reorders
+        // them), orphan the UBO and upload all of them.
+        driver.resetBufferObject(renderableUbh);
+        upload(visibleRenderables, true);
+        // orphaning discarded whatever was past the visible renderables
+        uboData.resize(visibleRenderables.last);
+    } else {
+        // the UBO may still be in use by the GPU, the ranges must be synchronized
+        for (size_t r = 0; r < dirtyRangeCount; r++) {
+            upload(dirtyRanges[r], false);
         }
-    }();
-
-    // copy our data into the UBO for each visible renderable
-    PerRenderableData const* const uboData = mRenderableData.data<UBO>();
-    for (uint32_t i : visibleRenderables) {
-        buffer[i] = uboData[i];
     }
 
-    // update the UBO
-    driver.resetBufferObject(renderableUbh);
-    driver.updateBufferObjectUnsynchronized(renderableUbh, {
-            buffer, count * sizeof(PerRenderableData),
-            +[](void* p, size_t s, void* user) {
-                if (s >= MAX_STREAM_ALLOCATION_COUNT * sizeof(PerRenderableData)) {
-                    FScene* const that = static_cast<FScene*>(user);
-                    that->mBufferPoolAllocator.put(p);
-                }
-            }, this
-    }, 0);
-
     // update skybox
     if (mSkybox) {
         mSkybox->commit(driver);
@@ -33,6 +33,7 @@
 
 #include <utils/compiler.h>
 #include <utils/Entity.h>
+#include <utils/FixedCapacityVector.h>
 #include <utils/Slice.h>
 #include <utils/StructureOfArrays.h>
 #include <utils/Range.h>
@@ -71,8 +72,6 @@ public:
 
     void prepare(const math::mat4& worldOriginTransform, bool shadowReceiversAreCasters) noexcept;
 
-    void prepareVisibleRenderables(utils::Range<uint32_t> visibleRenderables) noexcept;
-
     void prepareDynamicLights(const CameraInfo& camera, ArenaScope& arena,
             backend::Handle<backend::HwBufferObject> lightUbh) noexcept;
 
@@ -93,7 +92,7 @@ public:
         SKINNING_BUFFER,        //   8 | bones uniform buffer handle, offset
         MORPHING_BUFFER,        //  16 | weights uniform buffer handle, count, morph targets
         WORLD_AABB_CENTER,      //  12 | world-space bounding box center of the renderable
-        VISIBLE_MASK,           //   2 | each bit represents a visibility in a pass
+        VISIBLE_MASK,           //   4 | each bit represents a visibility in a pass
         CHANNELS,               //   1 | currently light channels only
         INSTANCE_COUNT,         //   2 | draw instance count
 
@@ -104,7 +103,6 @@ public:
         // These are temporaries and should be stored out of line
         PRIMITIVES,             //   8 | level-of-detail'ed primitives
         SUMMED_PRIMITIVE_COUNT, //   4 | summed visible primitive counts
-        UBO,                    // 128 |
 
         // FIXME: We need a better way to handle this
         USER_DATA,              //   4 | user data currently used to store the scale
@@ -124,7 +122,6 @@ public:
             math::float3,                               // WORLD_AABB_EXTENT
             utils::Slice<FRenderPrimitive>,             // PRIMITIVES
             uint32_t,                                   // SUMMED_PRIMITIVE_COUNT
-            PerRenderableData,                          // UBO
             // FIXME: We need a better way to handle this
             float                                       // USER_DATA
     >;
@@ -179,7 +176,12 @@ public:
     LightSoa const& getLightData() const noexcept { return mLightData; }
     LightSoa& getLightData() noexcept { return mLightData; }
 
-    void updateUBOs(utils::Range<uint32_t> visibleRenderables, backend::Handle<backend::HwBufferObject> renderableUbh) noexcept;
+    // Computes the per-renderable uniforms of the visible renderables and uploads the ones that
+    // changed to renderableUbh. uboData is the caller's copy of renderableUbh's content, it must
+    // be emptied when renderableUbh is (re)allocated and have the same capacity.
+    void updateUBOs(utils::Range<uint32_t> visibleRenderables,
+            backend::Handle<backend::HwBufferObject> renderableUbh,
+            utils::FixedCapacityVector<PerRenderableData>& uboData) noexcept;
 
     bool hasContactShadows() const noexcept;
 
@@ -53,9 +53,6 @@ namespace filament {
 using namespace backend;
 using namespace math;
 
-static constexpr float PID_CONTROLLER_Ki = 0.002f;
-static constexpr float PID_CONTROLLER_Kd = 0.0f;
-
 FView::FView(FEngine& engine)
     : mFroxelizer(engine),
       mPerViewUniforms(engine),
@@ -67,12 +64,6 @@ FView::FView(FEngine& engine)
     debugRegistry.registerProperty("d.view.camera_at_origin",
             &engine.debug.view.camera_at_origin);
 
-    // Integral term is used to fight back the dead-band below, we limit how much it can act.
-    mPidController.setIntegralLimits(-100.0f, 100.0f);
-
-    // dead-band, 1% for scaling down, 5% for scaling up. This stabilizes all the jitters.
-    mPidController.setOutputDeadBand(-0.01f, 0.05f);
-
 #ifndef NDEBUG
     debugRegistry.registerDataSource("d.view.frame_info",
             mDebugFrameHistory.data(), mDebugFrameHistory.size());
@@ -81,9 +72,9 @@ FView::FView(FEngine& engine)
     debugRegistry.registerProperty("d.view.pid.kd", &engine.debug.view.pid.kd);
     // default parameters for debugging UI
     engine.debug.view.pid.kp = 1.0f - std::exp(-1.0f / 8.0f);
-    engine.debug.view.pid.ki = PID_CONTROLLER_Ki;
-    engine.debug.view.pid.kd = PID_CONTROLLER_Kd;
-    mPidController.setParallelGains(
+    engine.debug.view.pid.ki = PIDResolutionController::DEFAULT_Ki;
+    engine.debug.view.pid.kd = PIDResolutionController::DEFAULT_Kd;
+    mPidController.setGains(
             engine.debug.view.pid.kp, engine.debug.view.pid.ki, engine.debug.view.pid.kd);
 #endif
 
@@ -148,9 +139,18 @@ void FView::setDynamicResolutionOptions(DynamicResolutionOptions const& options)
 }
 
 void FView::setDynamicLightingOptions(float zLightNear, float zLightFar) noexcept {
+    mZLightNear = zLightNear;
+    mZLightFar = zLightFar;
     mFroxelizer.setOptions(zLightNear, zLightFar);
 }
 
+void FView::setAdaptiveDynamicLightingEnabled(bool enabled) noexcept {
+    mAdaptiveDynamicLighting = enabled;
+    if (!enabled) {
+        mFroxelizer.setOptions(mZLightNear, mZLightFar);
+    }
+}
+
 float2 FView::updateScale(FEngine& engine,
         FrameInfo const& info,
         Renderer::FrameRateOptions const& frameRateOptions,
@@ -170,69 +170,35 @@ float2 FView::updateScale(FEngine& engine,
         const float Kd = engine.debug.view.pid.kd;
 #else
         const float Kp = (1.0f - std::exp(-frameRateOptions.scaleRate));
-        const float Ki = PID_CONTROLLER_Ki;
-        const float Kd = PID_CONTROLLER_Kd;
+        const float Ki = PIDResolutionController::DEFAULT_Ki;
+        const float Kd = PIDResolutionController::DEFAULT_Kd;
 #endif
-        mPidController.setParallelGains(Kp, Ki, Kd);
+        mPidController.setGains(Kp, Ki, Kd);
+
+        DynamicResolutionController& controller =
+                options.controller == DynamicResolutionOptions::Controller::PREDICTIVE ?
+                static_cast<DynamicResolutionController&>(mPredictiveController) : mPidController;
 
         // all values in ms below
         using std::chrono::duration;
-        const float dt = 1.0f; // we don't really need dt here, setting it to 1, means our parameters are in "frames"
         const float target = (1000.0f * float(frameRateOptions.interval)) / displayInfo.refreshRate;
         const float targetWithHeadroom = target * (1.0f - frameRateOptions.headRoomRatio);
-        float measured = duration<float, std::milli>{ info.denoisedFrameTime }.count();
-        float out = mPidController.update(measured / targetWithHeadroom, 1.0f, dt);
-
-        // maps pid command to a scale (absolute or relative, see below)
-         const float command = out < 0.0f ? (1.0f / (1.0f - out)) : (1.0f + out);
-
-        /*
-         * There is two ways we can control the scale factor, either by having the PID controller
-         * output a new scale factor directly (like a "position" control), or having it evaluate
-         * a relative scale factor (like a "velocity" control).
-         * More experimentation is needed to figure out which works better in more cases.
-         */
-
-        // direct scaling ("position" control)
-        //const float scale = command;
-        // relative scaling ("velocity" control)
-        const float scale = mScale.x * mScale.y * command;
-
-        const float w = float(mViewport.width);
-        const float h = float(mViewport.height);
-        if (scale < 1.0f && !options.homogeneousScaling) {
-            // figure out the major and minor axis
-            const float major = std::max(w, h);
-            const float minor = std::min(w, h);
-
-            // the major axis is scaled down first, down to the minor axis
-            const float maxMajorScale = minor / major;
-            const float majorScale = std::max(scale, maxMajorScale);
-
-            // then the minor axis is scaled down to the original aspect-ratio
-            const float minorScale = std::max(scale / majorScale, majorScale * maxMajorScale);
-
-            // if we have some scaling capacity left, scale homogeneously
-            const float homogeneousScale = scale / (majorScale * minorScale);
-
-            // finally, write the scale factors
-            float& majorRef = w > h ? mScale.x : mScale.y;
-            float& minorRef = w > h ? mScale.y : mScale.x;
-            majorRef = std::sqrt(homogeneousScale) * majorScale;
-            minorRef = std::sqrt(homogeneousScale) * minorScale;
-        } else {
-            // when scaling up, we're always using homogeneous scaling.
-            mScale = std::sqrt(scale);
-        }
+        const float scale = controller.update({
+                .gpuFrameTime = duration<float, std::milli>{ info.denoisedFrameTime }.count(),
+                .cpuFrameTime = duration<float, std::milli>{ info.denoisedCpuFrameTime }.count(),
+                .target = targetWithHeadroom,
+                .scaleRate = frameRateOptions.scaleRate,
+                // the timer queries are read up to POOL_COUNT frames late, and the median
+                // filter needs half its history to reflect a change.
+                .latency = uint32_t(frameRateOptions.history / 2u + FrameInfoManager::POOL_COUNT)
+        }, mScale.x * mScale.y);
+
+        const float2 s = DynamicResolutionController::getAxisScale(scale,
+                float(mViewport.width), float(mViewport.height), options.homogeneousScaling);
 
         // always clamp to the min/max scale range
-        const auto s = mScale;
         mScale = clamp(s, options.minScale, options.maxScale);
-
-        // disable the integration term when we're outside the controllable range
-        // (i.e. we clamped). This help not to have to wait too long for the Integral term
-        // to kick in after a clamping event.
-        mPidController.setIntegralInhibitionEnabled(mScale != s);
+        controller.setSaturated(mScale != s);
     } else {
         mScale = 1.0f;
     }
@@ -249,10 +215,11 @@ float2 FView::updateScale(FEngine& engine,
             .targetWithHeadroom = targetWithHeadroom,
             .frameTime          = std::chrono::duration_cast<duration_ms>(info.frameTime).count(),
             .frameTimeDenoised  = std::chrono::duration_cast<duration_ms>(info.denoisedFrameTime).count(),
+            .cpuFrameTime       = std::chrono::duration_cast<duration_ms>(info.cpuFrameTime).count(),
             .scale              = mScale.x * mScale.y,
-            .pid_e              = mPidController.getError(),
-            .pid_i              = mPidController.getIntegral(),
-            .pid_d              = mPidController.getDerivative()
+            .pid_e              = mPidController.getPIDController().getError(),
+            .pid_i              = mPidController.getPIDController().getIntegral(),
+            .pid_d              = mPidController.getPIDController().getDerivative()
     };
 #endif
 
@@ -431,6 +398,7 @@ void FView::prepare(FEngine& engine, DriverApi& driver, ArenaScope& arena,
         float4 const& userTime, bool needsAlphaChannel) noexcept {
 
     JobSystem& js = engine.getJobSystem();
+    FrameStats& frameStats = engine.getFrameStats();
 
     /*
      * Prepare the scene -- this is where we gather all the objects added to the scene,
@@ -461,7 +429,10 @@ void FView::prepare(FEngine& engine, DriverApi& driver, ArenaScope& arena,
      * Gather all information needed to render this scene. Apply the world origin to all
      * objects in the scene.
      */
-    scene->prepare(cameraInfo.worldOrigin, hasVSM());
+    {
+        FrameStats::Scope stageScope(frameStats, FrameStats::Stage::SCENE_PREPARE);
+        scene->prepare(cameraInfo.worldOrigin, hasVSM());
+    }
 
     /*
      * Light culling: runs in parallel with Renderable culling (below)
@@ -489,19 +460,26 @@ void FView::prepare(FEngine& engine, DriverApi& driver, ArenaScope& arena,
          * (this will set the VISIBLE_RENDERABLE bit)
          */
 
-        prepareVisibleRenderables(js, cullingFrustum, renderableData);
+        {
+            // lights culling runs concurrently, its time is accounted for while we wait for it
+            FrameStats::Scope stageScope(frameStats, FrameStats::Stage::CULLING);
+            prepareVisibleRenderables(js, cullingFrustum, renderableData);
 
+            // prepareShadowing relies on prepareVisibleLights().
+            if (prepareVisibleLightsJob) {
+                js.waitAndRelease(prepareVisibleLightsJob);
+            }
+        }
 
         /*
          * Shadowing: compute the shadow camera and cull shadow casters
          * (this will set the VISIBLE_DIR_SHADOW_CASTER bit and VISIBLE_SPOT_SHADOW_CASTER bits)
          */
 
-        // prepareShadowing relies on prepareVisibleLights().
-        if (prepareVisibleLightsJob) {
-            js.waitAndRelease(prepareVisibleLightsJob);
+        {
+            FrameStats::Scope stageScope(frameStats, FrameStats::Stage::SHADOWS);
+            prepareShadowing(engine, driver, renderableData, scene->getLightData(), cameraInfo);
         }
-        prepareShadowing(engine, driver, renderableData, scene->getLightData(), cameraInfo);
 
         /*
          * Partition the SoA so that renderables are partitioned w.r.t their visibility into the
@@ -522,6 +500,8 @@ void FView::prepare(FEngine& engine, DriverApi& driver, ArenaScope& arena,
          * of sort(), which gives us O(4.N) instead of O(N.log(N)) application of swap().
          */
 
+        FrameStats::Scope partitionStageScope(frameStats, FrameStats::Stage::CULLING);
+
         // calculate the sorting key for all elements, based on their visibility
         uint8_t const* layers = renderableData.data<FScene::LAYERS>();
         auto const* visibility = renderableData.data<FScene::VISIBILITY_STATE>();
@@ -546,25 +526,33 @@ void FView::prepare(FEngine& engine, DriverApi& driver, ArenaScope& arena,
         mVisibleDirectionalShadowCasters = Range{ uint32_t(beginCasters - beginRenderables), iEnd };
         mSpotLightShadowCasters = Range{ 0, iSpotLightCastersEnd };
         merged = Range{ 0, iSpotLightCastersEnd };
+    }
 
-        scene->prepareVisibleRenderables(merged);
+    { // gather the visible renderables' data and update their UBOs
+        FrameStats::Scope stageScope(frameStats, FrameStats::Stage::SCENE_PREPARE);
 
         // update those UBOs
         const size_t size = merged.size() * sizeof(PerRenderableData);
-        if (size) {
-            if (mRenderableUBOSize < size) {
-                // allocate 1/3 extra, with a minimum of 16 objects
-                const size_t count = std::max(size_t(16u), (4u * merged.size() + 2u) / 3u);
-                mRenderableUBOSize = uint32_t(count * sizeof(PerRenderableData));
-                driver.destroyBufferObject(mRenderableUbh);
-                mRenderableUbh = driver.createBufferObject(mRenderableUBOSize,
-                        BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
-            } else {
-                // TODO: should we shrink the underlying UBO at some point?
-            }
-            assert_invariant(mRenderableUbh);
-            scene->updateUBOs(merged, mRenderableUbh);
+        if (mRenderableUBOSize < size) {
+            // allocate 1/3 extra, with a minimum of 16 objects
+            const size_t count = std::max(size_t(16u), (4u * merged.size() + 2u) / 3u);
+            mRenderableUBOSize = uint32_t(count * sizeof(PerRenderableData));
+            driver.destroyBufferObject(mRenderableUbh);
+            mRenderableUbh = driver.createBufferObject(mRenderableUBOSize,
+                    BufferObjectBinding::UNIFORM, BufferUsage::DYNAMIC);
+            // the new UBO's content is undefined
+            mRenderableUboData = FixedCapacityVector<PerRenderableData>::with_capacity(count);
+        } else {
+            // TODO: should we shrink the underlying UBO at some point?
         }
+        assert_invariant(!size || mRenderableUbh);
+        scene->updateUBOs(merged, mRenderableUbh, mRenderableUboData);
+    }
+
+    // fit the froxel slices to the visible geometry, this must happen before prepareLighting()
+    if (mAdaptiveDynamicLighting &&
+            scene->getLightData().size() > FScene::DIRECTIONAL_LIGHTS_COUNT) {
+        updateAdaptiveDynamicLighting(cameraInfo.view, renderableData);
     }
 
     /*
@@ -620,14 +608,14 @@ void FView::computeVisibilityMasks(
         const bool visShadowRenderable = (!v.culling || (mask & VISIBLE_DIR_SHADOW_RENDERABLE))
                 && inVisibleLayer && visShadowParticipant;
         visibleMask[i] = Culler::result_type(visRenderables) |
-                Culler::result_type(visShadowRenderable << 1u);
+                (Culler::result_type(visShadowRenderable) << 1u);
         // this loop gets fully unrolled
         for (size_t j = 0; j < CONFIG_MAX_SHADOW_CASTING_SPOTS; ++j) {
             const bool visSpotShadowRenderable =
                     (!v.culling || (mask & VISIBLE_SPOT_SHADOW_RENDERABLE_N(j))) &&
                         inVisibleLayer && visShadowParticipant;
             visibleMask[i] |=
-                Culler::result_type(visSpotShadowRenderable << VISIBLE_SPOT_SHADOW_RENDERABLE_N_BIT(j));
+                Culler::result_type(visSpotShadowRenderable) << VISIBLE_SPOT_SHADOW_RENDERABLE_N_BIT(j);
         }
     }
 }
@@ -712,6 +700,7 @@ void FView::cleanupRenderPasses() const noexcept {
 
 void FView::froxelize(FEngine& engine, mat4f const& viewMatrix) const noexcept {
     SYSTRACE_CALL();
+    FrameStats::Scope stageScope(engine.getFrameStats(), FrameStats::Stage::FROXELIZATION);
     assert_invariant(mHasDynamicLighting);
     mFroxelizer.froxelizeLights(engine, viewMatrix, mScene->getLightData());
 }
@@ -848,11 +837,22 @@ void FView::prepareVisibleLights(FLightManager const& lcm, ArenaScope& rootArena
 
         // skip directional light
         Zip2Iterator<FScene::LightSoa::iterator, float*> b = { lightData.begin(), distances };
-        std::sort(b + FScene::DIRECTIONAL_LIGHTS_COUNT, b + size,
-                [](auto const& lhs, auto const& rhs) { return lhs.second < rhs.second; });
+        auto const closer = [](auto const& lhs, auto const& rhs) {
+            return lhs.second < rhs.second;
+        };
+        auto const first = b + FScene::DIRECTIONAL_LIGHTS_COUNT;
+        auto closestEnd = b + size;
+        if (positionalLightCount > CONFIG_MAX_LIGHT_COUNT) {
+            // With many visible lights, sorting the whole SoA dominates. Since the excess lights
+            // are dropped, we only need to find the closest ones (in linear time) and sort those.
+            closestEnd = first + CONFIG_MAX_LIGHT_COUNT;
+            std::nth_element(first, closestEnd, b + size, closer);
+        }
+        std::sort(first, closestEnd, closer);
     }
 
-    // drop excess lights
+    // drop excess lights, the GPU light list (and froxel records) can't index more than
+    // CONFIG_MAX_LIGHT_COUNT lights
     lightData.resize(std::min(size, CONFIG_MAX_LIGHT_COUNT + FScene::DIRECTIONAL_LIGHTS_COUNT));
 }
 
@@ -875,6 +875,62 @@ inline void FView::computeLightCameraDistances(
     }
 }
 
+float2 FView::computeVisibleDepthRange(mat4f const& viewMatrix,
+        FScene::RenderableSoa const& renderableData, Range visible) noexcept {
+    float3 const* const UTILS_RESTRICT centers = renderableData.data<FScene::WORLD_AABB_CENTER>();
+    float3 const* const UTILS_RESTRICT extents = renderableData.data<FScene::WORLD_AABB_EXTENT>();
+
+    // view-space z of a point is dot(row2, {p, 1}), the camera looks towards -z
+    const float3 row2 = { viewMatrix[0].z, viewMatrix[1].z, viewMatrix[2].z };
+    const float3 absRow2 = abs(row2);
+    const float w = viewMatrix[3].z;
+
+    float zmin = std::numeric_limits<float>::max();
+    float zmax = std::numeric_limits<float>::lowest();
+    for (uint32_t i : visible) {
+        const float z = dot(row2, centers[i]) + w;
+        const float e = dot(absRow2, extents[i]);
+        zmin = std::min(zmin, z - e);
+        zmax = std::max(zmax, z + e);
+    }
+    // convert to distances along the view direction
+    return { -zmax, -zmin };
+}
+
+float2 FView::computeAdaptiveDynamicLightingRange(float zLightNear, float zLightFar,
+        float2 visibleDepthRange) noexcept {
+    const float userNear = zLightNear;
+    const float userFar = zLightFar;
+    // Quantize the range to 1/4 of an octave (lights are sliced logarithmically), this avoids
+    // recomputing the froxel grid every frame when the camera or objects move a little.
+    // zLightNear is rounded down and zLightFar up, so the range stays conservative.
+    auto const quantize = [](float d, auto round) {
+        return std::exp2(round(std::log2(d) * 4.0f) * 0.25f);
+    };
+    if (visibleDepthRange.y > 0.0f) {
+        zLightFar = std::min(zLightFar,
+                quantize(visibleDepthRange.y, [](float v) { return std::ceil(v); }));
+    }
+    if (visibleDepthRange.x > zLightNear) {
+        zLightNear = quantize(visibleDepthRange.x, [](float v) { return std::floor(v); });
+    }
+    // keep at least an octave between the two, like the default 5m / 100m range, without
+    // going past the user's range (which can be narrower than that)
+    zLightNear = std::max(userNear, std::min(zLightNear, zLightFar * 0.5f));
+    zLightFar = std::min(userFar, std::max(zLightFar, zLightNear * 2.0f));
+    return { zLightNear, zLightFar };
+}
+
+void FView::updateAdaptiveDynamicLighting(mat4f const& viewMatrix,
+        FScene::RenderableSoa const& renderableData) noexcept {
+    float2 range = { mZLightNear, mZLightFar };
+    if (!mVisibleRenderables.empty()) {
+        range = computeAdaptiveDynamicLightingRange(mZLightNear, mZLightFar,
+                computeVisibleDepthRange(viewMatrix, renderableData, mVisibleRenderables));
+    }
+    mFroxelizer.setOptions(range.x, range.y);
+}
+
 void FView::updatePrimitivesLod(FEngine& engine, const CameraInfo&,
         FScene::RenderableSoa& renderableData, Range visible) noexcept {
     FRenderableManager const& rcm = engine.getRenderableManager();
@@ -952,6 +1008,9 @@ void FView::setScreenSpaceReflectionsOptions(ScreenSpaceReflectionsOptions optio
     options.bias = std::max(0.0f, options.bias);
     options.maxDistance = std::max(0.0f, options.maxDistance);
     options.stride = std::max(1.0f, options.stride);
+    // snap to the closer of 0.5 or 1.0
+    options.resolution = std::floor(
+            math::clamp(options.resolution * 2.0f, 1.0f, 2.0f) + 0.5f) * 0.5f;
     mScreenSpaceReflectionsOptions = options;
 }
 
@@ -963,9 +1022,9 @@ void FView::setAmbientOcclusionOptions(AmbientOcclusionOptions options) noexcept
     options.radius = math::max(0.0f, options.radius);
     options.power = std::max(0.0f, options.power);
     options.bias = math::clamp(options.bias, 0.0f, 0.1f);
-    // snap to the closer of 0.5 or 1.0
-    options.resolution = std::floor(
-            math::clamp(options.resolution * 2.0f, 1.0f, 2.0f) + 0.5f) * 0.5f;
+    // snap to the closest of 0.25, 0.5 or 1.0
+    options.resolution = options.resolution < 0.375f ? 0.25f :
+                         options.resolution < 0.75f  ? 0.5f  : 1.0f;
     options.intensity = std::max(0.0f, options.intensity);
     options.bilateralThreshold = std::max(0.0f, options.bilateralThreshold);
     options.minHorizonAngleRad = math::clamp(options.minHorizonAngleRad, 0.0f, math::f::PI_2);
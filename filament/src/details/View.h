@@ -24,11 +24,11 @@
 #include "upcast.h"
 
 #include "Allocators.h"
+#include "DynamicResolutionController.h"
 #include "FrameHistory.h"
 #include "FrameInfo.h"
 #include "Froxelizer.h"
 #include "PerViewUniforms.h"
-#include "PIDController.h"
 #include "ShadowMap.h"
 #include "ShadowMapManager.h"
 #include "TypedUniformBuffer.h"
@@ -279,6 +279,17 @@ public:
 
     void setDynamicLightingOptions(float zLightNear, float zLightFar) noexcept;
 
+    void setAdaptiveDynamicLightingEnabled(bool enabled) noexcept;
+
+    bool isAdaptiveDynamicLightingEnabled() const noexcept {
+        return mAdaptiveDynamicLighting;
+    }
+
+    // Returns the dynamic lighting range fitted to the depth range of the visible renderables
+    // (distances along the view direction), it always stays within zLightNear, zLightFar.
+    static math::float2 computeAdaptiveDynamicLightingRange(float zLightNear, float zLightFar,
+            math::float2 visibleDepthRange) noexcept;
+
     void setPostProcessingEnabled(bool enabled) noexcept {
         mHasPostProcessPass = enabled;
     }
@@ -441,6 +452,12 @@ private:
     static inline void computeLightCameraDistances(float* distances,
             math::mat4f const& viewMatrix, const math::float4* spheres, size_t count) noexcept;
 
+    static math::float2 computeVisibleDepthRange(math::mat4f const& viewMatrix,
+            FScene::RenderableSoa const& renderableData, Range visible) noexcept;
+
+    void updateAdaptiveDynamicLighting(math::mat4f const& viewMatrix,
+            FScene::RenderableSoa const& renderableData) noexcept;
+
     static void computeVisibilityMasks(
             uint8_t visibleLayers, uint8_t const* layers,
             FRenderableManager::Visibility const* visibility,
@@ -505,7 +522,8 @@ private:
     const FColorGrading* mColorGrading = nullptr;
     const FColorGrading* mDefaultColorGrading = nullptr;
 
-    PIDController mPidController;
+    PIDResolutionController mPidController;
+    PredictiveResolutionController mPredictiveController;
     DynamicResolutionOptions mDynamicResolution;
     math::float2 mScale = 1.0f;
     bool mIsDynamicResolutionSupported = false;
@@ -525,8 +543,13 @@ private:
     Range mVisibleDirectionalShadowCasters;
     Range mSpotLightShadowCasters;
     uint32_t mRenderableUBOSize = 0;
+    // copy of mRenderableUbh's content, only the renderables that changed are uploaded
+    utils::FixedCapacityVector<PerRenderableData> mRenderableUboData;
     mutable bool mHasDirectionalLight = false;
     mutable bool mHasDynamicLighting = false;
+    bool mAdaptiveDynamicLighting = false;
+    float mZLightNear = FEngine::CONFIG_Z_LIGHT_NEAR;   // as set by the user
+    float mZLightFar = FEngine::CONFIG_Z_LIGHT_FAR;     // as set by the user
     mutable bool mHasShadowing = false;
     mutable bool mNeedsShadowMap = false;
 
@@ -16,9 +16,11 @@
 
 #include "fg/details/DependencyGraph.h"
 
+#include <utils/Hash.h>
 #include <utils/Systrace.h>
 
 #include <iterator>
+#include <utility>
 
 namespace filament {
 
@@ -101,10 +103,68 @@ DependencyGraph::Node* DependencyGraph::getNode(DependencyGraph::NodeID id) noex
     return mNodes[id];
 }
 
-void DependencyGraph::cull() noexcept {
+DependencyGraph::CullingCache::CullingCache() noexcept = default;
+
+DependencyGraph::CullingCache::~CullingCache() noexcept = default;
+
+std::vector<uint32_t>* DependencyGraph::cull(CullingCache* cache) noexcept {
 
     SYSTRACE_CALL();
 
+    if (!cache) {
+        cullInternal();
+        return nullptr;
+    }
+
+    auto& nodes = mNodes;
+
+    // The result of culling only depends on the number of nodes, the edges and the targets.
+    std::vector<uint32_t>& structure = cache->mScratch;
+    structure.clear();
+    structure.reserve(1 + mEdges.size() * 2 + nodes.size());
+    structure.push_back(nodes.size());
+    for (Edge const* const pEdge : mEdges) {
+        structure.push_back(pEdge->from);
+        structure.push_back(pEdge->to);
+    }
+    for (Node const* const pNode : nodes) {
+        if (pNode->isTarget()) {
+            structure.push_back(pNode->getId());
+        }
+    }
+    const uint32_t hash = utils::hash::murmur3(structure.data(), structure.size(), 0);
+
+    CullingCache::Entry* lru = &cache->mEntries[0];
+    for (CullingCache::Entry& entry : cache->mEntries) {
+        if (entry.age && entry.hash == hash && entry.structure == structure) {
+            // same structure, just restore the reference counts
+            for (size_t i = 0, c = nodes.size(); i < c; i++) {
+                nodes[i]->mRefCount = entry.refCounts[i];
+            }
+            entry.age = ++cache->mAge;
+            cache->mHits++;
+            return &entry.schedule;
+        }
+        if (entry.age < lru->age) {
+            lru = &entry;
+        }
+    }
+
+    cullInternal();
+
+    lru->hash = hash;
+    lru->age = ++cache->mAge;
+    std::swap(lru->structure, structure);
+    lru->refCounts.resize(nodes.size());
+    for (size_t i = 0, c = nodes.size(); i < c; i++) {
+        lru->refCounts[i] = nodes[i]->mRefCount;
+    }
+    lru->schedule.clear();
+    cache->mMisses++;
+    return &lru->schedule;
+}
+
+void DependencyGraph::cullInternal() noexcept {
     auto& nodes = mNodes;
     auto& edges = mEdges;
 
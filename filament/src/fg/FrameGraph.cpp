@@ -27,6 +27,9 @@
 #include <utils/Panic.h>
 #include <utils/Systrace.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace filament {
 
 inline FrameGraph::Builder::Builder(FrameGraph& fg, PassNode* passNode) noexcept
@@ -100,14 +103,53 @@ void FrameGraph::reset() noexcept {
     mResourceSlots.clear();
 }
 
-FrameGraph& FrameGraph::compile() noexcept {
+FrameGraph& FrameGraph::compile(CompileCache* cache) noexcept {
 
     SYSTRACE_CALL();
 
     DependencyGraph& dependencyGraph = mGraph;
 
     // first we cull unreachable nodes
-    dependencyGraph.cull();
+    std::vector<uint32_t>* const schedule = dependencyGraph.cull(cache);
+
+    /*
+     * Which resources are read by active nodes, and which resources each active pass uses only
+     * depend on the structure of the graph. When we have a cache, they're recorded in the
+     * schedule the first time a structure is compiled, and replayed afterwards instead of
+     * searching the edges.
+     */
+    const bool replay = schedule && !schedule->empty();
+    uint32_t const* cursor = replay ? schedule->data() : nullptr;
+
+    if (replay) {
+        for (uint32_t i = 0, c = *cursor++; i < c; i++) {
+            auto pNode = static_cast<ResourceNode*>(dependencyGraph.getNode(*cursor++));
+            pNode->mHasActiveReaders = true;
+        }
+    } else {
+        // here we don't use the nodes' readers because this wouldn't account for subresources
+        Vector<uint8_t> activeReaders(dependencyGraph.getNodes().size(), 0, mArena);
+        for (DependencyGraph::Edge const* edge : dependencyGraph.getEdges()) {
+            if (!dependencyGraph.getNode(edge->to)->isCulled()) {
+                activeReaders[edge->from] = 1;
+            }
+        }
+        const size_t countIndex = schedule ? schedule->size() : 0;
+        if (schedule) {
+            schedule->push_back(0);
+        }
+        for (ResourceNode* pNode : mResourceNodes) {
+            if (activeReaders[pNode->getId()]) {
+                pNode->mHasActiveReaders = true;
+                if (schedule) {
+                    schedule->push_back(pNode->getId());
+                }
+            }
+        }
+        if (schedule) {
+            (*schedule)[countIndex] = schedule->size() - countIndex - 1;
+        }
+    }
 
     /*
      * update the reference counter of the resource themselves and
@@ -126,6 +168,19 @@ FrameGraph& FrameGraph::compile() noexcept {
         first++;
         assert_invariant(!passNode->isCulled());
 
+        if (replay) {
+            for (uint32_t i = 0, c = *cursor++; i < c; i++) {
+                auto pNode = static_cast<ResourceNode*>(dependencyGraph.getNode(*cursor++));
+                passNode->registerResource(pNode->resourceHandle);
+            }
+            passNode->resolve();
+            continue;
+        }
+
+        const size_t countIndex = schedule ? schedule->size() : 0;
+        if (schedule) {
+            schedule->push_back(0);
+        }
 
         auto const& reads = dependencyGraph.getIncomingEdges(passNode);
         for (auto const& edge : reads) {
@@ -133,6 +188,9 @@ FrameGraph& FrameGraph::compile() noexcept {
             assert_invariant(dependencyGraph.isEdgeValid(edge));
             auto pNode = static_cast<ResourceNode*>(dependencyGraph.getNode(edge->from));
             passNode->registerResource(pNode->resourceHandle);
+            if (schedule) {
+                schedule->push_back(edge->from);
+            }
         }
 
         auto const& writes = dependencyGraph.getOutgoingEdges(passNode);
@@ -142,12 +200,33 @@ FrameGraph& FrameGraph::compile() noexcept {
             // the resource we are writing to.
             auto pNode = static_cast<ResourceNode*>(dependencyGraph.getNode(edge->to));
             passNode->registerResource(pNode->resourceHandle);
+            if (schedule) {
+                schedule->push_back(edge->to);
+            }
+        }
+
+        if (schedule) {
+            (*schedule)[countIndex] = schedule->size() - countIndex - 1;
         }
 
         passNode->resolve();
     }
+    assert_invariant(!replay || cursor == schedule->data() + schedule->size());
+
+    /*
+     * Adjacent passes rendering into the same attachments share their render target
+     */
+    RenderPassNode* previous = nullptr;
+    for (auto it = mPassNodes.begin(); it != activePassNodesEnd; ++it) {
+        RenderPassNode* const current = (*it)->asRenderPassNode();
+        if (previous && current) {
+            current->shareRenderTargetWith(*previous);
+        }
+        previous = current;
+    }
 
-    // add resource to de-virtualize or destroy to the corresponding list for each active pass
+    // add resource to de-virtualize or destroy to the corresponding list for each active pass,
+    // their lifetimes come from the resources registered above, so this doesn't need the edges.
     for (auto* pResource : mResources) {
         VirtualResource* resource = pResource;
         if (resource->refcount) {
@@ -163,6 +242,27 @@ FrameGraph& FrameGraph::compile() noexcept {
         }
     }
 
+    /*
+     * Compute how much memory this frame needs for its transient textures
+     */
+    TransientMemory transientMemory;
+    size_t live = 0;
+    for (auto it = mPassNodes.begin(); it != activePassNodesEnd; ++it) {
+        PassNode const* const passNode = *it;
+        for (VirtualResource const* resource : passNode->devirtualize) {
+            const size_t size = resource->getMemorySize();
+            transientMemory.total += size;
+            live += size;
+        }
+        transientMemory.peak = std::max(transientMemory.peak, live);
+        for (VirtualResource const* resource : passNode->destroy) {
+            live -= resource->getMemorySize();
+        }
+    }
+    mTransientMemory = transientMemory;
+    SYSTRACE_VALUE32("transientPeakKiB", transientMemory.peak >> 10u);
+    SYSTRACE_VALUE32("transientTotalKiB", transientMemory.total >> 10u);
+
     /*
      * Resolve Usage bits
      */
@@ -279,11 +279,19 @@ public:
     template<typename Execute>
     void addTrivialSideEffectPass(const char* name, Execute&& execute);
 
+    /**
+     * Keeps the result of culling across frames, see DependencyGraph::CullingCache.
+     */
+    using CompileCache = DependencyGraph::CullingCache;
+
     /**
      * Allocates concrete resources and culls unreferenced passes.
+     * @param cache if not null, culling is skipped when a FrameGraph with the same structure
+     *              (same passes and resources, declared in the same order with the same
+     *              dependencies) was compiled with this cache recently.
      * @return a reference to the FrameGraph, for chaining calls.
      */
-    FrameGraph& compile() noexcept;
+    FrameGraph& compile(CompileCache* cache = nullptr) noexcept;
 
     /**
      * Execute all referenced passes
@@ -425,6 +433,18 @@ public:
      */
     bool isAcyclic() const noexcept;
 
+    /**
+     * Memory used by the textures created by the FrameGraph, only valid after compile().
+     * Textures are created before their first pass and destroyed after their last one, so
+     * textures with non-overlapping lifetimes can share the same memory.
+     */
+    struct TransientMemory {
+        size_t peak = 0;    // most memory needed at any point of the frame, with sharing
+        size_t total = 0;   // memory needed without any sharing
+    };
+
+    TransientMemory getTransientMemory() const noexcept { return mTransientMemory; }
+
     //! export a graphviz view of the graph
     void export_graphviz(utils::io::ostream& out, const char* name = nullptr);
 
@@ -523,6 +543,7 @@ private:
     Vector<ResourceNode*> mResourceNodes;
     Vector<PassNode*> mPassNodes;
     Vector<PassNode*>::iterator mActivePassNodesEnd;
+    TransientMemory mTransientMemory;
 };
 
 template<typename Data, typename Setup, typename Execute>
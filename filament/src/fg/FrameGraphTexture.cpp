@@ -18,6 +18,8 @@
 
 #include "ResourceAllocator.h"
 
+#include "details/Texture.h"
+
 #include <algorithm>
 
 namespace filament {
@@ -51,4 +53,15 @@ FrameGraphTexture::Descriptor FrameGraphTexture::generateSubResourceDescriptor(
     return descriptor;
 }
 
+size_t FrameGraphTexture::getMemorySize(Descriptor const& descriptor) noexcept {
+    // this uses the same estimate as the ResourceAllocator's cache
+    size_t size = size_t(descriptor.width) * descriptor.height * descriptor.depth *
+            FTexture::getFormatSize(descriptor.format);
+    size *= std::max(uint8_t(1), descriptor.samples);
+    if (descriptor.levels > 1) {
+        size += size / 3;
+    }
+    return size;
+}
+
 } // namespace filament
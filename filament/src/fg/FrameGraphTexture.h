@@ -22,6 +22,8 @@
 #include <backend/DriverEnums.h>
 #include <backend/Handle.h>
 
+#include <stddef.h>
+
 namespace filament {
 class ResourceAllocatorInterface;
 } // namespace::filament
@@ -36,6 +38,7 @@ namespace filament {
  * And declares and define:
  *      void create(ResourceAllocatorInterface&, const char* name, Descriptor const&, Usage) noexcept;
  *      void destroy(ResourceAllocatorInterface&) noexcept;
+ *      static size_t getMemorySize(Descriptor const&) noexcept;
  */
 struct FrameGraphTexture {
     backend::Handle<backend::HwTexture> handle;
@@ -95,6 +98,13 @@ struct FrameGraphTexture {
      */
     static Descriptor generateSubResourceDescriptor(Descriptor descriptor,
             SubResourceDescriptor const& srd) noexcept;
+
+    /**
+     * Estimates the memory used by a resource, this is used for statistics only.
+     * @param descriptor Descriptor to the resource
+     * @return           estimated size in bytes
+     */
+    static size_t getMemorySize(Descriptor const& descriptor) noexcept;
 };
 
 } // namespace filament
@@ -233,10 +233,47 @@ void RenderPassNode::resolve() noexcept {
     }
 }
 
+bool RenderPassNode::shareRenderTargetWith(RenderPassNode& previous) noexcept {
+    if (previous.mRenderTargetData.size() != 1 || mRenderTargetData.size() != 1) {
+        return false;
+    }
+
+    RenderPassData& prev = previous.mRenderTargetData.front();
+    RenderPassData& curr = mRenderTargetData.front();
+    if (prev.imported || curr.imported ||
+            prev.targetBufferFlags != curr.targetBufferFlags ||
+            prev.descriptor.samples != curr.descriptor.samples ||
+            prev.backend.params.viewport.width != curr.backend.params.viewport.width ||
+            prev.backend.params.viewport.height != curr.backend.params.viewport.height) {
+        return false;
+    }
+
+    // all attachments must be the same (sub)resources, different versions of a resource are
+    // the same concrete texture.
+    for (size_t i = 0; i < RenderPassData::ATTACHMENT_COUNT; i++) {
+        if (bool(prev.attachmentInfo[i]) != bool(curr.attachmentInfo[i])) {
+            return false;
+        }
+        if (curr.attachmentInfo[i] &&
+                mFrameGraph.getResource(prev.attachmentInfo[i]) !=
+                mFrameGraph.getResource(curr.attachmentInfo[i])) {
+            return false;
+        }
+    }
+
+    prev.keepTarget = true;
+    curr.sharedTarget = &prev;
+    return true;
+}
+
 void RenderPassNode::RenderPassData::devirtualize(FrameGraph& fg,
         ResourceAllocatorInterface& resourceAllocator) noexcept {
     assert_invariant(any(targetBufferFlags));
-    if (UTILS_LIKELY(!imported)) {
+    if (sharedTarget) {
+        // the previous pass has created the render target already
+        assert_invariant(sharedTarget->backend.target);
+        backend.target = sharedTarget->backend.target;
+    } else if (UTILS_LIKELY(!imported)) {
 
         MRT colorInfo{};
         for (size_t i = 0; i < MRT::MAX_SUPPORTED_RENDER_TARGET_COUNT; i++) {
@@ -271,7 +308,7 @@ void RenderPassNode::RenderPassData::devirtualize(FrameGraph& fg,
 
 void RenderPassNode::RenderPassData::destroy(
         ResourceAllocatorInterface& resourceAllocator) noexcept {
-    if (UTILS_LIKELY(!imported)) {
+    if (UTILS_LIKELY(!imported && !keepTarget)) {
         resourceAllocator.destroyRenderTarget(backend.target);
     }
 }
@@ -301,6 +338,9 @@ utils::CString RenderPassNode::graphvizify() const noexcept {
         s.append(utils::to_string(rt.backend.params.flags.discardEnd).c_str());
         s.append(", C:");
         s.append(utils::to_string(rt.backend.params.flags.clear).c_str());
+        if (rt.sharedTarget) {
+            s.append(", shared");
+        }
     }
 
     s.append("\", ");
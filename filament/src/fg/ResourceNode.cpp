@@ -66,18 +66,6 @@ void ResourceNode::setIncomingEdge(ResourceEdgeBase* edge) noexcept {
     mWriterPass = edge;
 }
 
-bool ResourceNode::hasActiveReaders() const noexcept {
-    // here we don't use mReaderPasses because this wouldn't account for subresources
-    DependencyGraph& dependencyGraph = mFrameGraph.getGraph();
-    auto const& readers = dependencyGraph.getOutgoingEdges(this);
-    for (auto const& reader : readers) {
-        if (!dependencyGraph.getNode(reader->to)->isCulled()) {
-            return true;
-        }
-    }
-    return false;
-}
-
 bool ResourceNode::hasActiveWriters() const noexcept {
     // here we don't use mReaderPasses because this wouldn't account for subresources
     DependencyGraph& dependencyGraph = mFrameGraph.getGraph();
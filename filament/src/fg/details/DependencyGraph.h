@@ -160,8 +160,48 @@ public:
 
     Node* getNode(NodeID id) noexcept;
 
-    //! cull unreferenced nodes. Links ARE NOT removed, only reference counts are updated.
-    void cull() noexcept;
+    /**
+     * Remembers the result of cull() for a few graph structures, so that graphs with the same
+     * nodes, edges and targets (created in the same order) can skip it. Each structure also
+     * keeps a schedule, which the user of the graph can fill with anything else that only
+     * depends on the structure. This must outlive the graphs it's used with, typically it is
+     * kept across frames.
+     */
+    class CullingCache {
+    public:
+        CullingCache() noexcept;
+        ~CullingCache() noexcept;
+        CullingCache(CullingCache const&) = delete;
+        CullingCache& operator=(CullingCache const&) = delete;
+
+        size_t getHitCount() const noexcept { return mHits; }
+        size_t getMissCount() const noexcept { return mMisses; }
+
+    private:
+        friend class DependencyGraph;
+        static constexpr size_t CAPACITY = 4;
+        struct Entry {
+            uint32_t hash = 0;
+            uint64_t age = 0;                   // for LRU replacement, 0 if unused
+            std::vector<uint32_t> structure;    // node count, edges and targets
+            std::vector<uint32_t> refCounts;    // result of cull()
+            std::vector<uint32_t> schedule;     // opaque, filled by the user of cull()
+        };
+        Entry mEntries[CAPACITY];
+        std::vector<uint32_t> mScratch;
+        uint64_t mAge = 0;
+        size_t mHits = 0;
+        size_t mMisses = 0;
+    };
+
+    /**
+     * cull unreferenced nodes. Links ARE NOT removed, only reference counts are updated.
+     * @param cache if not null, the result is taken from the cache if this graph's structure is
+     *              in it, otherwise it is added to it.
+     * @return the schedule of this graph's structure in the cache, which is empty if the
+     *         structure was just added. nullptr if cache is null.
+     */
+    std::vector<uint32_t>* cull(CullingCache* cache = nullptr) noexcept;
 
     /**
      * Return whether an edge is valid, that is if both ends are connected to nodes
@@ -180,6 +220,7 @@ private:
     uint32_t generateNodeId() noexcept;
     void registerNode(Node* node, NodeID id) noexcept;
     void link(Edge* edge) noexcept;
+    void cullInternal() noexcept;
     static bool isAcyclicInternal(DependencyGraph& graph) noexcept;
     NodeContainer mNodes;
     EdgeContainer mEdges;
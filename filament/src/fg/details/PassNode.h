@@ -37,6 +37,7 @@ namespace filament {
 class FrameGraph;
 class FrameGraphResources;
 class FrameGraphPassExecutor;
+class RenderPassNode;
 class ResourceNode;
 
 class PassNode : public DependencyGraph::Node {
@@ -58,6 +59,9 @@ public:
     virtual void resolve() noexcept = 0;
     utils::CString graphvizifyEdgeColor() const noexcept override;
 
+    // this is to workaround our lack of RTTI -- otherwise we could use dynamic_cast
+    virtual RenderPassNode* asRenderPassNode() noexcept { return nullptr; }
+
     Vector<VirtualResource*> devirtualize;         // resources we need to create before executing
     Vector<VirtualResource*> destroy;              // resources we need to destroy after executing
 };
@@ -78,6 +82,9 @@ public:
             backend::Handle<backend::HwRenderTarget> target;
             backend::RenderPassParams params;
         } backend;
+        // set when the backend render target is shared with the adjacent passes
+        RenderPassData const* sharedTarget = nullptr;   // the previous pass creates the target
+        bool keepTarget = false;                        // the next pass destroys the target
 
         void devirtualize(FrameGraph& fg, ResourceAllocatorInterface& resourceAllocator) noexcept;
         void destroy(ResourceAllocatorInterface& resourceAllocator) noexcept;
@@ -92,12 +99,23 @@ public:
 
     RenderPassData const* getRenderPassData(uint32_t id) const noexcept;
 
+    /*
+     * Called during FrameGraph::compile(), after resolve(). If this pass renders into the same
+     * attachments as the previous one, they share the same backend render target, so it's
+     * created and destroyed once instead of once per pass.
+     * Note that each pass still begins and ends its own render pass, with its own load/store
+     * flags, so the attachments are still stored and reloaded between the two passes.
+     * Returns whether the render target is shared.
+     */
+    bool shareRenderTargetWith(RenderPassNode& previous) noexcept;
+
 private:
     // virtuals from DependencyGraph::Node
     char const* getName() const noexcept override { return mName; }
     utils::CString graphvizify() const noexcept override;
     void execute(FrameGraphResources const& resources, backend::DriverApi& driver) noexcept override;
     void resolve() noexcept override;
+    RenderPassNode* asRenderPassNode() noexcept override { return this; }
 
     // constants
     const char* const mName = nullptr;
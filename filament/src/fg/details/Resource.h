@@ -96,6 +96,9 @@ public:
 
     virtual bool isImported() const noexcept { return false; }
 
+    // estimated size of the concrete resource if it's created by the FrameGraph, 0 otherwise
+    virtual size_t getMemorySize() const noexcept = 0;
+
     // this is to workaround our lack of RTTI -- otherwise we could use dynamic_cast
     virtual ImportedRenderTarget* asImportedRenderTarget() noexcept { return nullptr; }
 
@@ -248,6 +251,11 @@ protected:
     utils::CString usageString() const noexcept override {
         return utils::to_string(usage);
     }
+
+    size_t getMemorySize() const noexcept override {
+        // subresources share their parent's memory
+        return isSubResource() ? 0 : RESOURCE::getMemorySize(descriptor);
+    }
 };
 
 /*
@@ -277,6 +285,8 @@ protected:
 
     bool isImported() const noexcept override { return true; }
 
+    size_t getMemorySize() const noexcept override { return 0; }
+
     UTILS_NOINLINE
     bool connect(DependencyGraph& graph,
             PassNode* passNode, ResourceNode* resourceNode, FrameGraphTexture::Usage u) override {
@@ -62,8 +62,11 @@ public:
         return !mReaderPasses.empty();
     }
 
-    // is any non culled Node (of any type) reading from this ResourceNode
-    bool hasActiveReaders() const noexcept;
+    // is any non culled Node (of any type) reading from this ResourceNode,
+    // valid only after FrameGraph::compile().
+    bool hasActiveReaders() const noexcept {
+        return mHasActiveReaders;
+    }
 
     // is the specified PassNode reading this resource, if so return the corresponding edge.
     ResourceEdgeBase* getReaderEdgeForPass(PassNode const* node) const noexcept;
@@ -100,6 +103,7 @@ public:
     }
 
 private:
+    friend class FrameGraph;
     FrameGraph& mFrameGraph;
     Vector<ResourceEdgeBase *> mReaderPasses;
     ResourceEdgeBase* mWriterPass = nullptr;
@@ -107,6 +111,7 @@ private:
     DependencyGraph::Edge* mParentReadEdge = nullptr;
     DependencyGraph::Edge* mParentWriteEdge = nullptr;
     DependencyGraph::Edge* mForwardedEdge = nullptr;
+    bool mHasActiveReaders = false;     // computed by FrameGraph::compile()
 
     // virtuals from DependencyGraph::Node
     utils::CString graphvizify() const noexcept override;
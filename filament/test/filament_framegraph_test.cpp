@@ -72,7 +72,7 @@ protected:
     Backend backend = Backend::NOOP;
     CircularBuffer buffer = CircularBuffer{ 8192 };
     DefaultPlatform* platform = DefaultPlatform::create(&backend);
-    CommandStream driverApi = CommandStream{ *platform->createDriver(nullptr), buffer };
+    CommandStream driverApi = CommandStream{ *platform->createDriver(nullptr, {}), buffer };
     MockResourceAllocator resourceAllocator;
     FrameGraph fg{resourceAllocator};
 };
@@ -333,6 +333,68 @@ TEST_F(FrameGraphTest, Culling1) {
     fg.execute(driverApi);
 }
 
+TEST_F(FrameGraphTest, SideEffectSubresourceWrite) {
+    // Same setup as the "Cascade History Update" pass of the shadow maps: a pass copies a layer
+    // of the shadow map to a layer of an imported texture, which nothing reads this frame.
+    FrameGraphTexture historyTexture{ .handle = Handle<HwTexture>{ 0x3141 }};
+    FrameGraphId<FrameGraphTexture> history = fg.import("Cascade History",
+            { .width = 16, .height = 16, .depth = 2, .type = SamplerType::SAMPLER_2D_ARRAY },
+            FrameGraphTexture::Usage::DEPTH_ATTACHMENT, historyTexture);
+
+    struct ShadowPassData {
+        FrameGraphId<FrameGraphTexture> output;
+    };
+    auto& shadowPass = fg.addPass<ShadowPassData>("Shadow Pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.output = builder.create<FrameGraphTexture>("Shadowmap", {
+                        .width = 16, .height = 16, .depth = 2,
+                        .type = SamplerType::SAMPLER_2D_ARRAY });
+                data.output = builder.createSubresource(data.output,
+                        "Shadowmap Layer", { .layer = 1 });
+                data.output = builder.write(data.output,
+                        FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                builder.declareRenderPass("Shadow RT", {{ .depth = data.output }});
+            },
+            [=](FrameGraphResources const& resources, auto const& data,
+                    backend::DriverApi& driver) {
+            });
+
+    struct HistoryPassData {
+        FrameGraphId<FrameGraphTexture> input;
+        FrameGraphId<FrameGraphTexture> output;
+    };
+    bool historyUpdated = false;
+    auto& historyPass = fg.addPass<HistoryPassData>("Cascade History Update",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.input = builder.read(shadowPass->output,
+                        FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                data.output = builder.createSubresource(history,
+                        "Cascade History Layer", { .layer = 1 });
+                data.output = builder.write(data.output,
+                        FrameGraphTexture::Usage::DEPTH_ATTACHMENT);
+                builder.declareRenderPass("Cascade History Update RT",
+                        {{ .depth = data.input }});
+                builder.sideEffect();
+            },
+            [&historyUpdated](FrameGraphResources const& resources, auto const& data,
+                    backend::DriverApi& driver) {
+                EXPECT_TRUE(resources.getRenderPassInfo().target);
+                historyUpdated = true;
+            });
+
+    EXPECT_TRUE(fg.isAcyclic());
+
+    fg.compile();
+
+    // the copy and the shadow pass it reads from are kept
+    EXPECT_FALSE(fg.isCulled(historyPass));
+    EXPECT_FALSE(fg.isCulled(shadowPass));
+
+    fg.execute(driverApi);
+
+    EXPECT_TRUE(historyUpdated);
+}
+
 TEST_F(FrameGraphTest, Basic) {
     struct DepthPassData {
         FrameGraphId<FrameGraphTexture> depth;
@@ -889,3 +951,249 @@ TEST_F(FrameGraphTest, SubResourcesWriteRead) {
 
     fg.execute(driverApi);
 }
+
+TEST_F(FrameGraphTest, TransientMemory) {
+    struct PassData {
+        FrameGraphId<FrameGraphTexture> input;
+        FrameGraphId<FrameGraphTexture> output;
+    };
+
+    // a chain of 3 passes, each one samples the previous pass's 16x16 RGBA8 output
+    FrameGraphId<FrameGraphTexture> input;
+    for (int i = 0; i < 3; i++) {
+        auto& pass = fg.addPass<PassData>("Pass",
+                [&](FrameGraph::Builder& builder, auto& data) {
+                    if (input) {
+                        data.input = builder.sample(input);
+                    }
+                    data.output = builder.create<FrameGraphTexture>("Output", {.width=16, .height=16});
+                    data.output = builder.declareRenderPass(data.output);
+                },
+                [=](FrameGraphResources const& resources, auto const& data,
+                        backend::DriverApi& driver) {
+                });
+        input = pass->output;
+    }
+
+    FrameGraphTexture importedTexture{ .handle = Handle<HwTexture>{ 0x3141 }};
+    FrameGraphId<FrameGraphTexture> imported = fg.import("Imported texture",
+            FrameGraphTexture::Descriptor{ .width = 640, .height = 400 },
+            FrameGraphTexture::Usage::COLOR_ATTACHMENT, importedTexture);
+
+    fg.addPass<PassData>("Copy pass",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.input = builder.sample(input);
+                data.output = builder.declareRenderPass(imported);
+            },
+            [=](FrameGraphResources const& resources, auto const& data,
+                    backend::DriverApi& driver) {
+            });
+
+    fg.compile();
+
+    // at most two outputs are alive at the same time, and imported textures don't count
+    FrameGraph::TransientMemory const memory = fg.getTransientMemory();
+    EXPECT_EQ(memory.total, 3u * 16u * 16u * 4u);
+    EXPECT_EQ(memory.peak, 2u * 16u * 16u * 4u);
+
+    fg.execute(driverApi);
+}
+
+TEST_F(FrameGraphTest, ResourceAllocatorBudget) {
+    constexpr size_t TEXTURE_SIZE = 64 * 64 * 4;
+    ResourceAllocator allocator(driverApi);
+    allocator.setCacheBudget(2 * TEXTURE_SIZE);
+
+    auto create = [&]() {
+        return allocator.createTexture("Texture", SamplerType::SAMPLER_2D, 1,
+                TextureFormat::RGBA8, 1, 64, 64, 1, {
+                        TextureSwizzle::CHANNEL_0, TextureSwizzle::CHANNEL_1,
+                        TextureSwizzle::CHANNEL_2, TextureSwizzle::CHANNEL_3 },
+                TextureUsage::SAMPLEABLE | TextureUsage::COLOR_ATTACHMENT);
+    };
+
+    TextureHandle a = create();
+    allocator.destroyTexture(a);
+    EXPECT_EQ(allocator.getStats().misses, 1u);
+    EXPECT_EQ(allocator.getStats().cacheSize, TEXTURE_SIZE);
+
+    a = create();
+    TextureHandle b = create();
+    TextureHandle c = create();
+    EXPECT_EQ(allocator.getStats().hits, 1u);
+    EXPECT_EQ(allocator.getStats().misses, 3u);
+    EXPECT_EQ(allocator.getStats().inUseSize, 3 * TEXTURE_SIZE);
+
+    allocator.destroyTexture(a);
+    allocator.destroyTexture(b);
+    allocator.destroyTexture(c);
+    EXPECT_EQ(allocator.getStats().inUseSize, 0u);
+    EXPECT_EQ(allocator.getStats().cacheSize, 3 * TEXTURE_SIZE);
+
+    // we're over budget, the least recently used texture is evicted
+    allocator.gc();
+    EXPECT_EQ(allocator.getStats().evictions, 1u);
+    EXPECT_EQ(allocator.getStats().bytesEvicted, TEXTURE_SIZE);
+    EXPECT_EQ(allocator.getStats().cacheSize, 2 * TEXTURE_SIZE);
+
+    allocator.terminate();
+}
+
+TEST_F(FrameGraphTest, CompileCache) {
+    struct PassData {
+        FrameGraphId<FrameGraphTexture> output;
+    };
+
+    FrameGraph::CompileCache cache;
+
+    // builds a graph with a used and an unused pass, and checks that the unused one is culled
+    auto buildAndCompile = [&](bool extraPass) {
+        FrameGraph graph{ resourceAllocator };
+        auto& used = graph.addPass<PassData>("Used pass",
+                [&](FrameGraph::Builder& builder, auto& data) {
+                    data.output = builder.create<FrameGraphTexture>("Output", {.width=16, .height=16});
+                    data.output = builder.declareRenderPass(data.output);
+                },
+                [=](FrameGraphResources const&, auto const&, backend::DriverApi&) {});
+        auto& unused = graph.addPass<PassData>("Unused pass",
+                [&](FrameGraph::Builder& builder, auto& data) {
+                    data.output = builder.create<FrameGraphTexture>("Output", {.width=16, .height=16});
+                    data.output = builder.declareRenderPass(data.output);
+                },
+                [=](FrameGraphResources const&, auto const&, backend::DriverApi&) {});
+        if (extraPass) {
+            graph.addTrivialSideEffectPass("Side effect pass",
+                    [](backend::DriverApi&) {});
+        }
+        graph.present(used->output);
+        graph.compile(&cache);
+        EXPECT_FALSE(graph.isCulled(used));
+        EXPECT_TRUE(graph.isCulled(unused));
+        graph.execute(driverApi);
+    };
+
+    buildAndCompile(false);
+    EXPECT_EQ(cache.getHitCount(), 0u);
+    EXPECT_EQ(cache.getMissCount(), 1u);
+
+    // same structure, culling is taken from the cache
+    buildAndCompile(false);
+    EXPECT_EQ(cache.getHitCount(), 1u);
+    EXPECT_EQ(cache.getMissCount(), 1u);
+
+    // the structure changed
+    buildAndCompile(true);
+    EXPECT_EQ(cache.getHitCount(), 1u);
+    EXPECT_EQ(cache.getMissCount(), 2u);
+
+    // both structures are in the cache
+    buildAndCompile(false);
+    buildAndCompile(true);
+    EXPECT_EQ(cache.getHitCount(), 3u);
+    EXPECT_EQ(cache.getMissCount(), 2u);
+}
+
+TEST_F(FrameGraphTest, SharedRenderTarget) {
+    struct PassData {
+        FrameGraphId<FrameGraphTexture> color;
+        FrameGraphId<FrameGraphTexture> input;
+        uint32_t id = 0;
+    };
+
+    Handle<HwRenderTarget> targets[3];
+
+    // first pass creates the color buffer
+    auto& pass0 = fg.addPass<PassData>("Pass 0",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.color = builder.create<FrameGraphTexture>("Color", {.width=16, .height=16});
+                data.color = builder.declareRenderPass(data.color);
+            },
+            [&](FrameGraphResources const& resources, auto const& data, backend::DriverApi&) {
+                targets[0] = resources.getRenderPassInfo().target;
+            });
+
+    // second pass renders into the same color buffer, it shares the render target
+    auto& pass1 = fg.addPass<PassData>("Pass 1",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.color = builder.declareRenderPass(pass0->color);
+            },
+            [&](FrameGraphResources const& resources, auto const& data, backend::DriverApi&) {
+                targets[1] = resources.getRenderPassInfo().target;
+            });
+
+    // third pass samples the color buffer and renders into a new one
+    auto& pass2 = fg.addPass<PassData>("Pass 2",
+            [&](FrameGraph::Builder& builder, auto& data) {
+                data.input = builder.sample(pass1->color);
+                data.color = builder.create<FrameGraphTexture>("Output", {.width=16, .height=16});
+                data.color = builder.declareRenderPass(data.color);
+            },
+            [&](FrameGraphResources const& resources, auto const& data, backend::DriverApi&) {
+                targets[2] = resources.getRenderPassInfo().target;
+            });
+
+    fg.present(pass2->color);
+
+    fg.compile();
+    fg.execute(driverApi);
+
+    EXPECT_TRUE((bool)targets[0]);
+    EXPECT_EQ(targets[0], targets[1]);
+    EXPECT_NE(targets[1], targets[2]);
+}
+
+TEST_F(FrameGraphTest, CompileCacheSchedule) {
+    struct ProducerData {
+        FrameGraphId<FrameGraphTexture> input;
+        FrameGraphId<FrameGraphTexture> unused;
+    };
+    struct ConsumerData {
+        FrameGraphId<FrameGraphTexture> input;
+        FrameGraphId<FrameGraphTexture> output;
+    };
+
+    FrameGraph::CompileCache cache;
+
+    // the second and third frames replay the schedule recorded by the first one, the
+    // resources, their lifetimes and the render passes must be the same.
+    for (size_t frame = 0; frame < 3; frame++) {
+        FrameGraph graph{ resourceAllocator };
+        bool producerExecuted = false;
+        bool consumerExecuted = false;
+        auto& producer = graph.addPass<ProducerData>("Producer",
+                [&](FrameGraph::Builder& builder, auto& data) {
+                    data.input = builder.create<FrameGraphTexture>("Input", {.width=16, .height=16});
+                    data.unused = builder.create<FrameGraphTexture>("Unused", {.width=16, .height=16});
+                    data.input = builder.write(data.input, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                    data.unused = builder.write(data.unused, FrameGraphTexture::Usage::COLOR_ATTACHMENT);
+                    builder.declareRenderPass("Producer target", { .attachments = {
+                            .color = { data.input, data.unused }}});
+                },
+                [&](FrameGraphResources const& resources, auto const& data, backend::DriverApi&) {
+                    EXPECT_TRUE((bool)resources.get(data.input).handle);
+                    auto rp = resources.getRenderPassInfo();
+                    EXPECT_EQ(rp.params.flags.discardEnd, TargetBufferFlags::COLOR1);
+                    producerExecuted = true;
+                });
+        auto& consumer = graph.addPass<ConsumerData>("Consumer",
+                [&](FrameGraph::Builder& builder, auto& data) {
+                    data.input = builder.sample(producer->input);
+                    data.output = builder.create<FrameGraphTexture>("Output", {.width=16, .height=16});
+                    data.output = builder.declareRenderPass(data.output);
+                },
+                [&](FrameGraphResources const& resources, auto const& data, backend::DriverApi&) {
+                    EXPECT_TRUE((bool)resources.get(data.input).handle);
+                    EXPECT_TRUE((bool)resources.get(data.output).handle);
+                    consumerExecuted = true;
+                });
+        graph.present(consumer->output);
+        graph.compile(&cache);
+        EXPECT_FALSE(graph.isCulled(producer));
+        EXPECT_FALSE(graph.isCulled(consumer));
+        graph.execute(driverApi);
+        EXPECT_TRUE(producerExecuted);
+        EXPECT_TRUE(consumerExecuted);
+    }
+    EXPECT_EQ(cache.getHitCount(), 2u);
+    EXPECT_EQ(cache.getMissCount(), 1u);
+}
@@ -23,13 +23,20 @@
 #include <filament/View.h>
 #include <filament/Viewport.h>
 #include <filament/ColorGrading.h>
+#include <filament/ToneMapper.h>
 
 #include <utils/EntityManager.h>
 
 #include <backend/PixelBufferDescriptor.h>
 
+#include <math/vec3.h>
+
+#include <algorithm>
+#include <cstdlib>
+
 using namespace filament;
 using namespace backend;
+using namespace filament::math;
 
 class RenderingTest : public testing::Test {
 protected:
@@ -139,3 +146,46 @@ TEST_F(RenderingTest, ClearGreen) {
         EXPECT_EQ(rgba[3], 0xff);
     });
 }
+
+TEST_F(RenderingTest, ColorGradingGpuBaking) {
+    // The LUT baked on the GPU is compared to the LUT generated on the CPU, the reference. On the
+    // backends that don't support GPU baking, both are generated on the CPU.
+    const float3 colors[] = {
+            { 0.0f, 0.0f, 0.0f }, { 0.05f, 0.1f, 0.02f }, { 0.18f, 0.18f, 0.18f },
+            { 0.8f, 0.3f, 0.1f }, { 0.1f, 0.4f, 1.5f }, { 4.0f, 2.0f, 1.0f }
+    };
+    ACESToneMapper toneMapper;
+    mView->setDithering(View::Dithering::NONE);
+
+    auto render = [&](bool gpuBaking, float3 color, uint8_t* result) {
+        ColorGrading* colorGrading = ColorGrading::Builder()
+                .toneMapper(&toneMapper)
+                .gpuBaking(gpuBaking)
+                .whiteBalance(0.1f, 0.05f)
+                .exposure(0.5f)
+                .contrast(1.2f)
+                .vibrance(1.1f)
+                .saturation(0.9f)
+                .build(*mEngine);
+        mView->setColorGrading(colorGrading);
+        mSkybox->setColor({ color, 1.0f });
+        runTest([result](uint8_t const* rgba, uint32_t width, uint32_t height) {
+            std::copy_n(rgba, 4, result);
+        });
+        mView->setColorGrading(mColorGrading);
+        mEngine->destroy(colorGrading);
+    };
+
+    for (float3 const& color : colors) {
+        uint8_t reference[4];
+        uint8_t baked[4];
+        render(false, color, reference);
+        render(true, color, baked);
+        for (size_t i = 0; i < 4; i++) {
+            // the GPU evaluates the adjustments at a lower precision
+            EXPECT_LE(std::abs(int(baked[i]) - int(reference[i])), 2)
+                    << "channel " << i << " of color " << color.r << ", " << color.g << ", "
+                    << color.b;
+        }
+    }
+}
@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 
+#include <bitset>
 #include <iostream>
 #include <random>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -31,19 +33,32 @@
 #include <filament/Frustum.h>
 #include <filament/Material.h>
 #include <filament/Engine.h>
+#include <filament/View.h>
 
 #include <private/filament/UniformInterfaceBlock.h>
 #include <private/filament/UibStructs.h>
 #include <private/backend/BackendUtils.h>
+#include <private/backend/HandleAllocator.h>
 
 #include "Allocators.h"
+#include "DynamicResolutionController.h"
 #include "details/Material.h"
+#include "details/MaterialInstance.h"
 #include "details/Camera.h"
+#include "details/View.h"
+#include "Culler.h"
 #include "Froxelizer.h"
+#include "Intersections.h"
+#include "ShadowMap.h"
+#include "ShadowMapManager.h"
 #include "details/Engine.h"
 #include "components/RenderableManager.h"
 #include "components/TransformManager.h"
+#include "TypedUniformBuffer.h"
 #include "UniformBuffer.h"
+#include "UniformBufferPool.h"
+
+#include "filament_test_resources.h"
 
 using namespace filament;
 using namespace filament::math;
@@ -501,6 +516,156 @@ TEST(FilamentTest, UniformBufferSize2) {
     buffer.invalidate();
 }
 
+TEST(FilamentTest, UniformBufferDirtyRange) {
+    UniformInterfaceBlock::Builder b;
+    b.name("UniformBufferDirtyRange");
+    b.add("f4a", UniformInterfaceBlock::Type::FLOAT4); // offset = 0
+    b.add("f4b", UniformInterfaceBlock::Type::FLOAT4); // offset = 16
+    b.add("f1a", UniformInterfaceBlock::Type::FLOAT);  // offset = 32
+    b.add("f1b", UniformInterfaceBlock::Type::FLOAT);  // offset = 36
+    b.add("f4c", UniformInterfaceBlock::Type::FLOAT4); // offset = 48
+    UniformInterfaceBlock uib(b.build());
+    UniformBuffer buffer(uib.getSize());
+
+    // a new buffer is entirely dirty
+    EXPECT_TRUE(buffer.isDirty());
+    EXPECT_EQ(buffer.getDirtyRange().first, 0u);
+    EXPECT_EQ(buffer.getDirtyRange().last, uib.getSize());
+
+    buffer.clean();
+    EXPECT_FALSE(buffer.isDirty());
+
+    // a single float dirties its vec4
+    buffer.setUniform(uib.getUniformOffset("f1b", 0), 1.0f);
+    EXPECT_TRUE(buffer.isDirty());
+    EXPECT_EQ(buffer.getDirtyRange().first, 32u);
+    EXPECT_EQ(buffer.getDirtyRange().last, 48u);
+
+    // the range covers all the changes
+    buffer.setUniform(uib.getUniformOffset("f4b", 0), float4(1.0f));
+    EXPECT_EQ(buffer.getDirtyRange().first, 16u);
+    EXPECT_EQ(buffer.getDirtyRange().last, 48u);
+
+    buffer.clean();
+    buffer.setUniform(uib.getUniformOffset("f4c", 0), float4(1.0f));
+    EXPECT_EQ(buffer.getDirtyRange().first, 48u);
+    EXPECT_EQ(buffer.getDirtyRange().last, 64u);
+}
+
+TEST(FilamentTest, TypedUniformBufferDirtyRange) {
+    struct Uib {
+        float4 f4a;     // offset = 0
+        float f1a;      // offset = 16
+        float f1b;      // offset = 20
+        float2 padding;
+        float4 f4b;     // offset = 32
+    };
+    TypedUniformBuffer<Uib, 2> buffer;
+
+    // a new buffer is clean
+    EXPECT_FALSE(buffer.isDirty());
+
+    // a single float dirties its vec4
+    buffer.setUniform(&Uib::f1b, 1.0f);
+    EXPECT_TRUE(buffer.isDirty());
+    EXPECT_EQ(buffer.getDirtyRange().first, 16u);
+    EXPECT_EQ(buffer.getDirtyRange().last, 32u);
+
+    // the range covers all the changes
+    buffer.setUniform(&Uib::f4b, float4(1.0f));
+    EXPECT_EQ(buffer.getDirtyRange().first, 16u);
+    EXPECT_EQ(buffer.getDirtyRange().last, 48u);
+
+    buffer.clean();
+    EXPECT_FALSE(buffer.isDirty());
+
+    // fields of the following items
+    buffer.editUniform(&Uib::f4a, 1) = float4(1.0f);
+    EXPECT_EQ(buffer.getDirtyRange().first, 48u);
+    EXPECT_EQ(buffer.getDirtyRange().last, 64u);
+
+    // a whole item
+    buffer.clean();
+    buffer.itemAt(1).f1a = 1.0f;
+    EXPECT_EQ(buffer.getDirtyRange().first, 48u);
+    EXPECT_EQ(buffer.getDirtyRange().last, 96u);
+}
+
+TEST(FilamentTest, UniformBufferPool) {
+    Engine* engine = Engine::create(Engine::Backend::NOOP);
+    FEngine::DriverApi& driver = upcast(engine)->getDriverApi();
+
+    UniformBufferPool pool(100);
+    EXPECT_EQ(100u, pool.getBlockSize());
+
+    // slots are allocated in order, 256 bytes apart so that all backends can bind them
+    const UniformBufferPool::Slot a = pool.allocate(driver);
+    const UniformBufferPool::Slot b = pool.allocate(driver);
+    EXPECT_TRUE(bool(a.buffer));
+    EXPECT_TRUE(a.buffer == b.buffer);
+    EXPECT_EQ(0u, a.offset);
+    EXPECT_EQ(256u, b.offset);
+
+    // freed slots are reused first
+    pool.free(a);
+    const UniformBufferPool::Slot c = pool.allocate(driver);
+    EXPECT_TRUE(a.buffer == c.buffer);
+    EXPECT_EQ(a.offset, c.offset);
+
+    // a page holds 16 KiB of slots, the following ones overflow into a new page
+    std::vector<UniformBufferPool::Slot> slots{ b, c };
+    do {
+        slots.push_back(pool.allocate(driver));
+    } while (slots.back().page == 0);
+    EXPECT_EQ(16384u / 256u + 1u, slots.size());
+    EXPECT_EQ(1u, slots.back().page);
+    EXPECT_EQ(0u, slots.back().offset);
+    EXPECT_FALSE(a.buffer == slots.back().buffer);
+
+    for (auto const& slot : slots) {
+        EXPECT_EQ(0u, slot.offset % 256u);
+        pool.free(slot);
+    }
+
+    pool.terminate(driver);
+    Engine::destroy(&engine);
+}
+
+TEST(FilamentTest, MaterialInstanceUniformBufferSlot) {
+    Engine* engine = Engine::create(Engine::Backend::NOOP);
+    Material* material = Material::Builder()
+            .package(FILAMENT_TEST_RESOURCES_TEST_MATERIAL_DATA,
+                    FILAMENT_TEST_RESOURCES_TEST_MATERIAL_SIZE)
+            .build(*engine);
+    ASSERT_NE(nullptr, material);
+    ASSERT_FALSE(upcast(material)->getUniformInterfaceBlock().isEmpty());
+
+    // the default instance has its own buffer
+    EXPECT_FALSE(bool(upcast(material->getDefaultInstance())->getUniformBufferSlot().buffer));
+
+    // the other instances share the material's pages
+    FMaterialInstance* mi0 = upcast(material->createInstance());
+    FMaterialInstance* mi1 = upcast(material->createInstance());
+    const UniformBufferPool::Slot slot0 = mi0->getUniformBufferSlot();
+    const UniformBufferPool::Slot slot1 = mi1->getUniformBufferSlot();
+    EXPECT_TRUE(bool(slot0.buffer));
+    EXPECT_TRUE(slot0.buffer == slot1.buffer);
+    EXPECT_NE(slot0.offset, slot1.offset);
+    EXPECT_EQ(0u, slot0.offset % 256u);
+    EXPECT_EQ(0u, slot1.offset % 256u);
+
+    // destroying an instance releases its slot
+    engine->destroy(mi0);
+    FMaterialInstance* mi2 = upcast(material->createInstance());
+    EXPECT_TRUE(slot0.buffer == mi2->getUniformBufferSlot().buffer);
+    EXPECT_EQ(slot0.offset, mi2->getUniformBufferSlot().offset);
+
+    engine->destroy(mi1);
+    engine->destroy(mi2);
+    engine->destroy(material);
+    Engine::destroy(&engine);
+}
+
 TEST(FilamentTest, BoxCulling) {
     Frustum frustum(mat4f::frustum(-1, 1, -1, 1, 1, 100));
 
@@ -581,6 +746,101 @@ TEST(FilamentTest, SphereCulling) {
     EXPECT_TRUE(frustum.intersects({ 0, 200 }));
 }
 
+TEST(FilamentTest, SpotShadowCullingBits) {
+    // every bit of the visibility mask is in use, the last spotlight gets the topmost one
+    const size_t lastSpotBit =
+            VISIBLE_SPOT_SHADOW_RENDERABLE_N_BIT(CONFIG_MAX_SHADOW_CASTING_SPOTS - 1);
+    EXPECT_EQ(sizeof(Culler::result_type) * 8 - 1, lastSpotBit);
+    EXPECT_EQ(std::numeric_limits<Culler::result_type>::max(),
+            VISIBLE_RENDERABLE | VISIBLE_DIR_SHADOW_RENDERABLE | VISIBLE_SPOT_SHADOW_RENDERABLE);
+
+    Frustum frustum(mat4f::frustum(-1, 1, -1, 1, 1, 100));
+    float3 const center[Culler::MODULO] = {
+            { 0, 0, -10 }, { 0, 0, 0 }, { 0, 0, -50 }, { 20, 0, -10 } };
+    float3 const extent[Culler::MODULO] = {
+            { 0.5f }, { 0.5f }, { 0.5f }, { 0.5f } };
+    Culler::result_type results[Culler::MODULO] = {
+            VISIBLE_RENDERABLE, VISIBLE_RENDERABLE, 0, VISIBLE_SPOT_SHADOW_RENDERABLE_N(0) };
+
+    Culler::intersects(results, frustum, center, extent, Culler::MODULO, lastSpotBit);
+
+    // the culling result lands in the last spotlight's bit, the other bits are left alone
+    const Culler::result_type last = VISIBLE_SPOT_SHADOW_RENDERABLE_N(
+            CONFIG_MAX_SHADOW_CASTING_SPOTS - 1);
+    EXPECT_EQ(VISIBLE_RENDERABLE | last, results[0]);
+    EXPECT_EQ(VISIBLE_RENDERABLE, results[1]);
+    EXPECT_EQ(last, results[2]);
+    EXPECT_EQ(VISIBLE_SPOT_SHADOW_RENDERABLE_N(0), results[3]);
+}
+
+TEST(FilamentTest, ShadowStaticCacheInvalidation) {
+    using Key = ShadowMapManager::StaticCacheKey;
+    auto makeKey = [](float x, uint8_t layer, ushort2 offset) {
+        return Key{
+                .projection = mat4f::frustum(-1, 1, -1, 1, 1, 100),
+                .model = mat4f::translation(float3{ x, 10, 100 }),
+                .polygonOffset = { 0.5f, 2.0f },
+                .castersHash = 0x1234u,
+                .atlasOffset = offset,
+                .dimension = 512,
+                .layer = layer,
+                .valid = true };
+    };
+
+    // two spotlights sharing layer 1, one cascade in layer 0
+    const Key cascade = makeKey(0, 0, {});
+    const Key spot0 = makeKey(1, 1, { 0, 0 });
+    const Key spot1 = makeKey(2, 1, { 512, 0 });
+
+    ShadowMapManager::StaticCacheKeys cached{};
+    ShadowMapManager::StaticCacheKeys keys{};
+    keys[0] = cascade;
+    keys[4] = spot0;
+    keys[5] = spot1;
+
+    // everything is rendered the first time
+    EXPECT_EQ(0b11u, ShadowMapManager::updateStaticCacheKeys(cached, keys));
+    EXPECT_TRUE(cached[0].valid && cached[4].valid && cached[5].valid);
+
+    // nothing changed
+    EXPECT_EQ(0u, ShadowMapManager::updateStaticCacheKeys(cached, keys));
+
+    // the matrices drifted by a few ulps, which is well below a texel
+    keys[4].model[3].x = std::nextafter(keys[4].model[3].x, 2.0f);
+    keys[4].model[3].z *= 1.0f + 4.0f * std::numeric_limits<float>::epsilon();
+    EXPECT_EQ(0u, ShadowMapManager::updateStaticCacheKeys(cached, keys));
+
+    // a spotlight moved, the whole layer is re-rendered
+    keys[4].model = mat4f::translation(float3{ 1.1f, 10, 100 });
+    EXPECT_EQ(0b10u, ShadowMapManager::updateStaticCacheKeys(cached, keys));
+    EXPECT_EQ(0u, ShadowMapManager::updateStaticCacheKeys(cached, keys));
+
+    // a static shadow caster entered or left the cascade
+    keys[0].castersHash = 0x5678u;
+    EXPECT_EQ(0b01u, ShadowMapManager::updateStaticCacheKeys(cached, keys));
+
+    // a spotlight was moved to another square of its layer
+    keys[5].atlasOffset = { 0, 512 };
+    EXPECT_EQ(0b10u, ShadowMapManager::updateStaticCacheKeys(cached, keys));
+
+    // spot1 has no visible shadows while spot0 changes, so its square is cleared...
+    const Key hidden = keys[5];
+    keys[5] = {};
+    keys[4].polygonOffset = { 1.0f, 2.0f };
+    EXPECT_EQ(0b10u, ShadowMapManager::updateStaticCacheKeys(cached, keys));
+    EXPECT_FALSE(cached[5].valid);
+
+    // ...and it's re-rendered when it shows up again, even though it didn't move
+    keys[5] = hidden;
+    EXPECT_EQ(0b10u, ShadowMapManager::updateStaticCacheKeys(cached, keys));
+    EXPECT_TRUE(cached[5].valid);
+
+    // the cascade has no visible shadows, but its layer is left alone
+    keys[0] = {};
+    EXPECT_EQ(0u, ShadowMapManager::updateStaticCacheKeys(cached, keys));
+    EXPECT_TRUE(cached[0].valid);
+}
+
 TEST(FilamentTest, ColorConversion) {
     // Linear to Gamma
     // 0.0 stays 0.0
@@ -727,6 +987,196 @@ TEST(FilamentTest, FroxelData) {
     Engine::destroy((Engine **)&engine);
 }
 
+TEST(FilamentTest, FroxelSpotLightTiles) {
+    using namespace filament;
+
+    FEngine* engine = FEngine::create(Engine::Backend::NOOP);
+
+    LinearAllocatorArena arena("FRenderer: per-frame allocator", FEngine::CONFIG_PER_RENDER_PASS_ARENA_SIZE);
+    utils::ArenaScope<LinearAllocatorArena> scope(arena);
+
+    Viewport vp(0, 0, 1280, 640);
+    mat4f p = mat4f::perspective(90, 2.0f, 0.1, 100, mat4f::Fov::HORIZONTAL);
+
+    Froxelizer froxelizer(*engine);
+    froxelizer.setOptions(5, 100);
+    froxelizer.prepare(engine->getDriverApi(), scope, vp, p, 0.1, 100);
+
+    // A fixed set of spotlights, and of point lights with the same bounding spheres. Before
+    // spotlights were tested per tile, the froxels of a spotlight were the froxels of its
+    // bounding sphere whose bounding sphere intersects the cone, check we still get these.
+    constexpr size_t LIGHT_COUNT = 32;
+    std::mt19937 gen(42);
+    auto random = [&gen](float min, float max) {
+        return min + (max - min) * float(gen() - gen.min()) / float(gen.max() - gen.min());
+    };
+
+    FLightManager& lcm = engine->getLightManager();
+    FScene::LightSoa spotLights;
+    FScene::LightSoa pointLights;
+    spotLights.push_back({}, {}, {}, {}, {}, {});   // first one is always skipped
+    pointLights.push_back({}, {}, {}, {}, {}, {});
+    for (size_t i = 0; i < LIGHT_COUNT; i++) {
+        const float4 sphere{ random(-10, 10), random(-5, 5), random(-40, -8), random(0.5f, 2.5f) };
+        const float3 direction = normalize(float3{ random(-1, 1), random(-1, 1), random(-1, 1) });
+
+        Entity spot = engine->getEntityManager().create();
+        LightManager::Builder(LightManager::Type::SPOT)
+                .falloff(sphere.w)
+                .spotLightCone(0.1f, random(0.2f, 0.8f))
+                .build(*engine, spot);
+        Entity point = engine->getEntityManager().create();
+        LightManager::Builder(LightManager::Type::POINT)
+                .falloff(sphere.w)
+                .build(*engine, point);
+
+        spotLights.push_back(sphere, direction, lcm.getInstance(spot), 1, {}, {});
+        pointLights.push_back(sphere, direction, lcm.getInstance(point), 1, {}, {});
+    }
+
+    auto getFroxelLights = [&froxelizer]() {
+        std::vector<std::bitset<LIGHT_COUNT>> lights(froxelizer.getFroxelCount());
+        auto const& froxelBuffer = froxelizer.getFroxelBufferUser();
+        auto const& recordBuffer = froxelizer.getRecordBufferUser();
+        for (size_t i = 0; i < lights.size(); i++) {
+            for (size_t j = 0; j < froxelBuffer[i].count; j++) {
+                lights[i].set(recordBuffer[froxelBuffer[i].offset + j]);
+            }
+        }
+        return lights;
+    };
+
+    froxelizer.froxelizeLights(*engine, {}, pointLights);
+    const auto pointFroxels = getFroxelLights();
+    froxelizer.froxelizeLights(*engine, {}, spotLights);
+    const auto spotFroxels = getFroxelLights();
+
+    size_t pointCount = 0;
+    size_t spotCount = 0;
+    size_t mismatchCount = 0;
+    for (size_t f = 0; f < spotFroxels.size(); f++) {
+        std::bitset<LIGHT_COUNT> expected;
+        for (size_t i = 0; i < LIGHT_COUNT; i++) {
+            const FLightManager::Instance li = spotLights.elementAt<FScene::LIGHT_INSTANCE>(i + 1);
+            const bool intersect = sphereConeIntersectionFast(froxelizer.mBoundingSpheres[f],
+                    spotLights.elementAt<FScene::POSITION_RADIUS>(i + 1).xyz,
+                    spotLights.elementAt<FScene::DIRECTION>(i + 1),
+                    std::min(114.59301f, lcm.getSinInverse(li)),
+                    std::min(0.99992385f, lcm.getCosOuterSquared(li)));
+            expected[i] = pointFroxels[f][i] && intersect;
+        }
+        pointCount += pointFroxels[f].count();
+        spotCount += spotFroxels[f].count();
+        mismatchCount += (spotFroxels[f] != expected) ? 1 : 0;
+    }
+    EXPECT_EQ(mismatchCount, 0);
+    EXPECT_GT(spotCount, 0);
+    EXPECT_LT(spotCount, pointCount);
+
+    froxelizer.terminate(engine->getDriverApi());
+
+    Engine::destroy((Engine **)&engine);
+}
+
+TEST(FilamentTest, AdaptiveDynamicLightingRange) {
+    // the range is fitted to the visible depth range, with at least an octave between near and far
+    float2 range = FView::computeAdaptiveDynamicLightingRange(5.0f, 100.0f, { 20.0f, 40.0f });
+    EXPECT_GE(range.x, 5.0f);
+    EXPECT_LE(range.x, 20.0f);
+    EXPECT_GE(range.y, 40.0f);
+    EXPECT_LE(range.y, 100.0f);
+    EXPECT_GE(range.y, range.x * 2.0f);
+
+    // a thin visible range is widened to an octave
+    range = FView::computeAdaptiveDynamicLightingRange(5.0f, 100.0f, { 30.0f, 30.5f });
+    EXPECT_GE(range.x, 5.0f);
+    EXPECT_LE(range.y, 100.0f);
+    EXPECT_GE(range.y, range.x * 2.0f);
+
+    // the octave can't push the range past the user's range when it is narrower than that
+    range = FView::computeAdaptiveDynamicLightingRange(5.0f, 6.0f, { 5.5f, 5.6f });
+    EXPECT_EQ(range.x, 5.0f);
+    EXPECT_EQ(range.y, 6.0f);
+
+    // degenerate user range, near ~= far
+    range = FView::computeAdaptiveDynamicLightingRange(5.0f, 5.001f, { 1.0f, 200.0f });
+    EXPECT_EQ(range.x, 5.0f);
+    EXPECT_EQ(range.y, 5.001f);
+    range = FView::computeAdaptiveDynamicLightingRange(5.0f, 5.001f, { 5.0005f, 5.0006f });
+    EXPECT_EQ(range.x, 5.0f);
+    EXPECT_EQ(range.y, 5.001f);
+
+    // nothing visible within the user's range
+    range = FView::computeAdaptiveDynamicLightingRange(5.0f, 100.0f, { 200.0f, 300.0f });
+    EXPECT_GE(range.x, 5.0f);
+    EXPECT_EQ(range.y, 100.0f);
+    EXPECT_LT(range.x, range.y);
+    range = FView::computeAdaptiveDynamicLightingRange(5.0f, 100.0f, { 0.5f, 2.0f });
+    EXPECT_EQ(range.x, 5.0f);
+    EXPECT_LE(range.y, 100.0f);
+    EXPECT_LT(range.x, range.y);
+}
+
+TEST(FilamentTest, ScreenSpaceEffectsResolution) {
+    Engine* engine = Engine::create(Engine::Backend::NOOP);
+    View* view = engine->createView();
+
+    // SSAO resolution snaps to 1/4, 1/2 or 1
+    const std::pair<float, float> aoResolutions[] = {
+            { 0.0f, 0.25f }, { 0.25f, 0.25f }, { 0.3f, 0.25f }, { 0.4f, 0.5f },
+            { 0.5f, 0.5f }, { 0.7f, 0.5f }, { 0.8f, 1.0f }, { 1.0f, 1.0f }, { 2.0f, 1.0f } };
+    for (auto [in, out] : aoResolutions) {
+        view->setAmbientOcclusionOptions({ .resolution = in });
+        EXPECT_EQ(out, view->getAmbientOcclusionOptions().resolution) << in;
+    }
+
+    // SSR resolution snaps to 1/2 or 1
+    const std::pair<float, float> ssrResolutions[] = {
+            { 0.0f, 0.5f }, { 0.25f, 0.5f }, { 0.5f, 0.5f }, { 0.7f, 0.5f },
+            { 0.8f, 1.0f }, { 1.0f, 1.0f }, { 2.0f, 1.0f } };
+    for (auto [in, out] : ssrResolutions) {
+        view->setScreenSpaceReflectionsOptions({ .resolution = in });
+        EXPECT_EQ(out, view->getScreenSpaceReflectionsOptions().resolution) << in;
+    }
+
+    engine->destroy(view);
+    Engine::destroy(&engine);
+}
+
+TEST(FilamentTest, DynamicResolutionController) {
+    // the major axis is scaled down first
+    float2 s = DynamicResolutionController::getAxisScale(0.75f, 1920.0f, 1080.0f, false);
+    EXPECT_FLOAT_EQ(0.75f, s.x);
+    EXPECT_FLOAT_EQ(1.0f, s.y);
+    s = DynamicResolutionController::getAxisScale(0.25f, 1080.0f, 1920.0f, true);
+    EXPECT_FLOAT_EQ(0.5f, s.x);
+    EXPECT_FLOAT_EQ(0.5f, s.y);
+
+    // the GPU time is proportional to the scale factor and we start at twice the target
+    PredictiveResolutionController controller;
+    auto gpuTime = [](float scale) { return 32.0f * scale; };
+    float scale = 1.0f;
+    for (size_t i = 0; i < 100; i++) {
+        scale = controller.update({ .gpuFrameTime = gpuTime(scale), .cpuFrameTime = 4.0f,
+                .target = 16.0f, .scaleRate = 0.125f, .latency = 4 }, scale);
+    }
+    EXPECT_LE(gpuTime(scale), 16.0f);
+    EXPECT_GE(gpuTime(scale), 16.0f * (1.0f - PredictiveResolutionController::HYSTERESIS));
+
+    // within the hysteresis band, the scale factor doesn't change
+    const float settled = scale;
+    for (size_t i = 0; i < 100; i++) {
+        scale = controller.update({ .gpuFrameTime = 15.0f, .cpuFrameTime = 4.0f,
+                .target = 16.0f, .scaleRate = 0.125f, .latency = 4 }, scale);
+    }
+    EXPECT_EQ(settled, scale);
+
+    // when the CPU misses the target, the GPU can use the CPU frame time
+    PredictiveResolutionController cpuBound;
+    EXPECT_EQ(1.0f, cpuBound.update({ .gpuFrameTime = 20.0f, .cpuFrameTime = 22.0f,
+            .target = 16.0f, .scaleRate = 0.125f, .latency = 0 }, 1.0f));
+}
+
 TEST(FilamentTest, GoogleLineDirective) {
     {
         char s[512] = "#line 10 \"foobar\"";
@@ -772,6 +1222,47 @@ TEST(FilamentTest, GoogleLineDirective) {
     }
 }
 
+#if defined(FILAMENT_SUPPORTS_OPENGL)
+TEST(FilamentTest, HandleAllocatorStats) {
+    using namespace filament::backend;
+    struct SmallHandle {    // allocated in the first pool
+        uint32_t value;
+    };
+
+    // the first pool gets 1/4 of the arena, i.e. 64 handles of 16 bytes
+    HandleAllocatorGL allocator("Handles", 4096, { 1, 1, 2 });
+    const uint32_t capacity = allocator.getStats().pools[0].capacity;
+    EXPECT_EQ(capacity, 64);
+
+    // allocate past the end of the pool, the extra handles fall back to the heap
+    std::vector<Handle<SmallHandle>> handles;
+    for (uint32_t i = 0; i < capacity + 3; i++) {
+        handles.push_back(allocator.allocateAndConstruct<SmallHandle>(SmallHandle{ i }));
+    }
+    auto stats = allocator.getStats();
+    EXPECT_EQ(stats.pools[0].count, capacity);
+    EXPECT_EQ(stats.pools[0].highWatermark, capacity);
+    EXPECT_EQ(stats.pools[0].overflowCount, 3);
+    EXPECT_EQ(stats.pools[1].count, 0);
+    EXPECT_EQ(stats.pools[2].count, 0);
+    EXPECT_EQ(stats.heapHandleCount, 3);
+
+    // handles are valid wherever they were allocated
+    for (uint32_t i = 0; i < handles.size(); i++) {
+        EXPECT_EQ(allocator.handle_cast<SmallHandle*>(handles[i])->value, i);
+    }
+
+    for (auto& handle : handles) {
+        allocator.deallocate(handle);
+    }
+    stats = allocator.getStats();
+    EXPECT_EQ(stats.pools[0].count, 0);
+    EXPECT_EQ(stats.pools[0].highWatermark, capacity);
+    EXPECT_EQ(stats.pools[0].overflowCount, 3);
+    EXPECT_EQ(stats.heapHandleCount, 0);
+}
+#endif
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -253,6 +253,7 @@ struct ShadowUib { // NOLINT(cppcoreguidelines-pro-type-member-init)
         math::float3 direction;
         float normalBias;
         math::float4 lightFromWorldZ;
+        math::float4 scissorNormalized;     // this shadow map's cell in the atlas, in uv space
 
         float texelSizeAtOneMeter;
         float bulbRadiusLs;
@@ -21,27 +21,78 @@
 
 #include <utils/Profiler.h>
 
+#include <atomic>
+
+#include <stdio.h>
+
+/*
+ * Reports hardware counters (perf_event on Linux and Android), averaged per iteration:
+ *  C    cpu cycles
+ *  I    instructions
+ *  CPI  cycles per instruction
+ *  CM   cache misses
+ *  CMR  cache miss rate
+ *  BPU  branch misses
+ *  BPR  branch miss rate
+ *
+ * Nothing is reported if the counters are not available, e.g. when running in a VM without
+ * a virtual PMU or when /proc/sys/kernel/perf_event_paranoid is greater than 2.
+ */
 class PerformanceCounters {
     benchmark::State& state;
     utils::Profiler profiler;
-    utils::Profiler::Counters counters{};
+    bool running = false;
 
 public:
     explicit PerformanceCounters(benchmark::State& state)
             : state(state) {
-        profiler.resetEvents(utils::Profiler::EV_CPU_CYCLES | utils::Profiler::EV_BPU_MISSES);
+        profiler.resetEvents(utils::Profiler::EV_CPU_CYCLES |
+                             utils::Profiler::EV_L1D_RATES |
+                             utils::Profiler::EV_BPU_RATES);
+        if (!profiler.isValid()) {
+            static std::atomic<bool> warned{ false };
+            if (!warned.exchange(true)) {
+                fprintf(stderr, "PerformanceCounters: hardware counters are not available "
+                                "(check /proc/sys/kernel/perf_event_paranoid)\n");
+            }
+            return;
+        }
+        profiler.reset();
         profiler.start();
+        running = true;
     }
+
+    void stop() {
+        if (running) {
+            profiler.stop();
+            running = false;
+        }
+    }
+
     ~PerformanceCounters() {
-        profiler.stop();
-        counters = profiler.readCounters();
-        if (profiler.isValid()) {
-            state.counters.insert({
-                    { "C",   { (double)counters.getCpuCycles(),    benchmark::Counter::kAvgIterations }},
-                    { "I",   { (double)counters.getInstructions(), benchmark::Counter::kAvgIterations }},
-                    { "BPU", { (double)counters.getBranchMisses(), benchmark::Counter::kAvgIterations }},
-                    { "CPI", { (double)counters.getCPI(),          benchmark::Counter::kAvgThreads }},
-            });
+        stop();
+        if (!profiler.isValid()) {
+            return;
+        }
+        const utils::Profiler::Counters counters = profiler.readCounters();
+        const uint32_t events = profiler.getEnabledEvents();
+        auto& c = state.counters;
+        c["I"] = { (double)counters.getInstructions(), benchmark::Counter::kAvgIterations };
+        if (events & utils::Profiler::EV_CPU_CYCLES) {
+            c["C"]   = { (double)counters.getCpuCycles(), benchmark::Counter::kAvgIterations };
+            c["CPI"] = { counters.getCPI(), benchmark::Counter::kAvgThreads };
+        }
+        if (events & utils::Profiler::EV_L1D_MISSES) {
+            c["CM"] = { (double)counters.getL1DMisses(), benchmark::Counter::kAvgIterations };
+            if (events & utils::Profiler::EV_L1D_REFS) {
+                c["CMR"] = { counters.getL1DMissRate(), benchmark::Counter::kAvgThreads };
+            }
+        }
+        if (events & utils::Profiler::EV_BPU_MISSES) {
+            c["BPU"] = { (double)counters.getBranchMisses(), benchmark::Counter::kAvgIterations };
+            if (events & utils::Profiler::EV_BPU_REFS) {
+                c["BPR"] = { counters.getBranchMissRate(), benchmark::Counter::kAvgThreads };
+            }
         }
     }
 };
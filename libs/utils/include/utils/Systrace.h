@@ -258,7 +258,51 @@ private:
 } // namespace utils
 
 // ------------------------------------------------------------------------------------------------
-#else // !ANDROID
+#elif defined(FILAMENT_TRACER_ENABLED) // !ANDROID
+// ------------------------------------------------------------------------------------------------
+
+/*
+ * On other platforms, the SYSTRACE_ macros can be routed to utils::Tracer, which records
+ * events in-process and exports them in the Chrome trace-event format.
+ */
+
+#include <utils/Tracer.h>
+
+#ifndef SYSTRACE_TAG
+#define SYSTRACE_TAG (SYSTRACE_TAG_ALWAYS)
+#endif
+
+// recording is controlled with utils::Tracer::start() / stop()
+#define SYSTRACE_ENABLE()
+#define SYSTRACE_DISABLE()
+
+// the Tracer doesn't need a context
+#define SYSTRACE_CONTEXT()
+
+#define SYSTRACE_NAME(name) ::utils::Tracer::Scope ___tracer(SYSTRACE_TAG, name)
+
+#define SYSTRACE_CALL() SYSTRACE_NAME(__FUNCTION__)
+
+#define SYSTRACE_NAME_BEGIN(name) \
+        ::utils::Tracer::begin(SYSTRACE_TAG, name)
+
+#define SYSTRACE_NAME_END() \
+        ::utils::Tracer::end(SYSTRACE_TAG)
+
+#define SYSTRACE_ASYNC_BEGIN(name, cookie) \
+        ::utils::Tracer::asyncBegin(SYSTRACE_TAG, name, cookie)
+
+#define SYSTRACE_ASYNC_END(name, cookie) \
+        ::utils::Tracer::asyncEnd(SYSTRACE_TAG, name, cookie)
+
+#define SYSTRACE_VALUE32(name, val) \
+        ::utils::Tracer::value(SYSTRACE_TAG, name, int64_t(int32_t(val)))
+
+#define SYSTRACE_VALUE64(name, val) \
+        ::utils::Tracer::value(SYSTRACE_TAG, name, int64_t(val))
+
+// ------------------------------------------------------------------------------------------------
+#else // !ANDROID && !FILAMENT_TRACER_ENABLED
 // ------------------------------------------------------------------------------------------------
 
 #define SYSTRACE_ENABLE()
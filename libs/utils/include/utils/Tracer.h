@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TNT_UTILS_TRACER_H
+#define TNT_UTILS_TRACER_H
+
+#include <utils/compiler.h>
+
+#include <atomic>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace utils {
+
+/*
+ * A lightweight in-process tracer.
+ *
+ * Each thread records its events into its own ring buffer, so recording never takes a lock
+ * (except the very first time a thread records an event). When the ring buffer is full, the
+ * oldest events are overwritten, the ends of the scopes whose beginning was overwritten are not
+ * exported. The recorded events can be exported in the Chrome trace-event JSON format, which can
+ * be loaded in chrome://tracing or ui.perfetto.dev.
+ *
+ * On non-Android platforms, the SYSTRACE_ macros are routed to the Tracer when filament is
+ * built with FILAMENT_ENABLE_TRACER. Recording is off until Tracer::start() is called, when off,
+ * each trace point costs a single relaxed load.
+ *
+ *  utils::Tracer::start();
+ *  // ... render some frames ...
+ *  utils::Tracer::stop();
+ *  utils::Tracer::exportChromeTrace("/tmp/filament.json");
+ */
+class UTILS_PUBLIC Tracer {
+public:
+    static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 64 * 1024;
+
+    /*
+     * Starts recording. eventsPerThread is the size of each thread's ring buffer, it is only
+     * taken into account by threads which haven't recorded anything yet.
+     */
+    static void start(size_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD) noexcept;
+
+    // stops recording, the recorded events are kept
+    static void stop() noexcept;
+
+    // discards all recorded events
+    static void clear() noexcept;
+
+    static bool isRecording() noexcept {
+        return sRecording.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Writes all recorded events to the file at path, in the Chrome trace-event JSON format.
+     * This should be called after stop(), otherwise the events being recorded concurrently
+     * might be partially written. Returns false if the file couldn't be written.
+     */
+    static bool exportChromeTrace(const char* path) noexcept;
+
+    /*
+     * Sets the name the calling thread will appear as in the trace. By default the system
+     * thread name is used.
+     */
+    static void setThreadName(const char* name) noexcept;
+
+    static void begin(uint32_t tag, const char* name) noexcept {
+        if (tag && UTILS_UNLIKELY(isRecording())) {
+            record(Type::BEGIN, name, 0);
+        }
+    }
+
+    static void end(uint32_t tag) noexcept {
+        if (tag && UTILS_UNLIKELY(isRecording())) {
+            record(Type::END, nullptr, 0);
+        }
+    }
+
+    static void asyncBegin(uint32_t tag, const char* name, int32_t cookie) noexcept {
+        if (tag && UTILS_UNLIKELY(isRecording())) {
+            record(Type::ASYNC_BEGIN, name, cookie);
+        }
+    }
+
+    static void asyncEnd(uint32_t tag, const char* name, int32_t cookie) noexcept {
+        if (tag && UTILS_UNLIKELY(isRecording())) {
+            record(Type::ASYNC_END, name, cookie);
+        }
+    }
+
+    static void value(uint32_t tag, const char* name, int64_t value) noexcept {
+        if (tag && UTILS_UNLIKELY(isRecording())) {
+            record(Type::COUNTER, name, value);
+        }
+    }
+
+    // Traces the beginning and end of the enclosing scope
+    class Scope {
+    public:
+        Scope(uint32_t tag, const char* name) noexcept
+                : mTag(tag && isRecording() ? tag : 0) {
+            if (UTILS_UNLIKELY(mTag)) {
+                record(Type::BEGIN, name, 0);
+            }
+        }
+
+        ~Scope() noexcept {
+            // always close a scope we opened, even if recording was stopped meanwhile
+            if (UTILS_UNLIKELY(mTag)) {
+                record(Type::END, nullptr, 0);
+            }
+        }
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        const uint32_t mTag;
+    };
+
+private:
+    enum class Type : uint8_t {
+        BEGIN, END, ASYNC_BEGIN, ASYNC_END, COUNTER
+    };
+
+    static void record(Type type, const char* name, int64_t value) noexcept;
+
+    static std::atomic<bool> sRecording;
+};
+
+} // namespace utils
+
+#endif // TNT_UTILS_TRACER_H
@@ -36,6 +36,7 @@ static constexpr bool DEBUG_FINISH_HANGS = false;
 #include <random>
 
 #include <math.h>
+#include <stdio.h>
 
 #if !defined(WIN32)
 #    include <pthread.h>
@@ -70,8 +71,49 @@ static constexpr bool DEBUG_FINISH_HANGS = false;
 #   define HEAVY_SYSTRACE_VALUE32(name, v)
 #endif
 
+// The in-process tracer is cheap enough when it's not recording that we always trace jobs with it,
+// this lets us see which worker ran what.
+#if defined(FILAMENT_TRACER_ENABLED) && !defined(__ANDROID__)
+#   include <utils/CallStack.h>
+#   include <utils/CString.h>
+#   include <utils/Tracer.h>
+#   include <tsl/robin_map.h>
+#   if defined(__linux__) || defined(__APPLE__)
+#       include <dlfcn.h>
+#   endif
+#   define JOB_TRACE(function)              Tracer::Scope ___jobTracer(SYSTRACE_TAG_JOBSYSTEM, \
+            Tracer::isRecording() ? getJobTraceName(function) : nullptr)
+#else
+#   define JOB_TRACE(function)
+#endif
+
 namespace utils {
 
+#if defined(FILAMENT_TRACER_ENABLED) && !defined(__ANDROID__)
+// Jobs are named after the function they run: its symbol if it is exported, its address otherwise
+// (which can be symbolized offline). Resolving a symbol is slow, so each thread caches the names.
+static const char* getJobTraceName(JobSystem::JobFunc function) noexcept {
+    thread_local tsl::robin_map<JobSystem::JobFunc, CString> names;
+    auto pos = names.find(function);
+    if (UTILS_UNLIKELY(pos == names.end())) {
+        CString name;
+#if defined(__linux__) || defined(__APPLE__)
+        Dl_info info;
+        if (dladdr((void*)function, &info) && info.dli_sname && info.dli_saddr == (void*)function) {
+            name = CallStack::demangleTypeName(info.dli_sname);
+        }
+#endif
+        if (name.empty()) {
+            char address[32];
+            snprintf(address, sizeof(address), "job %p", (void*)function);
+            name = CString(address);
+        }
+        pos = names.emplace(function, std::move(name)).first;
+    }
+    return pos->second.c_str();
+}
+#endif
+
 void JobSystem::setThreadName(const char* name) noexcept {
 #if defined(__linux__)
     pthread_setname_np(pthread_self(), name);
@@ -386,6 +428,7 @@ bool JobSystem::execute(JobSystem::ThreadState& state) noexcept {
 
         if (UTILS_LIKELY(job->function)) {
             HEAVY_SYSTRACE_NAME("job->function");
+            JOB_TRACE(job->function);
             job->function(job->storage, *this, job);
         }
         finish(job);
@@ -27,6 +27,7 @@
 #endif
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 
 #if defined(__linux__)
@@ -108,7 +109,7 @@ uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
             pe.type = PERF_TYPE_HARDWARE;
             pe.config = PERF_COUNT_HW_CPU_CYCLES;
             mCountersFd[CPU_CYCLES] = perf_event_open(&pe, 0, -1, groupFd, 0);
-            if (mCountersFd[CPU_CYCLES] > 0) {
+            if (mCountersFd[CPU_CYCLES] >= 0) {
                 mIds[CPU_CYCLES] = count++;
                 mEnabledEvents |= EV_CPU_CYCLES;
             }
@@ -118,7 +119,7 @@ uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
             pe.type = PERF_TYPE_HARDWARE;
             pe.config = PERF_COUNT_HW_CACHE_REFERENCES;
             mCountersFd[DCACHE_REFS] = perf_event_open(&pe, 0, -1, groupFd, 0);
-            if (mCountersFd[DCACHE_REFS] > 0) {
+            if (mCountersFd[DCACHE_REFS] >= 0) {
                 mIds[DCACHE_REFS] = count++;
                 mEnabledEvents |= EV_L1D_REFS;
             }
@@ -128,7 +129,7 @@ uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
             pe.type = PERF_TYPE_HARDWARE;
             pe.config = PERF_COUNT_HW_CACHE_MISSES;
             mCountersFd[DCACHE_MISSES] = perf_event_open(&pe, 0, -1, groupFd, 0);
-            if (mCountersFd[DCACHE_MISSES] > 0) {
+            if (mCountersFd[DCACHE_MISSES] >= 0) {
                 mIds[DCACHE_MISSES] = count++;
                 mEnabledEvents |= EV_L1D_MISSES;
             }
@@ -138,7 +139,7 @@ uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
             pe.type = PERF_TYPE_HARDWARE;
             pe.config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS;
             mCountersFd[BRANCHES] = perf_event_open(&pe, 0, -1, groupFd, 0);
-            if (mCountersFd[BRANCHES] > 0) {
+            if (mCountersFd[BRANCHES] >= 0) {
                 mIds[BRANCHES] = count++;
                 mEnabledEvents |= EV_BPU_REFS;
             }
@@ -148,7 +149,7 @@ uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
             pe.type = PERF_TYPE_HARDWARE;
             pe.config = PERF_COUNT_HW_BRANCH_MISSES;
             mCountersFd[BRANCH_MISSES] = perf_event_open(&pe, 0, -1, groupFd, 0);
-            if (mCountersFd[BRANCH_MISSES] > 0) {
+            if (mCountersFd[BRANCH_MISSES] >= 0) {
                 mIds[BRANCH_MISSES] = count++;
                 mEnabledEvents |= EV_BPU_MISSES;
             }
@@ -159,7 +160,7 @@ uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
             pe.type = PERF_TYPE_RAW;
             pe.config = ARMV8_PMUV3_PERFCTR_L1_ICACHE_ACCESS;
             mCountersFd[ICACHE_REFS] = perf_event_open(&pe, 0, -1, groupFd, 0);
-            if (mCountersFd[ICACHE_REFS] > 0) {
+            if (mCountersFd[ICACHE_REFS] >= 0) {
                 mIds[ICACHE_REFS] = count++;
                 mEnabledEvents |= EV_L1I_REFS;
             }
@@ -169,7 +170,7 @@ uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
             pe.type = PERF_TYPE_RAW;
             pe.config = ARMV8_PMUV3_PERFCTR_L1_ICACHE_REFILL;
             mCountersFd[ICACHE_MISSES] = perf_event_open(&pe, 0, -1, groupFd, 0);
-            if (mCountersFd[ICACHE_MISSES] > 0) {
+            if (mCountersFd[ICACHE_MISSES] >= 0) {
                 mIds[ICACHE_MISSES] = count++;
                 mEnabledEvents |= EV_L1I_MISSES;
             }
@@ -180,7 +181,7 @@ uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
             pe.config = PERF_COUNT_HW_CACHE_L1I | 
                 (PERF_COUNT_HW_CACHE_OP_READ<<8) | (PERF_COUNT_HW_CACHE_RESULT_ACCESS<<16);
             mCountersFd[ICACHE_REFS] = perf_event_open(&pe, 0, -1, groupFd, 0);
-            if (mCountersFd[ICACHE_REFS] > 0) {
+            if (mCountersFd[ICACHE_REFS] >= 0) {
                 mIds[ICACHE_REFS] = count++;
                 mEnabledEvents |= EV_L1I_REFS;
             }
@@ -191,7 +192,7 @@ uint32_t Profiler::resetEvents(uint32_t eventMask) noexcept {
             pe.config = PERF_COUNT_HW_CACHE_L1I | 
                 (PERF_COUNT_HW_CACHE_OP_READ<<8) | (PERF_COUNT_HW_CACHE_RESULT_MISS<<16);
             mCountersFd[ICACHE_MISSES] = perf_event_open(&pe, 0, -1, groupFd, 0);
-            if (mCountersFd[ICACHE_MISSES] > 0) {
+            if (mCountersFd[ICACHE_MISSES] >= 0) {
                 mIds[ICACHE_MISSES] = count++;
                 mEnabledEvents |= EV_L1I_MISSES;
             }
@@ -212,10 +213,17 @@ Profiler::Counters Profiler::readCounters() noexcept {
         outCounters.nr = counters.nr;
         outCounters.time_enabled = counters.time_enabled;
         outCounters.time_running = counters.time_running;
+        // When there are more events than hardware counters, the kernel multiplexes the
+        // groups, in which case we extrapolate the counts over the whole enabled time.
+        const bool multiplexed = counters.time_running &&
+                counters.time_running < counters.time_enabled;
+        const double scale = multiplexed ?
+                double(counters.time_enabled) / double(counters.time_running) : 1.0;
         for (size_t i = 0; i < size_t(EVENT_COUNT); i++) {
             // in theory we should check that mCountersFd[i] >= 0, but we don't to avoid
             // a branch, mIds[] is initialized such we won't access past the counters array.
             outCounters.counters[i] = counters.counters[mIds[i]];
+            outCounters.counters[i].value = uint64_t(double(outCounters.counters[i].value) * scale);
         }
     }
     return outCounters;
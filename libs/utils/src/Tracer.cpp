@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <utils/Tracer.h>
+
+#include <utils/Log.h>
+#include <utils/Mutex.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+namespace utils {
+
+namespace {
+
+struct Event {
+    uint64_t timestamp;     // nanoseconds, steady clock
+    int64_t value;          // counter value or async cookie
+    uint8_t type;
+    char name[47];          // names are copied, they can live on the stack of the caller
+};
+
+static_assert(sizeof(Event) == 64);
+
+struct ThreadBuffer {
+    ThreadBuffer(uint32_t id, size_t capacity, uint32_t epoch) noexcept
+            : events(new Event[capacity]), capacity(capacity), id(id), epoch(epoch) {
+    }
+    std::unique_ptr<Event[]> events;
+    const size_t capacity;
+    const uint32_t id;
+    // only written by the owning thread
+    std::atomic<uint64_t> head{};
+    // clear epoch the events belong to, only written by the owning thread
+    std::atomic<uint32_t> epoch;
+    char name[32] = {};
+};
+
+struct Registry {
+    Mutex lock;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    size_t eventsPerThread = Tracer::DEFAULT_EVENTS_PER_THREAD;
+    // incremented by clear(), each thread discards its events when it sees a new epoch
+    std::atomic<uint32_t> epoch{};
+};
+
+// thread buffers are never destroyed, so that events of threads that exited can be exported.
+Registry& getRegistry() noexcept {
+    static Registry* registry = new Registry();
+    return *registry;
+}
+
+thread_local ThreadBuffer* tlsThreadBuffer = nullptr;
+
+UTILS_NOINLINE
+ThreadBuffer* registerThread() noexcept {
+    Registry& registry = getRegistry();
+    std::lock_guard<Mutex> guard(registry.lock);
+    auto buffer = std::make_unique<ThreadBuffer>(
+            uint32_t(registry.buffers.size() + 1), registry.eventsPerThread,
+            registry.epoch.load(std::memory_order_relaxed));
+#if defined(__linux__) || defined(__APPLE__)
+    pthread_getname_np(pthread_self(), buffer->name, sizeof(buffer->name));
+#endif
+    if (!buffer->name[0]) {
+        snprintf(buffer->name, sizeof(buffer->name), "thread %u", buffer->id);
+    }
+    ThreadBuffer* const p = buffer.get();
+    registry.buffers.push_back(std::move(buffer));
+    return p;
+}
+
+inline ThreadBuffer* getThreadBuffer() noexcept {
+    ThreadBuffer* buffer = tlsThreadBuffer;
+    if (UTILS_UNLIKELY(!buffer)) {
+        buffer = tlsThreadBuffer = registerThread();
+    }
+    return buffer;
+}
+
+// returns the range of events of a buffer, a buffer which hasn't seen the last clear() is empty
+std::pair<uint64_t, uint64_t> getEventRange(ThreadBuffer const& buffer, uint32_t epoch) noexcept {
+    if (buffer.epoch.load(std::memory_order_acquire) != epoch) {
+        return { 0, 0 };
+    }
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    const uint64_t first = head > buffer.capacity ? head - buffer.capacity : 0;
+    return { first, head };
+}
+
+void writeJsonString(FILE* file, const char* s) noexcept {
+    fputc('"', file);
+    for (; *s; s++) {
+        const char c = *s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', file);
+            fputc(c, file);
+        } else if ((unsigned char)c < 0x20) {
+            fprintf(file, "\\u%04x", c);
+        } else {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+} // anonymous namespace
+
+std::atomic<bool> Tracer::sRecording{ false };
+
+void Tracer::start(size_t eventsPerThread) noexcept {
+    Registry& registry = getRegistry();
+    registry.lock.lock();
+    registry.eventsPerThread = std::max(eventsPerThread, size_t(1));
+    registry.lock.unlock();
+    sRecording.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop() noexcept {
+    sRecording.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::clear() noexcept {
+    // The buffers are only written by their owning thread, which discards its events the next
+    // time it records one. Until then, the events are ignored by exportChromeTrace().
+    Registry& registry = getRegistry();
+    registry.epoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName(const char* name) noexcept {
+    ThreadBuffer* const buffer = getThreadBuffer();
+    Registry& registry = getRegistry();
+    std::lock_guard<Mutex> guard(registry.lock);
+    strncpy(buffer->name, name, sizeof(buffer->name) - 1);
+}
+
+void Tracer::record(Type type, const char* name, int64_t value) noexcept {
+    using namespace std::chrono;
+    ThreadBuffer* const buffer = getThreadBuffer();
+    const uint32_t epoch = getRegistry().epoch.load(std::memory_order_relaxed);
+    const bool cleared = buffer->epoch.load(std::memory_order_relaxed) != epoch;
+    const uint64_t head = cleared ? 0 : buffer->head.load(std::memory_order_relaxed);
+    Event& event = buffer->events[head % buffer->capacity];
+    event.timestamp = duration_cast<nanoseconds>(
+            steady_clock::now().time_since_epoch()).count();
+    event.value = value;
+    event.type = uint8_t(type);
+    if (name) {
+        strncpy(event.name, name, sizeof(event.name) - 1);
+        event.name[sizeof(event.name) - 1] = 0;
+    } else {
+        event.name[0] = 0;
+    }
+    buffer->head.store(head + 1, std::memory_order_release);
+    if (UTILS_UNLIKELY(cleared)) {
+        // published after the head, so that the events of the new epoch are consistent
+        buffer->epoch.store(epoch, std::memory_order_release);
+    }
+}
+
+bool Tracer::exportChromeTrace(const char* path) noexcept {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        slog.e << "Tracer: couldn't open " << path << io::endl;
+        return false;
+    }
+
+    Registry& registry = getRegistry();
+    std::lock_guard<Mutex> guard(registry.lock);
+    const uint32_t epoch = registry.epoch.load(std::memory_order_relaxed);
+
+    // all timestamps are relative to the oldest event we have
+    uint64_t origin = UINT64_MAX;
+    for (auto const& buffer : registry.buffers) {
+        const auto [first, head] = getEventRange(*buffer, epoch);
+        if (first < head) {
+            origin = std::min(origin, buffer->events[first % buffer->capacity].timestamp);
+        }
+    }
+
+    const char* separator = "";
+    fprintf(file, "{\"traceEvents\":[\n");
+    for (auto const& buffer : registry.buffers) {
+        const uint32_t tid = buffer->id;
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                      "\"args\":{\"name\":", separator, tid);
+        writeJsonString(file, buffer->name);
+        fprintf(file, "}}");
+        separator = ",\n";
+
+        // When the ring buffer wraps, the begin of a scope can be overwritten while its end is
+        // kept. Such orphaned ends would close a scope of the caller, so they're dropped.
+        uint32_t depth = 0;
+        const auto [first, head] = getEventRange(*buffer, epoch);
+        for (uint64_t i = first; i < head; i++) {
+            Event const& event = buffer->events[i % buffer->capacity];
+            if (Type(event.type) == Type::BEGIN) {
+                depth++;
+            } else if (Type(event.type) == Type::END) {
+                if (!depth) {
+                    continue;
+                }
+                depth--;
+            }
+            const double ts = double(event.timestamp - origin) / 1000.0; // in microseconds
+            switch (Type(event.type)) {
+                case Type::BEGIN:
+                    fprintf(file, "%s{\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":",
+                            separator, tid, ts);
+                    writeJsonString(file, event.name);
+                    fprintf(file, "}");
+                    break;
+                case Type::END:
+                    fprintf(file, "%s{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                            separator, tid, ts);
+                    break;
+                case Type::ASYNC_BEGIN:
+                case Type::ASYNC_END:
+                    fprintf(file, "%s{\"ph\":\"%c\",\"cat\":\"async\",\"id\":%lld,\"pid\":1,"
+                                  "\"tid\":%u,\"ts\":%.3f,\"name\":",
+                            separator, Type(event.type) == Type::ASYNC_BEGIN ? 'b' : 'e',
+                            (long long)event.value, tid, ts);
+                    writeJsonString(file, event.name);
+                    fprintf(file, "}");
+                    break;
+                case Type::COUNTER:
+                    fprintf(file, "%s{\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":",
+                            separator, tid, ts);
+                    writeJsonString(file, event.name);
+                    fprintf(file, ",\"args\":{\"value\":%lld}}", (long long)event.value);
+                    break;
+            }
+        }
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    const bool success = !ferror(file);
+    fclose(file);
+    return success;
+}
+
+} // namespace utils
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/Tracer.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <stdio.h>
+
+using namespace utils;
+
+static std::string exportTrace() {
+    const char* path = "test_Tracer.json";
+    EXPECT_TRUE(Tracer::exportChromeTrace(path));
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    remove(path);
+    return ss.str();
+}
+
+class TracerTest : public testing::Test {
+protected:
+    // the Tracer is global, don't leave it recording for the other tests
+    void TearDown() override {
+        Tracer::stop();
+        Tracer::clear();
+    }
+};
+
+TEST_F(TracerTest, NotRecording) {
+    Tracer::stop();
+    Tracer::clear();
+    {
+        Tracer::Scope scope(1, "notRecorded");
+    }
+    std::string json = exportTrace();
+    EXPECT_EQ(json.find("notRecorded"), std::string::npos);
+}
+
+TEST_F(TracerTest, NeverTag) {
+    Tracer::clear();
+    Tracer::start();
+    {
+        Tracer::Scope scope(0, "neverTag");
+    }
+    Tracer::stop();
+    std::string json = exportTrace();
+    EXPECT_EQ(json.find("neverTag"), std::string::npos);
+}
+
+TEST_F(TracerTest, Events) {
+    Tracer::clear();
+    Tracer::start();
+    {
+        Tracer::Scope scope(1, "outer \"scope\"");
+        Tracer::value(1, "counter", 42);
+        std::thread t([]() {
+            Tracer::setThreadName("worker");
+            Tracer::Scope scope(1, "inner");
+        });
+        t.join();
+    }
+    Tracer::stop();
+
+    std::string json = exportTrace();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"outer \\\"scope\\\"\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"inner\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"worker\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"value\":42}"), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"E\""), std::string::npos);
+}
+
+TEST_F(TracerTest, RingBufferWraps) {
+    Tracer::clear();
+    Tracer::start(16);
+    std::thread t([]() {
+        for (int i = 0; i < 100; i++) {
+            Tracer::value(1, i < 84 ? "old" : "recent", i);
+        }
+    });
+    t.join();
+    Tracer::stop();
+
+    std::string json = exportTrace();
+    EXPECT_EQ(json.find("\"old\""), std::string::npos);
+    EXPECT_NE(json.find("\"recent\""), std::string::npos);
+}
+
+TEST_F(TracerTest, OrphanedEndsAreDropped) {
+    Tracer::clear();
+    Tracer::start(4);
+    std::thread t([]() {
+        // the begin of the scope is overwritten, but not its end
+        Tracer::Scope scope(1, "overwritten");
+        for (int i = 0; i < 4; i++) {
+            Tracer::value(1, "counter", i);
+        }
+    });
+    t.join();
+    Tracer::stop();
+
+    std::string json = exportTrace();
+    EXPECT_EQ(json.find("\"overwritten\""), std::string::npos);
+    EXPECT_NE(json.find("\"counter\""), std::string::npos);
+    EXPECT_EQ(json.find("\"ph\":\"E\""), std::string::npos);
+}
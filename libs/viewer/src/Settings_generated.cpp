@@ -161,6 +161,23 @@ std::ostream& operator<<(std::ostream& out, BlendMode in) {
     return out << "\"INVALID\"";
 }
 
+int parse(jsmntok_t const* tokens, int i, const char* jsonChunk, DynamicResolutionOptions::Controller* out) {
+    if (0 == compare(tokens[i], jsonChunk, "PID")) { *out = DynamicResolutionOptions::Controller::PID; }
+    else if (0 == compare(tokens[i], jsonChunk, "PREDICTIVE")) { *out = DynamicResolutionOptions::Controller::PREDICTIVE; }
+    else {
+        slog.w << "Invalid DynamicResolutionOptions::Controller: '" << STR(tokens[i], jsonChunk) << "'" << io::endl;
+    }
+    return i + 1;
+}
+
+std::ostream& operator<<(std::ostream& out, DynamicResolutionOptions::Controller in) {
+    switch (in) {
+        case DynamicResolutionOptions::Controller::PID: return out << "\"PID\"";
+        case DynamicResolutionOptions::Controller::PREDICTIVE: return out << "\"PREDICTIVE\"";
+    }
+    return out << "\"INVALID\"";
+}
+
 int parse(jsmntok_t const* tokens, int i, const char* jsonChunk, DynamicResolutionOptions* out) {
     CHECK_TOKTYPE(tokens[i], JSMN_OBJECT);
     int size = tokens[i++].size;
@@ -179,6 +196,8 @@ int parse(jsmntok_t const* tokens, int i, const char* jsonChunk, DynamicResoluti
             i = parse(tokens, i + 1, jsonChunk, &out->homogeneousScaling);
         } else if (compare(tok, jsonChunk, "quality") == 0) {
             i = parse(tokens, i + 1, jsonChunk, &out->quality);
+        } else if (compare(tok, jsonChunk, "controller") == 0) {
+            i = parse(tokens, i + 1, jsonChunk, &out->controller);
         } else {
             slog.w << "Invalid DynamicResolutionOptions key: '" << STR(tok, jsonChunk) << "'" << io::endl;
             i = parse(tokens, i + 1);
@@ -198,7 +217,8 @@ std::ostream& operator<<(std::ostream& out, const DynamicResolutionOptions& in)
         << "\"sharpness\": " << (in.sharpness) << ",\n"
         << "\"enabled\": " << to_string(in.enabled) << ",\n"
         << "\"homogeneousScaling\": " << to_string(in.homogeneousScaling) << ",\n"
-        << "\"quality\": " << (in.quality) << "\n"
+        << "\"quality\": " << (in.quality) << ",\n"
+        << "\"controller\": " << (in.controller) << "\n"
         << "}";
 }
 
@@ -685,6 +705,8 @@ int parse(jsmntok_t const* tokens, int i, const char* jsonChunk, ScreenSpaceRefl
             i = parse(tokens, i + 1, jsonChunk, &out->maxDistance);
         } else if (compare(tok, jsonChunk, "stride") == 0) {
             i = parse(tokens, i + 1, jsonChunk, &out->stride);
+        } else if (compare(tok, jsonChunk, "resolution") == 0) {
+            i = parse(tokens, i + 1, jsonChunk, &out->resolution);
         } else if (compare(tok, jsonChunk, "enabled") == 0) {
             i = parse(tokens, i + 1, jsonChunk, &out->enabled);
         } else {
@@ -705,6 +727,7 @@ std::ostream& operator<<(std::ostream& out, const ScreenSpaceReflectionsOptions&
         << "\"bias\": " << (in.bias) << ",\n"
         << "\"maxDistance\": " << (in.maxDistance) << ",\n"
         << "\"stride\": " << (in.stride) << ",\n"
+        << "\"resolution\": " << (in.resolution) << ",\n"
         << "\"enabled\": " << to_string(in.enabled) << "\n"
         << "}";
 }
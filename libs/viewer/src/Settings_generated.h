@@ -36,6 +36,9 @@ std::ostream& operator<<(std::ostream& out, QualityLevel in);
 int parse(jsmntok_t const* tokens, int i, const char* jsonChunk, BlendMode* out);
 std::ostream& operator<<(std::ostream& out, BlendMode in);
 
+int parse(jsmntok_t const* tokens, int i, const char* jsonChunk, DynamicResolutionOptions::Controller* out);
+std::ostream& operator<<(std::ostream& out, DynamicResolutionOptions::Controller in);
+
 int parse(jsmntok_t const* tokens, int i, const char* jsonChunk, DynamicResolutionOptions* out);
 std::ostream& operator<<(std::ostream& out, const DynamicResolutionOptions& in);
 
@@ -749,15 +749,15 @@ void ViewerGui::updateUserInterface() {
             int lowpass = (int) ssao.lowPassFilter;
             bool upsampling = ssao.upsampling != View::QualityLevel::LOW;
 
-            bool halfRes = ssao.resolution == 1.0f ? false : true;
+            int resolution = ssao.resolution == 1.0f ? 0 : (ssao.resolution == 0.5f ? 1 : 2);
             ImGui::SliderInt("Quality", &quality, 0, 3);
             ImGui::SliderInt("Low Pass", &lowpass, 0, 2);
             ImGui::Checkbox("Bent Normals", &ssao.bentNormals);
             ImGui::Checkbox("High quality upsampling", &upsampling);
             ImGui::SliderFloat("Min Horizon angle", &ssao.minHorizonAngleRad, 0.0f, (float)M_PI_4);
             ImGui::SliderFloat("Bilateral Threshold", &ssao.bilateralThreshold, 0.0f, 0.1f);
-            ImGui::Checkbox("Half resolution", &halfRes);
-            ssao.resolution = halfRes ? 0.5f : 1.0f;
+            ImGui::Combo("Resolution##ssao", &resolution, "Full\0Half\0Quarter\0\0");
+            ssao.resolution = 1.0f / float(1 << resolution);
 
 
             ssao.upsampling = upsampling ? View::QualityLevel::HIGH : View::QualityLevel::LOW;
@@ -786,6 +786,9 @@ void ViewerGui::updateUserInterface() {
             ImGui::SliderFloat("Bias", &ssrefl.bias, 0.001f, 0.5f);
             ImGui::SliderFloat("Max distance", &ssrefl.maxDistance, 0.1, 10.0f);
             ImGui::SliderFloat("Stride", &ssrefl.stride, 1.0, 10.0f);
+            bool halfRes = ssrefl.resolution != 1.0f;
+            ImGui::Checkbox("Half resolution##ssr", &halfRes);
+            ssrefl.resolution = halfRes ? 0.5f : 1.0f;
         }
         ImGui::Unindent();
 
@@ -797,6 +800,8 @@ void ViewerGui::updateUserInterface() {
         int quality = (int)dsr.quality;
         ImGui::Checkbox("enabled", &dsr.enabled);
         ImGui::Checkbox("homogeneous", &dsr.homogeneousScaling);
+        bool predictive = dsr.controller == View::DynamicResolutionOptions::Controller::PREDICTIVE;
+        ImGui::Checkbox("predictive", &predictive);
         ImGui::SliderFloat("min. scale", &dsr.minScale.x, 0.25f, 1.0f);
         ImGui::SliderFloat("max. scale", &dsr.maxScale.x, 0.25f, 1.0f);
         ImGui::SliderInt("quality", &quality, 0, 3);
@@ -805,6 +810,8 @@ void ViewerGui::updateUserInterface() {
         dsr.minScale.y = dsr.minScale.x;
         dsr.maxScale.y = dsr.maxScale.x;
         dsr.quality = (QualityLevel)quality;
+        dsr.controller = predictive ? View::DynamicResolutionOptions::Controller::PREDICTIVE
+                : View::DynamicResolutionOptions::Controller::PID;
     }
 
     auto& light = mSettings.lighting;
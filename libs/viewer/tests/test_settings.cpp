@@ -44,7 +44,8 @@ static const char* JSON_TEST_DEFAULTS = R"TXT(
             "sharpness": 0.9,
             "enabled": false,
             "homogeneousScaling": false,
-            "quality": "MEDIUM"
+            "quality": "MEDIUM",
+            "controller": "PID"
         },
         "colorGrading": {
             "enabled": true,
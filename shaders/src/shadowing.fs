@@ -17,8 +17,13 @@
 // PCF Shadow Sampling
 //------------------------------------------------------------------------------
 
-float sampleDepth(const mediump sampler2DArrayShadow map, const uint layer,
-        const highp vec2 uv, float depth) {
+float sampleDepth(const mediump sampler2DArrayShadow map,
+        const highp vec4 scissorNormalized, const uint layer, highp vec2 uv, float depth) {
+    // Shadow maps are packed in an atlas, we must not sample outside of this map's cell, or we'd
+    // read another shadow map. The scissor rectangle excludes the 1-texel border, so that a
+    // bilinear lookup at its edge only reads texels of this map.
+    uv = clamp(uv, scissorNormalized.xy, scissorNormalized.zw);
+
     // depth must be clamped to support floating-point depth formats. This is to avoid comparing a
     // value from the depth texture (which is never greater than 1.0) with a greater-than-one
     // comparison value (which is possible with floating-point formats).
@@ -28,16 +33,18 @@ float sampleDepth(const mediump sampler2DArrayShadow map, const uint layer,
 #if SHADOW_SAMPLING_METHOD == SHADOW_SAMPLING_PCF_HARD
 // use hardware assisted PCF
 float ShadowSample_PCF_Hard(const mediump sampler2DArrayShadow map,
+        const highp vec4 scissorNormalized,
         const uint layer, const highp vec4 shadowPosition) {
     highp vec3 position = shadowPosition.xyz * (1.0 / shadowPosition.w);
     // note: shadowPosition.z is in the [1, 0] range (reversed Z)
-    return sampleDepth(map, layer, position.xy, position.z);
+    return sampleDepth(map, scissorNormalized, layer, position.xy, position.z);
 }
 #endif
 
 #if SHADOW_SAMPLING_METHOD == SHADOW_SAMPLING_PCF_LOW
 // use hardware assisted PCF + 3x3 gaussian filter
 float ShadowSample_PCF_Low(const mediump sampler2DArrayShadow map,
+        const highp vec4 scissorNormalized,
         const uint layer, const highp vec4 shadowPosition) {
     highp vec3 position = shadowPosition.xyz * (1.0 / shadowPosition.w);
     // note: shadowPosition.z is in the [1, 0] range (reversed Z)
@@ -65,19 +72,21 @@ float ShadowSample_PCF_Low(const mediump sampler2DArrayShadow map,
     v *= texelSize.y;
 
     float sum = 0.0;
-    sum += uw.x * vw.x * sampleDepth(map, layer, base + vec2(u.x, v.x), depth);
-    sum += uw.y * vw.x * sampleDepth(map, layer, base + vec2(u.y, v.x), depth);
-    sum += uw.x * vw.y * sampleDepth(map, layer, base + vec2(u.x, v.y), depth);
-    sum += uw.y * vw.y * sampleDepth(map, layer, base + vec2(u.y, v.y), depth);
+    sum += uw.x * vw.x * sampleDepth(map, scissorNormalized, layer, base + vec2(u.x, v.x), depth);
+    sum += uw.y * vw.x * sampleDepth(map, scissorNormalized, layer, base + vec2(u.y, v.x), depth);
+    sum += uw.x * vw.y * sampleDepth(map, scissorNormalized, layer, base + vec2(u.x, v.y), depth);
+    sum += uw.y * vw.y * sampleDepth(map, scissorNormalized, layer, base + vec2(u.y, v.y), depth);
     return sum * (1.0 / 16.0);
 }
 #endif
 
 // use manual PCF
 float ShadowSample_PCF(const mediump sampler2DArray map,
+        const highp vec4 scissorNormalized,
         const uint layer, const highp vec4 shadowPosition) {
     highp vec3 position = shadowPosition.xyz * (1.0 / shadowPosition.w);
     // note: shadowPosition.z is in the [1, 0] range (reversed Z)
+    position.xy = clamp(position.xy, scissorNormalized.xy, scissorNormalized.zw);
     highp vec2 size = vec2(textureSize(map, 0));
     highp vec2 st = position.xy * size - 0.5;
     vec4 d;
@@ -192,14 +201,18 @@ float getPenumbraRatio(const bool DIRECTIONAL, const uint index,
 }
 
 void blockerSearchAndFilter(out float occludedCount, out float z_occSum,
-        const mediump sampler2DArray map, const highp vec2 uv, const float z_rec, const uint layer,
+        const mediump sampler2DArray map, const highp vec4 scissorNormalized,
+        const highp vec2 uv, const float z_rec, const uint layer,
         const highp vec2 filterRadii, const mat2 R, const highp vec2 dz_duv,
         const uint tapCount) {
     occludedCount = 0.0;
     z_occSum = 0.0;
     for (uint i = 0u; i < tapCount; i++) {
-        highp vec2 duv = R * (poissonDisk[i] * filterRadii);
-        float z_occ = textureLod(map, vec3(uv + duv, layer), 0.0).r;
+        // the kernel radius depends on the penumbra and isn't bounded, keep the taps in our cell
+        highp vec2 tc = clamp(uv + R * (poissonDisk[i] * filterRadii),
+                scissorNormalized.xy, scissorNormalized.zw);
+        highp vec2 duv = tc - uv;
+        float z_occ = textureLod(map, vec3(tc, layer), 0.0).r;
 
         // note: z_occ and z_rec are not necessarily linear here, comparing them is always okay for
         // the regular PCF, but the "distance" is meaningless unless they are actually linear
@@ -217,21 +230,24 @@ void blockerSearchAndFilter(out float occludedCount, out float z_occSum,
     }
 }
 
-float filterPCSS(const mediump sampler2DArray map, const highp vec2 size,
+float filterPCSS(const mediump sampler2DArray map, const highp vec4 scissorNormalized,
+        const highp vec2 size,
         const highp vec2 uv, const float z_rec, const uint layer,
         const highp vec2 filterRadii, const mat2 R, const highp vec2 dz_duv,
         const uint tapCount) {
 
     float occludedCount = 0.0;
     for (uint i = 0u; i < tapCount; i++) {
-        highp vec2 duv = R * (poissonDisk[i] * filterRadii);
+        highp vec2 tc = clamp(uv + R * (poissonDisk[i] * filterRadii),
+                scissorNormalized.xy, scissorNormalized.zw);
+        highp vec2 duv = tc - uv;
 
         // sample the shadow map with a 2x2 PCF, this helps a lot in low resolution areas
         vec4 d;
-        highp vec2 st = (uv + duv) * size - 0.5;
+        highp vec2 st = tc * size - 0.5;
         highp vec2 grad = fract(st);
 #if defined(FILAMENT_HAS_FEATURE_TEXTURE_GATHER)
-        d = textureGather(map, vec3(uv + duv, layer), 0); // 01, 11, 10, 00
+        d = textureGather(map, vec3(tc, layer), 0); // 01, 11, 10, 00
 #else
         d[0] = texelFetchOffset(map, ivec3(st, layer), 0, ivec2(0, 1)).r;
         d[1] = texelFetchOffset(map, ivec3(st, layer), 0, ivec2(1, 1)).r;
@@ -253,7 +269,8 @@ float filterPCSS(const mediump sampler2DArray map, const highp vec2 size,
  * see "Shadow of Cold War", A scalable approach to shadowing -- by Kevin Myers
  */
 float ShadowSample_DPCF(const bool DIRECTIONAL,
-        const mediump sampler2DArray map, const uint layer, const uint index,
+        const mediump sampler2DArray map, const highp vec4 scissorNormalized,
+        const uint layer, const uint index,
         const highp vec4 shadowPosition, const highp float zLight) {
     highp vec3 position = shadowPosition.xyz * (1.0 / shadowPosition.w);
     highp vec2 texelSize = vec2(1.0) / vec2(textureSize(map, 0));
@@ -271,7 +288,7 @@ float ShadowSample_DPCF(const bool DIRECTIONAL,
     float z_occSum = 0.0;
 
     blockerSearchAndFilter(occludedCount, z_occSum,
-            map, position.xy, position.z, layer, texelSize * penumbra, R, dz_duv,
+            map, scissorNormalized, position.xy, position.z, layer, texelSize * penumbra, R, dz_duv,
             DPCF_SHADOW_TAP_COUNT);
 
     // early exit if there is no occluders at all, also avoids a divide-by-zero below.
@@ -298,7 +315,8 @@ float ShadowSample_DPCF(const bool DIRECTIONAL,
 }
 
 float ShadowSample_PCSS(const bool DIRECTIONAL,
-        const mediump sampler2DArray map, const uint layer, const uint index,
+        const mediump sampler2DArray map, const highp vec4 scissorNormalized,
+        const uint layer, const uint index,
         const highp vec4 shadowPosition, const highp float zLight) {
     highp vec2 size = vec2(textureSize(map, 0));
     highp vec2 texelSize = vec2(1.0) / size;
@@ -317,7 +335,7 @@ float ShadowSample_PCSS(const bool DIRECTIONAL,
     float z_occSum = 0.0;
 
     blockerSearchAndFilter(occludedCount, z_occSum,
-            map, position.xy, position.z, layer, texelSize * penumbra, R, dz_duv,
+            map, scissorNormalized, position.xy, position.z, layer, texelSize * penumbra, R, dz_duv,
             PCSS_SHADOW_BLOCKER_SEARCH_TAP_COUNT);
 
     // early exit if there is no occluders at all, also avoids a divide-by-zero below.
@@ -327,7 +345,8 @@ float ShadowSample_PCSS(const bool DIRECTIONAL,
 
     float penumbraRatio = getPenumbraRatio(DIRECTIONAL, index, position.z, z_occSum / occludedCount);
 
-    float percentageOccluded = filterPCSS(map, size, position.xy, position.z, layer,
+    float percentageOccluded = filterPCSS(map, scissorNormalized, size,
+            position.xy, position.z, layer,
             texelSize * (penumbra * penumbraRatio),
             R, dz_duv, PCSS_SHADOW_FILTER_TAP_COUNT);
 
@@ -444,12 +463,14 @@ float evaluateShadowVSM(const highp vec2 moments, const highp float depth) {
 }
 
 float ShadowSample_VSM(const mediump sampler2DArray shadowMap,
+        const highp vec4 scissorNormalized,
         const uint layer, const highp vec4 shadowPosition) {
 
     // note: shadowPosition.z is in linear light-space normalized to [0, 1]
     //  see: ShadowMap::computeVsmLightSpaceMatrix() in ShadowMap.cpp
     //  see: computeLightSpacePosition() in common_shadowing.fs
     highp vec3 position = vec3(shadowPosition.xy * (1.0 / shadowPosition.w), shadowPosition.z);
+    position.xy = clamp(position.xy, scissorNormalized.xy, scissorNormalized.zw);
 
     // Read the shadow map with all available filtering
     highp vec4 moments = texture(shadowMap, vec3(position.xy, layer));
@@ -481,6 +502,8 @@ float shadow(const bool DIRECTIONAL,
         const uint layer, const uint index, const uint cascade) {
 
     highp vec4 shadowPosition;
+    // cascades have a layer of their own, which is the same as clamping to the texture's edge
+    highp vec4 scissorNormalized = vec4(0.0, 0.0, 1.0, 1.0);
 
     // This conditional is resolved at compile time
     if (DIRECTIONAL) {
@@ -491,12 +514,13 @@ float shadow(const bool DIRECTIONAL,
 #if defined(VARIANT_HAS_DYNAMIC_LIGHTING)
         highp float zLight = dot(shadowUniforms.shadows[index].lightFromWorldZ, vec4(getWorldPosition(), 1.0));
         shadowPosition = getSpotLightSpacePosition(index, zLight);
+        scissorNormalized = shadowUniforms.shadows[index].scissorNormalized;
 #endif
     }
 #if SHADOW_SAMPLING_METHOD == SHADOW_SAMPLING_PCF_HARD
-    return ShadowSample_PCF_Hard(shadowMap, layer, shadowPosition);
+    return ShadowSample_PCF_Hard(shadowMap, scissorNormalized, layer, shadowPosition);
 #elif SHADOW_SAMPLING_METHOD == SHADOW_SAMPLING_PCF_LOW
-    return ShadowSample_PCF_Low(shadowMap, layer, shadowPosition);
+    return ShadowSample_PCF_Low(shadowMap, scissorNormalized, layer, shadowPosition);
 #endif
 }
 
@@ -507,6 +531,8 @@ float shadow(const bool DIRECTIONAL,
 
     highp vec4 shadowPosition;
     highp float zLight = 0.0;
+    // cascades have a layer of their own, which is the same as clamping to the texture's edge
+    highp vec4 scissorNormalized = vec4(0.0, 0.0, 1.0, 1.0);
 
     // This conditional is resolved at compile time
     if (DIRECTIONAL) {
@@ -517,26 +543,29 @@ float shadow(const bool DIRECTIONAL,
 #if defined(VARIANT_HAS_DYNAMIC_LIGHTING)
         zLight = dot(shadowUniforms.shadows[index].lightFromWorldZ, vec4(getWorldPosition(), 1.0));
         shadowPosition = getSpotLightSpacePosition(index, zLight);
+        scissorNormalized = shadowUniforms.shadows[index].scissorNormalized;
 #endif
     }
 
     if (frameUniforms.shadowSamplingType == SHADOW_SAMPLING_RUNTIME_VSM) {
-        return ShadowSample_VSM(shadowMap, layer, shadowPosition);
+        return ShadowSample_VSM(shadowMap, scissorNormalized, layer, shadowPosition);
     }
 
     if (frameUniforms.shadowSamplingType == SHADOW_SAMPLING_RUNTIME_DPCF) {
-        return ShadowSample_DPCF(DIRECTIONAL, shadowMap, layer, index, shadowPosition, zLight);
+        return ShadowSample_DPCF(DIRECTIONAL, shadowMap, scissorNormalized, layer, index,
+                shadowPosition, zLight);
     }
 
     if (frameUniforms.shadowSamplingType == SHADOW_SAMPLING_RUNTIME_PCSS) {
-        return ShadowSample_PCSS(DIRECTIONAL, shadowMap, layer, index, shadowPosition, zLight);
+        return ShadowSample_PCSS(DIRECTIONAL, shadowMap, scissorNormalized, layer, index,
+                shadowPosition, zLight);
     }
 
     if (frameUniforms.shadowSamplingType == SHADOW_SAMPLING_RUNTIME_PCF) {
         // This is here mostly for debugging at this point.
         // Note: In this codepath, the normal bias is not applied because we're in the VSM variant.
         // (see: get{Cascade|Spot}LightSpacePosition)
-        return ShadowSample_PCF(shadowMap, layer, shadowPosition);
+        return ShadowSample_PCF(shadowMap, scissorNormalized, layer, shadowPosition);
     }
 
     // should not happen
@@ -48,7 +48,8 @@ Filament.shadowOptions = function(overrides) {
         polygonOffsetSlope: 2.0,
         screenSpaceContactShadows: false,
         stepCount: 8,
-        maxShadowDistance: 0.3
+        maxShadowDistance: 0.3,
+        incrementalCascadeUpdates: false
     };
     return Object.assign(options, overrides);
 };
@@ -251,7 +252,7 @@ Filament.loadClassExtensions = function() {
     /// overrides ::argument:: Dictionary with one or more of the following properties: \
     /// mapSize, shadowCascades, constantBias, normalBias, shadowFar, shadowNearHint, \
     /// shadowFarHint, stable, polygonOffsetConstant, polygonOffsetSlope, \
-    // screenSpaceContactShadows, stepCount, maxShadowDistance.
+    // screenSpaceContactShadows, stepCount, maxShadowDistance, incrementalCascadeUpdates.
     Filament.LightManager.prototype.setShadowOptions = function(instance, overrides) {
         this._setShadowOptions(instance, Filament.shadowOptions(overrides));
     };
@@ -10,6 +10,7 @@ Filament.loadGeneratedExtensions = function() {
             enabled: false,
             homogeneousScaling: false,
             quality: Filament.View$QualityLevel.LOW,
+            controller: Filament.View$DynamicResolutionOptions$Controller.PID,
         };
         return Object.assign(options, overrides);
     };
@@ -148,6 +149,7 @@ Filament.loadGeneratedExtensions = function() {
             bias: 0.01,
             maxDistance: 3.0,
             stride: 2.0,
+            resolution: 1.0,
             enabled: false,
         };
         return Object.assign(options, overrides);
@@ -102,6 +102,7 @@ export interface LightManager$ShadowOptions {
     screenSpaceContactShadows?: boolean;
     stepCount?: number;
     maxShadowDistance?: number;
+    incrementalCascadeUpdates?: boolean;
 }
 
 // Clients should use the [PixelBuffer/CompressedPixelBuffer] helper function to contruct PixelBufferDescriptor objects.
@@ -514,6 +515,15 @@ interface Filamesh {
     indexBuffer: IndexBuffer;
 }
 
+export interface Engine$TextureCacheStats {
+    hits: number;
+    misses: number;
+    evictions: number;
+    bytesEvicted: number;
+    cacheSize: number;
+    inUseSize: number;
+}
+
 export class Engine {
     public static create(canvas: HTMLCanvasElement, contextOptions?: object): Engine;
     public execute(): void;
@@ -555,6 +565,9 @@ export class Engine {
     public getRenderableManager(): RenderableManager;
     public getSupportedFormatSuffix(suffix: string): void;
     public getTransformManager(): TransformManager;
+    public setTextureCacheBudget(budget: number): void;
+    public getTextureCacheBudget(): number;
+    public getTextureCacheStats(): Engine$TextureCacheStats;
     public init(assets: string[], onready: () => void): void;
     public loadFilamesh(urlOrBuffer: BufferReference, definstance?: MaterialInstance, matinstances?: object): Filamesh;
 }
@@ -1070,6 +1083,11 @@ export enum View$BlendMode {
     TRANSLUCENT,
 }
 
+export enum View$DynamicResolutionOptions$Controller {
+    PID,
+    PREDICTIVE,
+}
+
 /**
  * Dynamic resolution can be used to either reach a desired target frame rate
  * by lowering the resolution of a View, or to increase the quality when the
@@ -1093,6 +1111,12 @@ export enum View$BlendMode {
  * quality:   upscaling quality.
  *            LOW: 1 bilinear tap, Medium: 4 bilinear taps, High: 9 bilinear taps (tent)
  *
+ * controller: how the scale factor is computed from the frame times.
+ *            PID: the scale factor follows the GPU frame time error relative to the target.
+ *            PREDICTIVE: the scale factor that should hit the target is predicted from the GPU
+ *            frame time. The CPU frame time is taken into account, so that the resolution isn't
+ *            lowered when the CPU alone misses the target.
+ *
  * \note
  * Dynamic resolution is only supported on platforms where the time to render
  * a frame can be measured accurately. Dynamic resolution is currently only
@@ -1133,6 +1157,16 @@ export interface View$DynamicResolutionOptions {
      * The default upscaling quality is set to LOW.
      */
     quality?: View$QualityLevel;
+    /**
+     * Dynamic resolution controller
+     * PID:        follows the GPU frame time error, with a dead band
+     * PREDICTIVE: models the GPU frame time as a function of the resolution and sets the scale
+     *             factor that hits the target, with hysteresis. The CPU frame time is taken
+     *             into account.
+     *
+     * The default controller is PID.
+     */
+    controller?: View$DynamicResolutionOptions$Controller;
 }
 
 export enum View$BloomOptions$BlendMode {
@@ -1477,7 +1511,7 @@ export interface View$AmbientOcclusionOptions {
      */
     bias?: number;
     /**
-     * How each dimension of the AO buffer is scaled. Must be either 0.5 or 1.0.
+     * How each dimension of the AO buffer is scaled. Must be either 0.25, 0.5 or 1.0.
      */
     resolution?: number;
     /**
@@ -1578,6 +1612,10 @@ export interface View$ScreenSpaceReflectionsOptions {
      * stride, in texels, for samples along the ray.
      */
     stride?: number;
+    /**
+     * How each dimension of the reflection buffer is scaled. Must be either 0.5 or 1.0.
+     */
+    resolution?: number;
     enabled?: boolean;
 }
 
@@ -376,7 +376,8 @@ value_object<LightManager::ShadowOptions>("LightManager$ShadowOptions")
     .field("polygonOffsetSlope", &LightManager::ShadowOptions::polygonOffsetSlope)
     .field("screenSpaceContactShadows", &LightManager::ShadowOptions::screenSpaceContactShadows)
     .field("stepCount", &LightManager::ShadowOptions::stepCount)
-    .field("maxShadowDistance", &LightManager::ShadowOptions::maxShadowDistance);
+    .field("maxShadowDistance", &LightManager::ShadowOptions::maxShadowDistance)
+    .field("incrementalCascadeUpdates", &LightManager::ShadowOptions::incrementalCascadeUpdates);
 
 // In JavaScript, a flat contiguous representation is best for matrices (see gl-matrix) so we
 // need to define a small wrapper here.
@@ -406,6 +407,14 @@ value_object<RenderableManager::Bone>("RenderableManager$Bone")
     .field("unitQuaternion", &RenderableManager::Bone::unitQuaternion)
     .field("translation", &RenderableManager::Bone::translation);
 
+value_object<Engine::TextureCacheStats>("Engine$TextureCacheStats")
+    .field("hits", &Engine::TextureCacheStats::hits)
+    .field("misses", &Engine::TextureCacheStats::misses)
+    .field("evictions", &Engine::TextureCacheStats::evictions)
+    .field("bytesEvicted", &Engine::TextureCacheStats::bytesEvicted)
+    .field("cacheSize", &Engine::TextureCacheStats::cacheSize)
+    .field("inUseSize", &Engine::TextureCacheStats::inUseSize);
+
 // VECTOR TYPES
 // ------------
 
@@ -469,6 +478,16 @@ class_<Engine>("Engine")
         return &engine->getEntityManager();
     }), allow_raw_pointers())
 
+    /// setTextureCacheBudget ::method:: Sets the memory budget of the internal texture cache.
+    /// budget ::argument:: maximum size in bytes of the unused textures kept in the cache
+    .function("setTextureCacheBudget", &Engine::setTextureCacheBudget)
+    /// getTextureCacheBudget ::method::
+    /// ::retval:: the memory budget of the internal texture cache in bytes
+    .function("getTextureCacheBudget", &Engine::getTextureCacheBudget)
+    /// getTextureCacheStats ::method::
+    /// ::retval:: statistics of the internal texture cache, see [Engine$TextureCacheStats]
+    .function("getTextureCacheStats", &Engine::getTextureCacheStats)
+
     /// createSwapChain ::method::
     /// ::retval:: an instance of [SwapChain]
     .function("createSwapChain", (SwapChain* (*)(Engine*)) []
@@ -17,6 +17,7 @@ value_object<View::DynamicResolutionOptions>("View$DynamicResolutionOptions")
     .field("enabled", &View::DynamicResolutionOptions::enabled)
     .field("homogeneousScaling", &View::DynamicResolutionOptions::homogeneousScaling)
     .field("quality", &View::DynamicResolutionOptions::quality)
+    .field("controller", &View::DynamicResolutionOptions::controller)
     ;
 
 value_object<View::BloomOptions>("View$BloomOptions")
@@ -125,6 +126,7 @@ value_object<View::ScreenSpaceReflectionsOptions>("View$ScreenSpaceReflectionsOp
     .field("bias", &View::ScreenSpaceReflectionsOptions::bias)
     .field("maxDistance", &View::ScreenSpaceReflectionsOptions::maxDistance)
     .field("stride", &View::ScreenSpaceReflectionsOptions::stride)
+    .field("resolution", &View::ScreenSpaceReflectionsOptions::resolution)
     .field("enabled", &View::ScreenSpaceReflectionsOptions::enabled)
     ;
 
@@ -22,6 +22,11 @@ enum_<View::BlendMode>("View$BlendMode")
     .value("TRANSLUCENT", View::BlendMode::TRANSLUCENT)
     ;
 
+enum_<View::DynamicResolutionOptions::Controller>("View$DynamicResolutionOptions$Controller")
+    .value("PID", View::DynamicResolutionOptions::Controller::PID)
+    .value("PREDICTIVE", View::DynamicResolutionOptions::Controller::PREDICTIVE)
+    ;
+
 enum_<View::BloomOptions::BlendMode>("View$BloomOptions$BlendMode")
     .value("ADD", View::BloomOptions::BlendMode::ADD)
     .value("INTERPOLATE", View::BloomOptions::BlendMode::INTERPOLATE)